@@ -44,6 +44,7 @@
 #include "kharma_driver.hpp"
 #include "grmhd.hpp"
 #include "kharma.hpp"
+#include "reductions.hpp"
 #include "types.hpp"
 
 #if DISABLE_CLEANUP
@@ -72,6 +73,13 @@ std::shared_ptr<KHARMAPackage> B_Cleanup::Initialize(ParameterInput *pin, std::s
     // If face centered fields...
     const bool use_b_ct = packages->AllPackages().count("B_CT");
 
+    // When to clean during the run: every "cleanup_interval" steps, or whenever the maximum
+    // (or RMS) divB measured every "cleanup_interval" steps exceeds "trigger_divb" ("trigger_divb_rms")
+    std::vector<std::string> allowed_triggers = {"interval", "divb"};
+    const std::string trigger = pin->GetOrAddString("b_cleanup", "trigger", "interval", allowed_triggers);
+    const bool trigger_on_divb = (trigger == "divb");
+    params.Add("trigger_on_divb", trigger_on_divb);
+
     // Solver options
     // Allow setting tolerance relative to starting value
     // Parthenon's BiCGStab solver stops on abs || rel, so this disables rel
@@ -83,9 +91,10 @@ std::shared_ptr<KHARMAPackage> B_Cleanup::Initialize(ParameterInput *pin, std::s
     params.Add("max_iterations", max_iterations);
     int check_interval = pin->GetOrAddInteger("b_cleanup", "check_interval", 20);
     params.Add("check_interval", check_interval);
-    bool fail_without_convergence = pin->GetOrAddBoolean("b_cleanup", "fail_without_convergence", true);
+    // Triggered cleanups are given a limited budget, so default to warning rather than failing
+    bool fail_without_convergence = pin->GetOrAddBoolean("b_cleanup", "fail_without_convergence", !trigger_on_divb);
     params.Add("fail_without_convergence", fail_without_convergence);
-    bool warn_without_convergence = pin->GetOrAddBoolean("b_cleanup", "warn_without_convergence", false);
+    bool warn_without_convergence = pin->GetOrAddBoolean("b_cleanup", "warn_without_convergence", trigger_on_divb);
     params.Add("warn_without_convergence", warn_without_convergence);
     bool always_solve = pin->GetOrAddBoolean("b_cleanup", "always_solve", false);
     params.Add("always_solve", always_solve);
@@ -159,9 +168,29 @@ std::shared_ptr<KHARMAPackage> B_Cleanup::Initialize(ParameterInput *pin, std::s
     params.Add("manage_field", manage_field);
     // Set an interval to clean during the run *can be run in addition to a normal solver*!
     // You might want to do this if, e.g., you care about divergence on faces with outflow/constant conditions
-    int cleanup_interval = pin->GetOrAddInteger("b_cleanup", "cleanup_interval", manage_field ? 10 : -1);
+    int cleanup_interval = pin->GetOrAddInteger("b_cleanup", "cleanup_interval", (manage_field || trigger_on_divb) ? 10 : -1);
     params.Add("cleanup_interval", cleanup_interval);
 
+    if (trigger_on_divb) {
+        // Clean when max divB exceeds this
+        Real trigger_divb = pin->GetOrAddReal("b_cleanup", "trigger_divb", 100 * abs_tolerance);
+        params.Add("trigger_divb", trigger_divb);
+        // ...or when the RMS divB exceeds this, if positive
+        Real trigger_divb_rms = pin->GetOrAddReal("b_cleanup", "trigger_divb_rms", -1.);
+        params.Add("trigger_divb_rms", trigger_divb_rms);
+        // Triggered solves stop once the residual drops by this factor (or reaches abs_tolerance),
+        // and get iterations_per_decade iterations for each factor of 10 they need to remove
+        Real target_reduction = pin->GetOrAddReal("b_cleanup", "target_reduction", 1e-3);
+        params.Add("target_reduction", target_reduction);
+        int iterations_per_decade = pin->GetOrAddInteger("b_cleanup", "iterations_per_decade", 200);
+        params.Add("iterations_per_decade", iterations_per_decade);
+        // Whether a measurement is in flight, to be checked before the next step.
+        // Measurements are started by the field transport's PostStepDiagnostics, see StartDivBMeasurement
+        params.Add("divb_measure_pending", false, true);
+        // The last step's measurement is never checked, so finish it before exiting
+        pkg->PostExecute = B_Cleanup::FinishDivBMeasurement;
+    }
+
     if (manage_field) {
         // Copy in the field initialization from B_CT and/or B_FluxCT here to declare the right stuff
         throw std::runtime_error("B field cleanup/projection is set as B field transport! This is not implemented!");
@@ -173,9 +202,56 @@ std::shared_ptr<KHARMAPackage> B_Cleanup::Initialize(ParameterInput *pin, std::s
 bool B_Cleanup::CleanupThisStep(Mesh* pmesh, int nstep)
 {
     auto pkg = pmesh->packages.Get("B_Cleanup");
+    if (pkg->Param<bool>("trigger_on_divb")) {
+        // Finish the measurement started after the last step, if any
+        if (!pkg->Param<bool>("divb_measure_pending")) return false;
+        pkg->UpdateParam<bool>("divb_measure_pending", false);
+        auto md = pmesh->mesh_data.Get().get();
+        const Real divb_max = Reductions::CheckOnAll<Real>(md, 6);
+        const std::vector<Real> divb_sums = Reductions::CheckOnAll<std::vector<Real>>(md, 0);
+        const Real divb_rms = (divb_sums[1] > 0) ? m::sqrt(divb_sums[0] / divb_sums[1]) : 0.;
+
+        const Real trigger_divb_rms = pkg->Param<Real>("trigger_divb_rms");
+        const bool clean = (divb_max > pkg->Param<Real>("trigger_divb")) ||
+                           (trigger_divb_rms > 0. && divb_rms > trigger_divb_rms);
+        if (MPIRank0() && pmesh->packages.Get("Globals")->Param<int>("verbose") > 0) {
+            std::cout << "Measured divB max " << divb_max << ", RMS " << divb_rms
+                      << ((clean) ? ". Triggering B field cleanup." : ". Below trigger, skipping B field cleanup.")
+                      << std::endl;
+        }
+        return clean;
+    }
     return (pkg->Param<int>("cleanup_interval") > 0) && (nstep % pkg->Param<int>("cleanup_interval") == 0);
 }
 
+bool B_Cleanup::MeasureThisStep(Mesh* pmesh, int ncycle)
+{
+    if (!pmesh->packages.AllPackages().count("B_Cleanup")) return false;
+    auto pkg = pmesh->packages.Get("B_Cleanup");
+    const int cleanup_interval = pkg->Param<int>("cleanup_interval");
+    return pkg->Param<bool>("trigger_on_divb") && cleanup_interval > 0 && ncycle % cleanup_interval == 0;
+}
+
+void B_Cleanup::StartDivBMeasurement(MeshData<Real> *md, const std::vector<Real>& divb_stats)
+{
+    // The stats are measured exactly as the cleanup will measure divB, but we only start the reductions here.
+    // They're finished when deciding whether to clean, so any MPI wait overlaps with outputs, etc.
+    Reductions::StartToAll<Real>(md, 6, divb_stats[0], MPI_MAX);
+    Reductions::StartToAll<std::vector<Real>>(md, 0, {divb_stats[1], divb_stats[2]}, MPI_SUM);
+    md->GetMeshPointer()->packages.Get("B_Cleanup")->UpdateParam<bool>("divb_measure_pending", true);
+}
+
+void B_Cleanup::FinishDivBMeasurement(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
+{
+    auto pkg = pmesh->packages.Get("B_Cleanup");
+    if (!pkg->Param<bool>("divb_measure_pending")) return;
+    pkg->UpdateParam<bool>("divb_measure_pending", false);
+    // Complete (and discard) the reductions, so no MPI_Iallreduce is left open at MPI_Finalize
+    auto md = pmesh->mesh_data.Get().get();
+    Reductions::CheckOnAll<Real>(md, 6);
+    Reductions::CheckOnAll<std::vector<Real>>(md, 0);
+}
+
 // TODO(BSP) Make this add to a TaskCollection rather than operating synchronously
 TaskStatus B_Cleanup::CleanupDivergence(std::shared_ptr<MeshData<Real>>& md)
 {
@@ -218,6 +294,19 @@ TaskStatus B_Cleanup::CleanupDivergence(std::shared_ptr<MeshData<Real>>& md)
             std::cout << "Starting magnetic field divergence: " << divb_start << std::endl;
     }
 
+    // Solves triggered by a measured violation only need to remove it: ask for a reduction by
+    // target_reduction, with an iteration budget proportional to the decades to be removed
+    if (pkg->Param<bool>("trigger_on_divb") && pmesh->packages.Get("Globals")->Param<bool>("in_loop")) {
+        const Real divb_target = m::max(pkg->Param<Real>("target_reduction") * divb_start, abs_tolerance);
+        const Real decades = m::max(std::log10(divb_start / divb_target), 1.);
+        max_iters = m::min(max_iters, static_cast<int>(std::ceil(pkg->Param<int>("iterations_per_decade") * decades)));
+        solver.SetTolerances(pkg->Param<Real>("target_reduction"), abs_tolerance);
+        solver.SetMaxIterations(max_iters);
+        if (MPIRank0() && verbose > 0) {
+            std::cout << "Cleaning divB toward " << divb_target << " in at most " << max_iters << " iterations" << std::endl;
+        }
+    }
+
     // Add a solver container as a shallow copy on the default MeshData
     // msolve is just a sub-set of vars we need from md, making MPI syncs etc faster
     std::vector<std::string> names = KHARMA::GetVariableNames(&pmesh->packages, {Metadata::GetUserFlag("B_Cleanup"), Metadata::GetUserFlag("StartupOnly")});
@@ -66,6 +66,24 @@ TaskStatus CleanupDivergence(std::shared_ptr<MeshData<Real>>& md);
  */
 bool CleanupThisStep(Mesh* pmesh, int nstep);
 
+/**
+ * Whether divB should be measured after step ncycle, for b_cleanup/trigger=divb.
+ * Safe to call whether or not this package is loaded
+ */
+bool MeasureThisStep(Mesh* pmesh, int ncycle);
+
+/**
+ * Start reducing divB statistics measured by the field transport's post-step diagnostics:
+ * {max, sum of squares, number of zones} over this rank's MeshData.
+ * The result is collected (and compared to b_cleanup/trigger_divb, trigger_divb_rms) by CleanupThisStep
+ */
+void StartDivBMeasurement(MeshData<Real> *md, const std::vector<Real>& divb_stats);
+
+/**
+ * Finish any measurement still in flight at the end of the run, discarding the result
+ */
+void FinishDivBMeasurement(Mesh *pmesh, ParameterInput *pin, const SimTime &tm);
+
 /**
  * Calculate the laplacian using divergence at corners.
  * Extra MeshData arg is just to satisfy Parthenon solver calling convention
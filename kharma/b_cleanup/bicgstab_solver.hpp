@@ -73,6 +73,13 @@ class BiCGStabSolver : BiCGStabCounter {
     return CreateTaskList(begin, i, tr, solver, md, mout);
   }
 
+  // Adjust the stopping criteria, e.g. of a copy used for one solve
+  void SetTolerances(const Real rel_error_tol_in, const Real abs_error_tol_in) {
+    rel_error_tol = rel_error_tol_in;
+    abs_error_tol = abs_error_tol_in;
+  }
+  void SetMaxIterations(const int max_iters_in) { max_iters = max_iters_in; }
+
   using FMatVec = std::function<TaskStatus(MeshData<Real> *, const std::string &,
                                            MeshData<Real> *, const std::string &)>;
   using FScale = std::function<TaskStatus(MeshData<Real> *, const std::string &)>;
@@ -33,11 +33,16 @@
  */
 #include "b_ct.hpp"
 
+#include "b_cleanup.hpp"
 #include "decs.hpp"
 #include "domain.hpp"
 #include "grmhd.hpp"
 #include "grmhd_functions.hpp"
 #include "kharma.hpp"
+#include "polar_filter.hpp"
+#include "roofline.hpp"
+#include "tiling.hpp"
+#include "transients.hpp"
 
 #include <parthenon/parthenon.hpp>
 #include <prolong_restrict/pr_ops.hpp>
@@ -108,7 +113,7 @@ std::shared_ptr<KHARMAPackage> B_CT::Initialize(ParameterInput *pin, std::shared
     if (ct_scheme != "bs99") {
         std::vector<MetadataFlag> flags_emf_c = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy};
         m = Metadata(flags_emf_c, s_vector);
-        pkg->AddField("B_CT.cemf", m);
+        Transients::AddField(pkg, pin, "B_CT.cemf", m, Transients::Phase::flux, Transients::Phase::flux);
     }
 
     // CALLBACKS
@@ -261,10 +266,12 @@ TaskStatus B_CT::DangerousPtoU(MeshData<Real> *md, IndexDomain domain, bool coar
     return TaskStatus::complete;
 }
 
-TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
+namespace {
+
+template<int NDIM>
+TaskStatus CalculateEMFDim(MeshData<Real> *md)
 {
     auto pmesh = md->GetMeshPointer();
-    const int ndim = pmesh->ndim;
 
     // EMF temporary
     auto& emf_pack = md->PackVariables(std::vector<std::string>{"B_CT.emf"});
@@ -279,14 +286,18 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
     // Calculate circulation by averaging fluxes
     // This is the base of most other schemes, which make corrections
     // It is the entirety of B&S '99
+    // Rough per-zone work for kernel profiling: edge EMFs each read 4 fluxes (mostly cached, count 2)
+    const double nzones = static_cast<double>(block.e - block.s + 1) * (b1.ke - b1.ks + 1)
+                                                * (b1.je - b1.js + 1) * (b1.ie - b1.is + 1);
+    Roofline::AddWork("B_CT_emf_BS", nzones, 8. * 3 * (2 + 1), 3 * 4.);
     auto& B_U = md->PackVariablesAndFluxes(std::vector<std::string>{"cons.B"});
-    pmb0->par_for("B_CT_emf_BS", block.s, block.e, b1.ks, b1.ke, b1.js, b1.je, b1.is, b1.ie,
+    Tiling::par_for("B_CT_emf_BS", pmb0->exec_space, block.s, block.e, b1.ks, b1.ke, b1.js, b1.je, b1.is, b1.ie,
         KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
             // The basic EMF per length along edges is the B field flux
             // We use this form rather than multiply by edge length here,
             // since the default restriction op averages values
             const auto& G = B_U.GetCoords(bl);
-            if (ndim > 2) {
+            if constexpr (NDIM > 2) {
                 emf_pack(bl, E1, 0, k, j, i) =
                     0.25*(-B_U(bl).flux(X2DIR, V3, k - 1, j, i) - B_U(bl).flux(X2DIR, V3, k, j, i)
                          + B_U(bl).flux(X3DIR, V2, k, j - 1, i) + B_U(bl).flux(X3DIR, V2, k, j, i));
@@ -296,7 +307,7 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
                 emf_pack(bl, E3, 0, k, j, i) =
                     0.25*(-B_U(bl).flux(X1DIR, V2, k, j - 1, i) - B_U(bl).flux(X1DIR, V2, k, j, i)
                         + B_U(bl).flux(X2DIR, V1, k, j, i - 1)  + B_U(bl).flux(X2DIR, V1, k, j, i));
-            } else if (ndim > 1) {
+            } else if constexpr (NDIM > 1) {
                 emf_pack(bl, E1, 0, k, j, i) = -B_U(bl).flux(X2DIR, V3, k, j, i);
                 emf_pack(bl, E2, 0, k, j, i) =  B_U(bl).flux(X1DIR, V3, k, j, i);
                 emf_pack(bl, E3, 0, k, j, i) =
@@ -310,7 +321,7 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
         }
     );
     // All corrections require/are only necessary for 2D+
-    if (ndim < 2) return TaskStatus::complete;
+    if constexpr (NDIM < 2) return TaskStatus::complete;
 
     std::string scheme = pmesh->packages.Get("B_CT")->Param<std::string>("ct_scheme");
     if (scheme != "bs99") {
@@ -319,10 +330,13 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
         PackIndexMap prims_map;
         auto& P = md->PackVariables(std::vector<std::string>{"prims.uvec", "prims.B"}, prims_map);
         const VarMap m_p(prims_map, false);
-        auto& emfc = md->PackVariables(std::vector<std::string>{"B_CT.cemf"});
+        auto& emfc = md->PackVariables(std::vector<std::string>{Transients::Name("B_CT.cemf")});
         // Need this over whole domain to have halo around EMF caclulation
         const IndexRange3 be = KDomain::GetRange(md, IndexDomain::entire);
-        pmb0->par_for("B_CT_emfc", block.s, block.e, be.ks, be.ke, be.js, be.je, be.is, be.ie,
+        // Read prims & geometry, write centered EMF. FLOPs mostly in calc_4vecs
+        Roofline::AddWork("B_CT_emfc", static_cast<double>(block.e - block.s + 1) * (be.ke - be.ks + 1)
+                                        * (be.je - be.js + 1) * (be.ie - be.is + 1), 8. * (6 + 21 + 3), 120.);
+        Tiling::par_for("B_CT_emfc", pmb0->exec_space, block.s, block.e, be.ks, be.ke, be.js, be.je, be.is, be.ie,
             KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
                 const auto& G = P.GetCoords(bl);
                 Real gdet = G.gdet(Loci::center, j, i);
@@ -339,12 +353,13 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
         );
 
         if (scheme == "gs05_0") {
-            pmb0->par_for("B_CT_emf_GS05_0", block.s, block.e, b1.ks, b1.ke, b1.js, b1.je, b1.is, b1.ie,
+            Roofline::AddWork("B_CT_emf_GS05_0", nzones, 8. * 3 * (1 + 2 + 1), 3 * 6.);
+            Tiling::par_for("B_CT_emf_GS05_0", pmb0->exec_space, block.s, block.e, b1.ks, b1.ke, b1.js, b1.je, b1.is, b1.ie,
                 KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
                     const auto& G = emfc.GetCoords(bl);
                     // Just subtract centered emf from twice the face version
                     // More stable for planar flows even without anything fancy
-                    if (ndim > 2) {
+                    if constexpr (NDIM > 2) {
                         emf_pack(bl, E1, 0, k, j, i) = 2 * emf_pack(bl, E1, 0, k, j, i)
                             - 0.25*(emfc(bl, V1, k, j, i)      + emfc(bl, V1, k, j - 1, i)
                                   + emfc(bl, V1, k, j - 1, i)  + emfc(bl, V1, k - 1, j - 1, i));
@@ -359,11 +374,13 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
             );
         } else if (scheme == "gs05_c" || scheme == "sg07") {
             auto& rho = md->PackVariablesAndFluxes(std::vector<std::string>{"cons.rho"});
-            pmb0->par_for("B_CT_emf_GS05_c", block.s, block.e, b1.ks, b1.ke, b1.js, b1.je, b1.is, b1.ie,
+            // Upwinded corner integration: per edge, reads of B & mass fluxes and centered EMFs
+            Roofline::AddWork("B_CT_emf_GS05_c", nzones, 8. * 3 * (4 + 2 + 2 + 1), 3 * 40.);
+            Tiling::par_for("B_CT_emf_GS05_c", pmb0->exec_space, block.s, block.e, b1.ks, b1.ke, b1.js, b1.je, b1.is, b1.ie,
                 KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
                     // Following adapted closely from AthenaK, including clever use of the mass flux for the
                     // sign of the contact mode.
-                    if (ndim > 2) {
+                    if constexpr (NDIM > 2) {
                         // Integrate EMF to the corner using GS07 i.e. GS05 E^c upwinding
                         Real e1_l3 = (rho(bl).flux(X2DIR, 0, k-1, j, i) >= 0.0) ?
                                     B_U(bl).flux(X3DIR, V2, k, j-1, i) - emfc(bl, V1, k-1, j-1, i) :
@@ -412,13 +429,33 @@ TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
         }
     }
 
+    // Optionally damp unresolved azimuthal modes of the EMF near the poles, see polar_filter.hpp
+    if constexpr (NDIM > 2) PolarFilter::FilterEMF(md, "B_CT.emf", true);
+
     return TaskStatus::complete;
 }
 
-TaskStatus B_CT::AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain domain)
+} // namespace
+
+TaskStatus B_CT::CalculateEMF(MeshData<Real> *md)
+{
+    // Compile out the X3 (and X2) work of lower-dimensional runs
+    switch (md->GetMeshPointer()->ndim) {
+    case 1:
+        return CalculateEMFDim<1>(md);
+    case 2:
+        return CalculateEMFDim<2>(md);
+    default:
+        return CalculateEMFDim<3>(md);
+    }
+}
+
+namespace {
+
+template<int NDIM>
+TaskStatus AddSourceDim(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain domain)
 {
     auto pmesh = md->GetMeshPointer();
-    const int ndim = pmesh->ndim;
 
     // EMF temporary
     auto& emf_pack = md->PackVariables(std::vector<std::string>{"B_CT.emf"});
@@ -432,31 +469,31 @@ TaskStatus B_CT::AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomai
     auto& dB_Uf_dt = mdudt->PackVariables(std::vector<std::string>{"cons.fB"});
     // Circulation -> change in flux at face
     const IndexRange3 bf1 = KDomain::GetRange(md, domain, F1);
-    pmb0->par_for("B_CT_Circ_1", block.s, block.e, bf1.ks, bf1.ke, bf1.js, bf1.je, bf1.is, bf1.ie,
+    Tiling::par_for("B_CT_Circ_1", pmb0->exec_space, block.s, block.e, bf1.ks, bf1.ke, bf1.js, bf1.je, bf1.is, bf1.ie,
         KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
             const auto& G = dB_Uf_dt.GetCoords(bl);
             dB_Uf_dt(bl, F1, 0, k, j, i) = (-G.Volume<E3>(k, j + 1, i) * emf_pack(bl, E3, 0, k, j + 1, i)
                                            + G.Volume<E3>(k, j, i)     * emf_pack(bl, E3, 0, k, j, i));
-            if (ndim > 2)
+            if constexpr (NDIM > 2)
                 dB_Uf_dt(bl, F1, 0, k, j, i) += (G.Volume<E2>(k + 1, j, i) * emf_pack(bl, E2, 0, k + 1, j, i)
                                                 - G.Volume<E2>(k, j, i)    * emf_pack(bl, E2, 0, k, j, i));
             dB_Uf_dt(bl, F1, 0, k, j, i) /= G.Volume<F1>(k, j, i);
         }
     );
     const IndexRange3 bf2 = KDomain::GetRange(md, domain, F2);
-    pmb0->par_for("B_CT_Circ_2", block.s, block.e, bf2.ks, bf2.ke, bf2.js, bf2.je, bf2.is, bf2.ie,
+    Tiling::par_for("B_CT_Circ_2", pmb0->exec_space, block.s, block.e, bf2.ks, bf2.ke, bf2.js, bf2.je, bf2.is, bf2.ie,
         KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
             const auto& G = dB_Uf_dt.GetCoords(bl);
             dB_Uf_dt(bl, F2, 0, k, j, i) = (G.Volume<E3>(k, j, i + 1) * emf_pack(bl, E3, 0, k, j, i + 1)
                                            - G.Volume<E3>(k, j, i)    * emf_pack(bl, E3, 0, k, j, i));
-            if (ndim > 2)
+            if constexpr (NDIM > 2)
                 dB_Uf_dt(bl, F2, 0, k, j, i) += (-G.Volume<E1>(k + 1, j, i) * emf_pack(bl, E1, 0, k + 1, j, i)
                                                 + G.Volume<E1>(k, j, i)     * emf_pack(bl, E1, 0, k, j, i));
             dB_Uf_dt(bl, F2, 0, k, j, i) /= G.Volume<F2>(k, j, i);
         }
     );
     const IndexRange3 bf3 = KDomain::GetRange(md, domain, F3);
-    pmb0->par_for("B_CT_Circ_3", block.s, block.e, bf3.ks, bf3.ke, bf3.js, bf3.je, bf3.is, bf3.ie,
+    Tiling::par_for("B_CT_Circ_3", pmb0->exec_space, block.s, block.e, bf3.ks, bf3.ke, bf3.js, bf3.je, bf3.is, bf3.ie,
         KOKKOS_LAMBDA (const int &bl, const int &k, const int &j, const int &i) {
             const auto& G = dB_Uf_dt.GetCoords(bl);
             dB_Uf_dt(bl, F3, 0, k, j, i) = (- G.Volume<E2>(k, j, i + 1) * emf_pack(bl, E2, 0, k, j, i + 1)
@@ -469,7 +506,22 @@ TaskStatus B_CT::AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomai
     return TaskStatus::complete;
 }
 
-double B_CT::MaxDivB(MeshData<Real> *md)
+} // namespace
+
+TaskStatus B_CT::AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain domain)
+{
+    // Compile out the X3 (and X2) work of lower-dimensional runs
+    switch (md->GetMeshPointer()->ndim) {
+    case 1:
+        return AddSourceDim<1>(md, mdudt, domain);
+    case 2:
+        return AddSourceDim<2>(md, mdudt, domain);
+    default:
+        return AddSourceDim<3>(md, mdudt, domain);
+    }
+}
+
+std::vector<Real> B_CT::DivBStats(MeshData<Real> *md)
 {
     auto pmesh = md->GetMeshPointer();
     const int ndim = pmesh->ndim;
@@ -484,17 +536,24 @@ double B_CT::MaxDivB(MeshData<Real> *md)
 
     auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
 
-    double max_divb;
-    Kokkos::Max<double> max_reducer(max_divb);
-    pmb0->par_reduce("divB_max", block.s, block.e, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i, double &local_result) {
+    // Max, sum of squares, and number of zones, all in one sweep
+    Reductions::array_type<Real, 3> divb_reducer;
+    pmb0->par_reduce("divB_stats", block.s, block.e, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i,
+                       Reductions::array_type<Real, 3> &local_result) {
             const auto& G = B_U.GetCoords(b);
-            double local_divb = m::abs(face_div(G, B_U(b), ndim, k, j, i));
-            if (local_divb > local_result) local_result = local_divb;
+            const Real local_divb = m::abs(face_div(G, B_U(b), ndim, k, j, i));
+            if (local_divb > local_result.my_array[0]) local_result.my_array[0] = local_divb;
+            local_result.my_array[1] += local_divb * local_divb;
+            local_result.my_array[2] += 1.;
         }
-    , max_reducer);
+    , Reductions::ArrayMaxSum<Real, HostExecSpace, 3>(divb_reducer));
 
-    return max_divb;
+    return {divb_reducer.my_array[0], divb_reducer.my_array[1], divb_reducer.my_array[2]};
+}
+double B_CT::MaxDivB(MeshData<Real> *md)
+{
+    return DivBStats(md)[0];
 }
 double B_CT::BlockMaxDivB(MeshBlockData<Real> *rc)
 {
@@ -530,7 +589,7 @@ double B_CT::GlobalMaxDivB(MeshData<Real> *md, bool all_reduce)
     }
 }
 
-TaskStatus B_CT::PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb)
+TaskStatus B_CT::PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb, double divb_local)
 {
     auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
 
@@ -538,8 +597,10 @@ TaskStatus B_CT::PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb)
     // unless we're being verbose. It's not costly to calculate though
     const bool print = pmb0->packages.Get("Globals")->Param<int>("verbose") >= 1;
     if (print || kill_on_large_divb) {
-        // Calculate the maximum from/on all nodes
-        const double divb_max = B_CT::GlobalMaxDivB(md);
+        // Calculate the maximum from/on all nodes, unless we've already measured it here
+        if (divb_local < 0.) divb_local = B_CT::MaxDivB(md);
+        Reductions::Start<Real>(md, 2, divb_local, MPI_MAX);
+        const double divb_max = Reductions::Check<Real>(md, 2);
         // Print on rank zero
         if (MPIRank0() && print) {
             printf("Max DivB: %g\n", divb_max); // someday I'll learn stream options
@@ -553,6 +614,22 @@ TaskStatus B_CT::PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb)
     return TaskStatus::complete;
 }
 
+TaskStatus B_CT::PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
+{
+    auto pmesh = md->GetMeshPointer();
+    const bool kill_on_large_divb = pmesh->packages.Get("B_CT")->Param<bool>("kill_on_large_divb");
+    const bool print = pmesh->packages.Get("Globals")->Param<int>("verbose") >= 1;
+    const bool measure_for_cleanup = B_Cleanup::MeasureThisStep(pmesh, tm.ncycle);
+    if (!(print || kill_on_large_divb || measure_for_cleanup)) return TaskStatus::complete;
+
+    // A single sweep serves both the max printed here and a triggered cleanup's max & RMS
+    const std::vector<Real> divb_stats = DivBStats(md);
+    if (measure_for_cleanup) B_Cleanup::StartDivBMeasurement(md, divb_stats);
+    // The measurement finishes asynchronously, don't block on a global max nobody will read
+    if (!(print || kill_on_large_divb)) return TaskStatus::complete;
+    return PrintGlobalMaxDivB(md, kill_on_large_divb, divb_stats[0]);
+}
+
 // TODO unify these by adding FillOutputMesh option
 
 void B_CT::CalcDivB(MeshData<Real> *md, std::string divb_field_name)
@@ -81,6 +81,12 @@ TaskStatus CalculateEMF(MeshData<Real> *md);
  */
 TaskStatus AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain domain);
 
+/**
+ * Calculate the maximum, sum of squares, and number of zones of the divergence of magnetic field
+ * over this rank's MeshData, in a single pass.  Used for the triggered cleanups in B_Cleanup
+ */
+std::vector<Real> DivBStats(MeshData<Real> *md);
+
 /**
  * Calculate maximum corner-centered divergence of magnetic field,
  * to check it is being preserved ~=0
@@ -97,18 +103,15 @@ double GlobalMaxDivB(MeshData<Real> *md, bool all_reduce=false);
 
 /**
  * Diagnostics printed/computed after each step
- * Currently just max divB
+ * Currently just max divB.  Pass divb_local if this rank's max has already been measured
  */
-TaskStatus PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb=false);
+TaskStatus PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb=false, double divb_local=-1.);
 
 /**
- * Diagnostics function should print divB, and optionally stop execution if it's large
+ * Diagnostics function should print divB, and optionally stop execution if it's large.
+ * Also starts the divB measurement for B_Cleanup's triggered cleanups, when due
  */
-inline TaskStatus PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
-{
-    auto& params = md->GetMeshPointer()->block_list[0]->packages.Get("B_CT")->AllParams();
-    return PrintGlobalMaxDivB(md, params.Get<bool>("kill_on_large_divb"));
-}
+TaskStatus PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md);
 
 /**
  * Fill fields which are calculated only for output to file, i.e., divB
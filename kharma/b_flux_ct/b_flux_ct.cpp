@@ -36,10 +36,14 @@
 
 #include "b_flux_ct.hpp"
 
+#include "b_cleanup.hpp"
 #include "decs.hpp"
 #include "domain.hpp"
 #include "grmhd.hpp"
 #include "kharma.hpp"
+#include "polar_filter.hpp"
+#include "tiling.hpp"
+#include "transients.hpp"
 
 using namespace parthenon;
 
@@ -121,7 +125,7 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
     // Technically these are edge-centered but we only need the interior + 1-zone halo anyway, so we store as a vector
     std::vector<MetadataFlag> flags_emf = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy};
     m = Metadata(flags_emf, s_vector);
-    pkg->AddField("emf", m);
+    Transients::AddField(pkg, pin, "emf", m, Transients::Phase::flux, Transients::Phase::flux);
     if (packages->Get("Globals")->Param<std::string>("problem") == "resize_restart_kharma") {
         m = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::FillGhost, Metadata::Vector});
         pkg->AddField("B_Save", m);
@@ -304,18 +308,17 @@ void FixFlux(MeshData<Real> *md)
 
 // INTERNAL
 
-void FluxCT(MeshData<Real> *md)
+/**
+ * FluxCT for a given number of dimensions, so that 2D runs compile out all X3 work
+ */
+template<int NDIM>
+void FluxCTDim(MeshData<Real> *md)
 {
-    // Pointers
-    auto pmesh = md->GetMeshPointer();
     auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
-    // Exit on trivial operations
-    const int ndim = pmesh->ndim;
-    if (ndim < 2) return;
 
     // Pack variables
     const auto& B_F = md->PackVariablesAndFluxes(std::vector<std::string>{"cons.B"});
-    const auto& emf_pack = md->PackVariables(std::vector<std::string>{"emf"});
+    const auto& emf_pack = md->PackVariables(std::vector<std::string>{Transients::Name("emf")});
 
     // Get sizes
     const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
@@ -325,12 +328,12 @@ void FluxCT(MeshData<Real> *md)
     // One zone halo on the *right only*, except for k in 2D
     const IndexRange il = IndexRange{ib.s, ib.e + 1};
     const IndexRange jl = IndexRange{jb.s, jb.e + 1};
-    const IndexRange kl = (ndim > 2) ? IndexRange{kb.s, kb.e + 1} : kb;
+    const IndexRange kl = (NDIM > 2) ? IndexRange{kb.s, kb.e + 1} : kb;
 
     // Calculate emf around each face
-    pmb0->par_for("flux_ct_emf", block.s, block.e, kl.s, kl.e, jl.s, jl.e, il.s, il.e,
+    Tiling::par_for("flux_ct_emf", pmb0->exec_space, block.s, block.e, kl.s, kl.e, jl.s, jl.e, il.s, il.e,
         KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
-            if (ndim > 2) {
+            if constexpr (NDIM > 2) {
                 emf_pack(b, V1, k, j, i) =  0.25 * (B_F(b).flux(X2DIR, V3, k, j, i) + B_F(b).flux(X2DIR, V3, k-1, j, i) -
                                             B_F(b).flux(X3DIR, V2, k, j, i) - B_F(b).flux(X3DIR, V2, k, j-1, i));
                 emf_pack(b, V2, k, j, i) = 0.25 * (B_F(b).flux(X3DIR, V1, k, j, i) + B_F(b).flux(X3DIR, V1, k, j, i-1) -
@@ -341,25 +344,28 @@ void FluxCT(MeshData<Real> *md)
         }
     );
 
+    // Optionally damp unresolved azimuthal modes of the EMF near the poles, see polar_filter.hpp
+    if constexpr (NDIM > 2) PolarFilter::FilterEMF(md, Transients::Name("emf"), false);
+
     // Rewrite EMFs as fluxes, after Toth (2000)
     // Note that zeroing FX(BX) is *necessary* -- this flux gets filled by GetFlux
     // Note these each have different domains, eg il vs ib.  The former extends one index farther if appropriate
-    pmb0->par_for("flux_ct_1", block.s, block.e, kb.s, kb.e, jb.s, jb.e, il.s, il.e,
+    Tiling::par_for("flux_ct_1", pmb0->exec_space, block.s, block.e, kb.s, kb.e, jb.s, jb.e, il.s, il.e,
         KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
             B_F(b).flux(X1DIR, V1, k, j, i) =  0.0;
             B_F(b).flux(X1DIR, V2, k, j, i) =  0.5 * (emf_pack(b, V3, k, j, i) + emf_pack(b, V3, k, j+1, i));
-            if (ndim > 2) B_F(b).flux(X1DIR, V3, k, j, i) = -0.5 * (emf_pack(b, V2, k, j, i) + emf_pack(b, V2, k+1, j, i));
+            if constexpr (NDIM > 2) B_F(b).flux(X1DIR, V3, k, j, i) = -0.5 * (emf_pack(b, V2, k, j, i) + emf_pack(b, V2, k+1, j, i));
         }
     );
-    pmb0->par_for("flux_ct_2", block.s, block.e, kb.s, kb.e, jl.s, jl.e, ib.s, ib.e,
+    Tiling::par_for("flux_ct_2", pmb0->exec_space, block.s, block.e, kb.s, kb.e, jl.s, jl.e, ib.s, ib.e,
         KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
             B_F(b).flux(X2DIR, V1, k, j, i) = -0.5 * (emf_pack(b, V3, k, j, i) + emf_pack(b, V3, k, j, i+1));
             B_F(b).flux(X2DIR, V2, k, j, i) =  0.0;
-            if (ndim > 2) B_F(b).flux(X2DIR, V3, k, j, i) =  0.5 * (emf_pack(b, V1, k, j, i) + emf_pack(b, V1, k+1, j, i));
+            if constexpr (NDIM > 2) B_F(b).flux(X2DIR, V3, k, j, i) =  0.5 * (emf_pack(b, V1, k, j, i) + emf_pack(b, V1, k+1, j, i));
         }
     );
-    if (ndim > 2) {
-        pmb0->par_for("flux_ct_3", block.s, block.e, kl.s, kl.e, jb.s, jb.e, ib.s, ib.e,
+    if constexpr (NDIM > 2) {
+        Tiling::par_for("flux_ct_3", pmb0->exec_space, block.s, block.e, kl.s, kl.e, jb.s, jb.e, ib.s, ib.e,
             KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
                 B_F(b).flux(X3DIR, V1, k, j, i) =  0.5 * (emf_pack(b, V2, k, j, i) + emf_pack(b, V2, k, j, i+1));
                 B_F(b).flux(X3DIR, V2, k, j, i) = -0.5 * (emf_pack(b, V1, k, j, i) + emf_pack(b, V1, k, j+1, i));
@@ -369,6 +375,18 @@ void FluxCT(MeshData<Real> *md)
     }
 }
 
+void FluxCT(MeshData<Real> *md)
+{
+    // Exit on trivial operations
+    const int ndim = md->GetMeshPointer()->ndim;
+    if (ndim < 2) return;
+    if (ndim == 2) {
+        FluxCTDim<2>(md);
+    } else {
+        FluxCTDim<3>(md);
+    }
+}
+
 void ZeroBoundaryFlux(MeshData<Real> *md, IndexDomain domain, bool coarse)
 {
     // TODO write ONE implementation for any boundary
@@ -563,11 +581,11 @@ IndexRange ValidDivBX1(MeshBlock *pmb)
     return IndexRange{ibl.s + (avoid_inner), ibl.e + (!avoid_outer)};
 }
 
-double MaxDivB(MeshData<Real> *md)
+std::vector<Real> DivBStats(MeshData<Real> *md)
 {
     auto pmesh = md->GetMeshPointer();
     const int ndim = pmesh->ndim;
-    if (ndim < 2) return 0.;
+    if (ndim < 2) return {0., 0., 0.};
 
     // Packing out here avoids frequent per-mesh packs.  Do we need to?
     auto B_U = md->PackVariables(std::vector<std::string>{"cons.B"});
@@ -584,26 +602,36 @@ double MaxDivB(MeshData<Real> *md)
 
     // This is one kernel call per block, because each block will have different bounds.
     // Could consolidate at the cost of lots of bounds checking.
-    double max_divb = 0.0;
+    // Each computes the max, sum of squares, and number of corners, all in one sweep
+    std::vector<Real> divb_stats = {0., 0., 0.};
     for (int b = block.s; b <= block.e; ++b) {
         auto pmb = md->GetBlockData(b)->GetBlockPointer();
 
         const IndexRange ib = ValidDivBX1(pmb);
 
-        double max_divb_block;
-        Kokkos::Max<double> max_reducer(max_divb_block);
-        pmb->par_reduce("divB_max", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-            KOKKOS_LAMBDA (const int &k, const int &j, const int &i, double &local_result) {
+        Reductions::array_type<Real, 3> divb_reducer;
+        pmb->par_reduce("divB_stats", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+            KOKKOS_LAMBDA (const int &k, const int &j, const int &i,
+                           Reductions::array_type<Real, 3> &local_result) {
                 const auto& G = B_U.GetCoords(b);
-                const double local_divb = m::abs(corner_div(G, B_U(b), k, j, i, ndim > 2));
-                if (local_divb > local_result) local_result = local_divb;
+                const Real local_divb = m::abs(corner_div(G, B_U(b), k, j, i, ndim > 2));
+                if (local_divb > local_result.my_array[0]) local_result.my_array[0] = local_divb;
+                local_result.my_array[1] += local_divb * local_divb;
+                local_result.my_array[2] += 1.;
             }
-        , max_reducer);
+        , Reductions::ArrayMaxSum<Real, HostExecSpace, 3>(divb_reducer));
 
-        if (max_divb_block > max_divb) max_divb = max_divb_block;
+        if (divb_reducer.my_array[0] > divb_stats[0]) divb_stats[0] = divb_reducer.my_array[0];
+        divb_stats[1] += divb_reducer.my_array[1];
+        divb_stats[2] += divb_reducer.my_array[2];
     }
 
-    return max_divb;
+    return divb_stats;
+}
+
+double MaxDivB(MeshData<Real> *md)
+{
+    return DivBStats(md)[0];
 }
 
 double GlobalMaxDivB(MeshData<Real> *md, bool all_reduce)
@@ -617,7 +645,7 @@ double GlobalMaxDivB(MeshData<Real> *md, bool all_reduce)
     }
 }
 
-TaskStatus PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb)
+TaskStatus PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb, double divb_local)
 {
     auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
 
@@ -625,8 +653,10 @@ TaskStatus PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb)
     // unless we're being verbose. It's not costly to calculate though
     const bool print = pmb0->packages.Get("Globals")->Param<int>("verbose") >= 1;
     if (print || kill_on_large_divb) {
-        // Calculate the maximum from/on all nodes
-        const double divb_max = B_FluxCT::GlobalMaxDivB(md);
+        // Calculate the maximum from/on all nodes, unless we've already measured it here
+        if (divb_local < 0.) divb_local = B_FluxCT::MaxDivB(md);
+        Reductions::Start<Real>(md, 2, divb_local, MPI_MAX);
+        const double divb_max = Reductions::Check<Real>(md, 2);
         // Print on rank zero
         if (MPIRank0() && print) {
             // someday I'll learn stream options
@@ -642,6 +672,22 @@ TaskStatus PrintGlobalMaxDivB(MeshData<Real> *md, bool kill_on_large_divb)
     return TaskStatus::complete;
 }
 
+TaskStatus PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
+{
+    auto pmesh = md->GetMeshPointer();
+    const bool kill_on_large_divb = pmesh->packages.Get("B_FluxCT")->Param<bool>("kill_on_large_divb");
+    const bool print = pmesh->packages.Get("Globals")->Param<int>("verbose") >= 1;
+    const bool measure_for_cleanup = B_Cleanup::MeasureThisStep(pmesh, tm.ncycle);
+    if (!(print || kill_on_large_divb || measure_for_cleanup)) return TaskStatus::complete;
+
+    // A single sweep serves both the max printed here and a triggered cleanup's max & RMS
+    const std::vector<Real> divb_stats = DivBStats(md);
+    if (measure_for_cleanup) B_Cleanup::StartDivBMeasurement(md, divb_stats);
+    // The measurement finishes asynchronously, don't block on a global max nobody will read
+    if (!(print || kill_on_large_divb)) return TaskStatus::complete;
+    return PrintGlobalMaxDivB(md, kill_on_large_divb, divb_stats[0]);
+}
+
 // TODO unify these by adding FillOutputMesh option
 
 void CalcDivB(MeshData<Real> *md, std::string divb_field_name)
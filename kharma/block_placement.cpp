@@ -0,0 +1,96 @@
+/*
+ *  File: block_placement.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "block_placement.hpp"
+
+#include <iostream>
+
+void KHARMA::SetBlockPlacement(ParameterInput *pin)
+{
+    const std::string policy = pin->GetOrAddString("placement", "policy", "none");
+    if (policy == "none") return;
+    if (policy != "spherical")
+        throw std::invalid_argument("Unknown block placement policy "+policy+"! Options are none, spherical.");
+
+    Flag("SetBlockPlacement");
+    // Only useful (or correct) for spherical grids without refinement
+    if (!pin->GetBoolean("coordinates", "spherical")) {
+        if (MPIRank0()) std::cerr << "WARNING: placement/policy=spherical ignored for non-spherical coordinates" << std::endl;
+        EndFlag();
+        return;
+    }
+    if (pin->DoesBlockExist("parthenon/static_refinement0") ||
+        pin->GetOrAddString("parthenon/mesh", "refinement", "none") != "none") {
+        if (MPIRank0()) std::cerr << "WARNING: placement/policy=spherical ignored for refined meshes" << std::endl;
+        EndFlag();
+        return;
+    }
+
+    const int n1 = pin->GetInteger("parthenon/mesh", "nx1");
+    const int n2 = pin->GetInteger("parthenon/mesh", "nx2");
+    const int n3 = pin->GetInteger("parthenon/mesh", "nx3");
+    const int blocks_per_rank = pin->GetOrAddInteger("placement", "blocks_per_rank", 1);
+    // Thin blocks are mostly ghost zones: don't split any direction finer than this
+    const int min_block = pin->GetOrAddInteger("placement", "min_block_size", m::max(8, 2*Globals::nghost));
+    const int nblocks = MPINumRanks() * blocks_per_rank;
+
+    // Take the largest number of X2 wedges which leaves a valid X1 split, so that
+    // blocks cover as much of the radial range (and thus the same radial cost) as possible
+    int nb1 = -1, nb2 = -1;
+    for (int b2 = m::min(nblocks, n2); b2 >= 1; --b2) {
+        if (nblocks % b2 != 0 || n2 % b2 != 0 || (b2 > 1 && n2 / b2 < min_block)) continue;
+        const int b1 = nblocks / b2;
+        if (n1 % b1 != 0 || (b1 > 1 && n1 / b1 < min_block)) continue;
+        nb1 = b1;
+        nb2 = b2;
+        break;
+    }
+    if (nb1 < 0) {
+        if (MPIRank0()) std::cerr << "WARNING: could not split " << n1 << "x" << n2 << "x" << n3 << " mesh into "
+                                  << nblocks << " whole-phi blocks.  Using parthenon/meshblock sizes." << std::endl;
+        EndFlag();
+        return;
+    }
+
+    pin->SetInteger("parthenon/meshblock", "nx1", n1 / nb1);
+    pin->SetInteger("parthenon/meshblock", "nx2", n2 / nb2);
+    pin->SetInteger("parthenon/meshblock", "nx3", n3);
+
+    if (MPIRank0()) {
+        std::cout << "Spherical block placement: " << nb1 << "x" << nb2 << "x1 blocks of "
+                  << n1 / nb1 << "x" << n2 / nb2 << "x" << n3 << " zones, "
+                  << blocks_per_rank << " per rank" << std::endl;
+    }
+    EndFlag();
+}
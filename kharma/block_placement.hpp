@@ -0,0 +1,57 @@
+/*
+ *  File: block_placement.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+namespace KHARMA {
+
+/**
+ * Choose the meshblock size for spherical grids, if the user asks with placement/policy=spherical.
+ *
+ * Parthenon hands blocks to ranks in contiguous chunks along its space-filling curve, which knows
+ * nothing about spherical grids.  Rather than fight the curve, we pick blocks it can't place badly:
+ * 1. Every block spans all of X3, so phi stacks and their cross-pole partners live in one block
+ *    (and can use the "transmitting" polar boundary, which needs exactly this)
+ * 2. Blocks are split in X2 before X1, so each block covers the whole radial range where possible.
+ *    Per-block cost varies mostly with radius, so wedges cost the same and balance trivially.
+ *    Since no two wedges share an X1/X2 extent, no geometry is duplicated between blocks, either.
+ * 3. The total number of blocks is exactly placement/blocks_per_rank times the number of ranks.
+ *
+ * Must be called before the Mesh is constructed.  Overrides any parthenon/meshblock sizes.
+ */
+void SetBlockPlacement(ParameterInput *pin);
+
+}
@@ -0,0 +1,566 @@
+/*
+ *  File: halo_exchange.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "halo_exchange.hpp"
+
+#include "domain.hpp"
+#include "reblock.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using Reblock::Extent;
+
+namespace {
+
+bool enabled = false;
+// The mesh the layout below describes
+Mesh *mesh = nullptr;
+std::vector<Extent> extents;
+// Index in 'extents' of the block starting at a zone, and of each of this rank's blocks by gid
+std::map<std::array<int, 3>, int> by_offset;
+std::map<int, int> by_gid;
+int ntot[3];
+#if ENABLE_MPI
+MPI_Comm comm = MPI_COMM_NULL;
+#endif
+
+// Ranks on this node, for halo/shared_memory: our index on the node, the node's size,
+// and the index of each rank (-1 for ranks on other nodes)
+bool shared = false;
+#if ENABLE_MPI
+MPI_Comm node_comm = MPI_COMM_NULL;
+#endif
+int node_rank = 0, node_size = 1;
+std::vector<int> node_rank_of;
+
+// Columns of the per-message tables used by the pack & unpack kernels
+enum Col {BLOCK = 0, LO1, LO2, LO3, N1, N2, N3, OFFSET, DEST, NCOL};
+// Where a message is packed to or unpacked from: MPI buffers (which hold messages within this rank too),
+// or the node's shared window
+enum Dest {SEND_BUF = 0, RECV_BUF, SHARED};
+// Each rank's flags in the shared flag window, one of each per rank on the node writing to it:
+// start of that rank's messages in our segment, and the last exchange it wrote & we read
+enum FlagIndex {CHUNK = 0, ARRIVED, UNPACKED, NFLAG};
+
+// One message: the block 'src' sends its zones next to direction 'dir' to the block 'dst'.
+// Both are indices in 'extents'
+struct Link {
+    int src, dst, dir;
+};
+
+struct Plan {
+    int nsend = 0, nrecv = 0;
+    ParArray2D<int> send_rows, recv_rows;
+    ParArray1D<Real> send_buf, recv_buf;
+#if ENABLE_MPI
+    std::vector<MPI_Request> send_req, recv_req;
+    MPI_Win data_win = MPI_WIN_NULL, flag_win = MPI_WIN_NULL;
+#endif
+    // Shared-memory messages: start of the node's data window, our flags, the flags of each rank we
+    // write to, and the node ranks which write to us
+    Real *shm_base = nullptr;
+    volatile long long *my_flags = nullptr;
+    std::vector<volatile long long *> dest_flags;
+    std::vector<int> shm_srcs;
+    // Exchanges started with this plan
+    long long seq = 0;
+};
+// Plans for each set of variables (and blocks) synchronized so far
+std::map<std::string, Plan> plans;
+Plan *in_flight = nullptr;
+
+int DirIndex(const int o[3]) { return (o[0] + 1) + 3 * (o[1] + 1) + 9 * (o[2] + 1); }
+
+bool OnNode(const int rank) { return shared && rank != MPIRank() && node_rank_of[rank] >= 0; }
+
+/**
+ * Index of the block next to this rank's block 'pmb' in direction 'o', or -1 at a physical boundary
+ */
+int Neighbor(MeshBlock *pmb, const Extent& ext, const int o[3])
+{
+    std::array<int, 3> off;
+    for (int d = 0; d < 3; ++d) {
+        off[d] = ext.off[d];
+        if (o[d] == 0) continue;
+        const BoundaryFlag flag = pmb->boundary_flag[2 * d + (o[d] > 0)];
+        if (flag != BoundaryFlag::block && flag != BoundaryFlag::periodic) return -1;
+        off[d] = (ext.off[d] + o[d] * ext.n[d] + ntot[d]) % ntot[d];
+    }
+    const auto nb = by_offset.find(off);
+    return (nb == by_offset.end()) ? -1 : nb->second;
+}
+
+/**
+ * Zones sent along direction 'o' (from the sender's interior), or received (into the receiver's ghosts)
+ */
+void Region(const IndexRange3& b, const int o[3], const bool recv, int lo[3], int n[3])
+{
+    const int ng = Globals::nghost;
+    const int s[3] = {b.is, b.js, b.ks}, e[3] = {b.ie, b.je, b.ke};
+    for (int d = 0; d < 3; ++d) {
+        if (o[d] == 0) {
+            lo[d] = s[d];
+            n[d] = e[d] - s[d] + 1;
+        } else {
+            // The receiver sits in direction o from the sender, so their sides facing each other are opposite
+            const bool upper = recv ? (o[d] < 0) : (o[d] > 0);
+            lo[d] = recv ? (upper ? e[d] + 1 : s[d] - ng) : (upper ? e[d] - ng + 1 : s[d]);
+            n[d] = ng;
+        }
+    }
+}
+
+void Unflatten(const int dir, int o[3])
+{
+    o[0] = dir % 3 - 1;
+    o[1] = (dir / 3) % 3 - 1;
+    o[2] = dir / 9 - 1;
+}
+
+ParArray2D<int> ToDevice(const std::string& name, const std::vector<std::array<int, NCOL>>& rows)
+{
+    ParArray2D<int> out(name, m::max(rows.size(), (size_t) 1), NCOL);
+    auto out_host = Kokkos::create_mirror_view(out);
+    for (size_t r = 0; r < rows.size(); ++r)
+        for (int c = 0; c < NCOL; ++c) out_host(r, c) = rows[r][c];
+    Kokkos::deep_copy(out, out_host);
+    return out;
+}
+
+#if ENABLE_MPI
+volatile long long *NodeFlags(const Plan& plan, const int rank_on_node)
+{
+    MPI_Aint size;
+    int disp_unit;
+    long long *flags;
+    MPI_Win_shared_query(plan.flag_win, rank_on_node, &size, &disp_unit, &flags);
+    return flags;
+}
+#endif
+
+/**
+ * Lay out every message to & from this rank's blocks in 'md', in one buffer for sends and one for receives.
+ * Within each pair of ranks, both sides order the messages by sending block and direction, so one message
+ * per pair is enough.  Messages between blocks on this rank are packed straight into the receive buffer.
+ * The neighbors of a block are known from the extents gathered in Initialize, so this is local,
+ * except with halo/shared_memory: then messages to other ranks on the node are packed straight into
+ * their segments of a window allocated here, collectively over the node.
+ * Every rank builds a plan at the same exchange, since all ranks synchronize the same variables in order
+ */
+Plan BuildPlan(MeshData<Real> *md, const int ncomp)
+{
+    const int me = MPIRank();
+    const int ndim = mesh->ndim;
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::interior);
+
+    std::map<int, int> md_index;
+    std::vector<Link> sends, recvs;
+    for (int i_block = 0; i_block < md->NumBlocks(); ++i_block) {
+        auto pmb = md->GetBlockData(i_block)->GetBlockPointer();
+        const int e = by_gid.at(pmb->gid);
+        md_index[e] = i_block;
+        for (int dir = 0; dir < 27; ++dir) {
+            int o[3];
+            Unflatten(dir, o);
+            if (dir == 13 || (ndim < 2 && o[1] != 0) || (ndim < 3 && o[2] != 0)) continue;
+            const int nb = Neighbor(pmb.get(), extents[e], o);
+            if (nb < 0) continue;
+            const int o_back[3] = {-o[0], -o[1], -o[2]};
+            sends.push_back({e, nb, dir});
+            // The neighbor at 'o' sends to us along -o
+            recvs.push_back({nb, e, DirIndex(o_back)});
+        }
+    }
+    auto by_rank = [](const int rank_of_a, const Link& a, const int rank_of_b, const Link& b) {
+        return std::tie(rank_of_a, a.src, a.dir) < std::tie(rank_of_b, b.src, b.dir);
+    };
+    std::sort(sends.begin(), sends.end(), [&](const Link& a, const Link& c) {
+        return by_rank(extents[a.dst].rank, a, extents[c.dst].rank, c);
+    });
+    std::sort(recvs.begin(), recvs.end(), [&](const Link& a, const Link& c) {
+        return by_rank(extents[a.src].rank, a, extents[c.src].rank, c);
+    });
+    auto message_size = [&](const Link& l, const bool recv, int lo[3], int n[3]) {
+        int o[3];
+        Unflatten(l.dir, o);
+        Region(b, o, recv, lo, n);
+        return (size_t) ncomp * n[0] * n[1] * n[2];
+    };
+
+    Plan plan;
+    std::vector<std::array<int, NCOL>> send_rows, recv_rows;
+    // Start & length of the message to or from each rank
+    std::map<int, std::array<size_t, 2>> send_msgs, recv_msgs;
+    std::map<std::array<int, 2>, size_t> local_offset;
+    // Start of the messages from each rank on the node, within our segment
+    std::map<int, size_t> shm_chunk;
+    size_t recv_size = 0, send_size = 0, shm_size = 0;
+    int lo[3], n[3];
+    for (const auto& l : recvs) {
+        const int peer = extents[l.src].rank;
+        if (OnNode(peer)) {
+            if (!shm_chunk.count(peer)) shm_chunk[peer] = shm_size;
+            shm_size += message_size(l, true, lo, n);
+        }
+    }
+
+    size_t shm_offset = 0;
+#if ENABLE_MPI
+    if (shared) {
+        Real *my_data;
+        long long *my_flags;
+        MPI_Win_allocate_shared(shm_size * sizeof(Real), sizeof(Real), MPI_INFO_NULL, node_comm,
+                                &my_data, &plan.data_win);
+        MPI_Win_allocate_shared(NFLAG * node_size * sizeof(long long), sizeof(long long), MPI_INFO_NULL, node_comm,
+                                &my_flags, &plan.flag_win);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, plan.data_win);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, plan.flag_win);
+        // Segments are contiguous, so every rank addresses the others' from the first non-empty one
+        MPI_Aint size;
+        int disp_unit;
+        MPI_Win_shared_query(plan.data_win, MPI_PROC_NULL, &size, &disp_unit, &plan.shm_base);
+        if (shm_size > 0) shm_offset = my_data - plan.shm_base;
+        if (shm_offset + shm_size > std::numeric_limits<int>::max())
+            throw std::runtime_error("Halo exchange shared window too large, set halo/shared_memory=false!");
+        plan.my_flags = my_flags;
+        for (int i = 0; i < NFLAG * node_size; ++i) plan.my_flags[i] = 0;
+        for (const auto& chunk : shm_chunk) {
+            plan.my_flags[CHUNK * node_size + node_rank_of[chunk.first]] = shm_offset + chunk.second;
+            plan.shm_srcs.push_back(node_rank_of[chunk.first]);
+        }
+        // Everyone's chunk starts must be written before anyone reads them
+        MPI_Win_sync(plan.flag_win);
+        MPI_Barrier(node_comm);
+        MPI_Win_sync(plan.flag_win);
+    }
+#endif
+
+    size_t shm_pos = shm_offset;
+    for (const auto& l : recvs) {
+        const size_t size = message_size(l, true, lo, n);
+        const int peer = extents[l.src].rank;
+        if (OnNode(peer)) {
+            recv_rows.push_back({md_index.at(l.dst), lo[0], lo[1], lo[2], n[0], n[1], n[2], (int) shm_pos, SHARED});
+            shm_pos += size;
+            continue;
+        }
+        if (peer == me) {
+            local_offset[{l.src, l.dir}] = recv_size;
+        } else {
+            if (!recv_msgs.count(peer)) recv_msgs[peer] = {recv_size, 0};
+            recv_msgs[peer][1] += size;
+        }
+        recv_rows.push_back({md_index.at(l.dst), lo[0], lo[1], lo[2], n[0], n[1], n[2], (int) recv_size, RECV_BUF});
+        recv_size += size;
+    }
+    // Next position in each on-node receiver's segment
+    std::map<int, size_t> shm_dest_pos;
+    for (const auto& l : sends) {
+        const size_t size = message_size(l, false, lo, n);
+        const int peer = extents[l.dst].rank;
+        if (peer == me) {
+            send_rows.push_back({md_index.at(l.src), lo[0], lo[1], lo[2], n[0], n[1], n[2],
+                                 (int) local_offset.at({l.src, l.dir}), RECV_BUF});
+        } else if (OnNode(peer)) {
+#if ENABLE_MPI
+            if (!shm_dest_pos.count(peer)) {
+                plan.dest_flags.push_back(NodeFlags(plan, node_rank_of[peer]));
+                shm_dest_pos[peer] = plan.dest_flags.back()[CHUNK * node_size + node_rank];
+            }
+#endif
+            send_rows.push_back({md_index.at(l.src), lo[0], lo[1], lo[2], n[0], n[1], n[2],
+                                 (int) shm_dest_pos[peer], SHARED});
+            shm_dest_pos[peer] += size;
+        } else {
+            if (!send_msgs.count(peer)) send_msgs[peer] = {send_size, 0};
+            send_msgs[peer][1] += size;
+            send_rows.push_back({md_index.at(l.src), lo[0], lo[1], lo[2], n[0], n[1], n[2], (int) send_size, SEND_BUF});
+            send_size += size;
+        }
+    }
+    if (recv_size > std::numeric_limits<int>::max() || send_size > std::numeric_limits<int>::max())
+        throw std::runtime_error("Halo exchange buffers too large, use halo/exchange=parthenon!");
+
+    plan.nsend = send_rows.size();
+    plan.nrecv = recv_rows.size();
+    plan.send_rows = ToDevice("halo_send_rows", send_rows);
+    plan.recv_rows = ToDevice("halo_recv_rows", recv_rows);
+    plan.send_buf = ParArray1D<Real>("halo_send_buf", m::max(send_size, (size_t) 1));
+    plan.recv_buf = ParArray1D<Real>("halo_recv_buf", m::max(recv_size, (size_t) 1));
+
+#if ENABLE_MPI
+    // Every message between a pair of ranks has the same tag: only one exchange is in flight at once
+    for (const auto& msg : recv_msgs) {
+        plan.recv_req.emplace_back();
+        MPI_Recv_init(plan.recv_buf.data() + msg.second[0], msg.second[1], MPI_PARTHENON_REAL,
+                      msg.first, 0, comm, &plan.recv_req.back());
+    }
+    for (const auto& msg : send_msgs) {
+        plan.send_req.emplace_back();
+        MPI_Send_init(plan.send_buf.data() + msg.second[0], msg.second[1], MPI_PARTHENON_REAL,
+                      msg.first, 0, comm, &plan.send_req.back());
+    }
+#endif
+    return plan;
+}
+
+/**
+ * Plans are keyed by the variables exchanged and the blocks they're on
+ */
+std::string PlanKey(MeshData<Real> *md)
+{
+    std::string key;
+    for (auto &v : md->GetBlockData(0)->GetVariableVector())
+        if (v->IsSet(Metadata::FillGhost)) key += v->label() + ";";
+    for (int i_block = 0; i_block < md->NumBlocks(); ++i_block)
+        key += std::to_string(md->GetBlockData(i_block)->GetBlockPointer()->gid) + ",";
+    return key;
+}
+
+void FreePlans()
+{
+#if ENABLE_MPI
+    for (auto &p : plans) {
+        for (auto &req : p.second.send_req) MPI_Request_free(&req);
+        for (auto &req : p.second.recv_req) MPI_Request_free(&req);
+        for (MPI_Win *win : {&p.second.data_win, &p.second.flag_win}) {
+            if (*win == MPI_WIN_NULL) continue;
+            MPI_Win_unlock_all(*win);
+            MPI_Win_free(win);
+        }
+    }
+#endif
+    plans.clear();
+    in_flight = nullptr;
+}
+
+} // namespace
+
+void HaloExchange::Initialize(ParameterInput *pin, Mesh *pmesh)
+{
+    Finalize();
+    const std::string exchange = pin->GetOrAddString("halo", "exchange", "parthenon");
+    if (exchange != "parthenon" && exchange != "persistent")
+        throw std::invalid_argument("Unknown halo/exchange " + exchange + ", use parthenon or persistent!");
+    const bool shared_memory = pin->GetOrAddBoolean("halo", "shared_memory", false);
+    if (exchange == "parthenon") return;
+    if (pmesh->multilevel) {
+        if (MPIRank0()) std::cerr << "WARNING: halo/exchange=persistent needs a uniform mesh, using Parthenon's" << std::endl;
+        return;
+    }
+
+    Flag("HaloExchange::Initialize");
+    mesh = pmesh;
+    for (int d = 0; d < 3; ++d) ntot[d] = pmesh->mesh_size.nx(static_cast<CoordinateDirection>(d + 1));
+    std::vector<Extent> mine;
+    for (auto &pmb : pmesh->block_list) mine.push_back(Reblock::GetExtent(pmb.get(), pmesh));
+    extents = Reblock::AllExtents(mine);
+    for (int e = 0; e < extents.size(); ++e) {
+        by_offset[{extents[e].off[0], extents[e].off[1], extents[e].off[2]}] = e;
+        if (extents[e].rank == MPIRank()) by_gid[extents[e].gid] = e;
+    }
+#if ENABLE_MPI
+    // Our own communicator, so nothing here can match Parthenon's messages
+    MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+    // Ranks pack straight into each other's memory, which GPU kernels can't reach
+    constexpr bool host_exec = Kokkos::SpaceAccessibility<DevExecSpace, Kokkos::HostSpace>::accessible;
+    if (shared_memory && !host_exec && MPIRank0())
+        std::cerr << "WARNING: halo/shared_memory ignored for GPU builds" << std::endl;
+    if (shared_memory && host_exec) {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+        MPI_Comm_rank(node_comm, &node_rank);
+        MPI_Comm_size(node_comm, &node_size);
+        std::vector<int> members(node_size);
+        const int me = MPIRank();
+        MPI_Allgather(&me, 1, MPI_INT, members.data(), 1, MPI_INT, node_comm);
+        node_rank_of.assign(MPINumRanks(), -1);
+        for (int i = 0; i < node_size; ++i) node_rank_of[members[i]] = i;
+        shared = true;
+    }
+#endif
+    enabled = true;
+    if (MPIRank0() && pin->GetOrAddInteger("debug", "verbose", 0) > 0) {
+        std::cout << "Exchanging ghost zones with persistent requests"
+                  << (shared ? ", and through shared memory within each node" : "") << std::endl;
+    }
+    EndFlag();
+}
+
+void HaloExchange::Finalize()
+{
+    FreePlans();
+#if ENABLE_MPI
+    if (node_comm != MPI_COMM_NULL) MPI_Comm_free(&node_comm);
+    if (comm != MPI_COMM_NULL) MPI_Comm_free(&comm);
+#endif
+    shared = false;
+    node_rank = 0;
+    node_size = 1;
+    node_rank_of.clear();
+    extents.clear();
+    by_offset.clear();
+    by_gid.clear();
+    mesh = nullptr;
+    enabled = false;
+}
+
+bool HaloExchange::Handles(MeshData<Real> *md)
+{
+    if (!enabled || md->GetMeshPointer() != mesh || md->NumBlocks() != static_cast<int>(mesh->block_list.size()))
+        return false;
+    for (auto &v : md->GetBlockData(0)->GetVariableVector())
+        if (v->IsSet(Metadata::FillGhost) && (!v->IsSet(Metadata::Cell) || v->IsSparse())) return false;
+    return true;
+}
+
+TaskStatus HaloExchange::Start(MeshData<Real> *md)
+{
+    if (in_flight != nullptr) return TaskStatus::incomplete;
+    auto P = md->PackVariables(std::vector<MetadataFlag>{Metadata::FillGhost, Metadata::Cell});
+    const int ncomp = P.GetDim(4);
+    const std::string key = PlanKey(md);
+    if (!plans.count(key)) plans[key] = BuildPlan(md, ncomp);
+    Plan &plan = plans.at(key);
+
+#if ENABLE_MPI
+    // Don't overwrite a segment on the node until its owner has unpacked the last exchange
+    if (!plan.dest_flags.empty()) {
+        MPI_Win_sync(plan.flag_win);
+        for (auto flags : plan.dest_flags)
+            if (flags[UNPACKED * node_size + node_rank] != plan.seq) return TaskStatus::incomplete;
+    }
+#endif
+    Flag("HaloExchange::Start");
+    const long long seq = ++plan.seq;
+
+#if ENABLE_MPI
+    if (!plan.recv_req.empty()) MPI_Startall(plan.recv_req.size(), plan.recv_req.data());
+#endif
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    if (plan.nsend > 0 && ncomp > 0) {
+        auto rows = plan.send_rows;
+        auto send_buf = plan.send_buf;
+        auto recv_buf = plan.recv_buf;
+        Real *shm = plan.shm_base;
+        parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "halo_pack", pmb0->exec_space,
+            0, 1, 0, plan.nsend - 1, 0, ncomp - 1,
+            KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& l, const int& v) {
+                const int b = rows(l, BLOCK), n1 = rows(l, N1), n2 = rows(l, N2);
+                const int is = rows(l, LO1), js = rows(l, LO2), ks = rows(l, LO3);
+                const int nn = n1 * n2 * rows(l, N3);
+                Real *buf = (rows(l, DEST) == SEND_BUF) ? send_buf.data() :
+                            ((rows(l, DEST) == RECV_BUF) ? recv_buf.data() : shm);
+                buf += rows(l, OFFSET) + v * nn;
+                parthenon::par_for_inner(member, 0, nn - 1,
+                    [&](const int& m) {
+                        buf[m] = P(b, v, ks + m / (n1 * n2), js + (m / n1) % n2, is + m % n1);
+                    }
+                );
+            }
+        );
+    }
+    // MPI reads the buffer directly
+    pmb0->exec_space.fence();
+#if ENABLE_MPI
+    // Publish our writes to the node, then tell each receiver they're there
+    if (!plan.dest_flags.empty()) {
+        MPI_Win_sync(plan.data_win);
+        for (auto flags : plan.dest_flags) flags[ARRIVED * node_size + node_rank] = seq;
+        MPI_Win_sync(plan.flag_win);
+    }
+    if (!plan.send_req.empty()) MPI_Startall(plan.send_req.size(), plan.send_req.data());
+#endif
+    in_flight = &plan;
+    EndFlag();
+    return TaskStatus::complete;
+}
+
+TaskStatus HaloExchange::Finish(MeshData<Real> *md)
+{
+    Plan &plan = *in_flight;
+#if ENABLE_MPI
+    // Sends must finish too, before the buffer can be packed again
+    int done = 1;
+    if (!plan.recv_req.empty()) MPI_Testall(plan.recv_req.size(), plan.recv_req.data(), &done, MPI_STATUSES_IGNORE);
+    if (!done) return TaskStatus::incomplete;
+    if (!plan.send_req.empty()) MPI_Testall(plan.send_req.size(), plan.send_req.data(), &done, MPI_STATUSES_IGNORE);
+    if (!done) return TaskStatus::incomplete;
+    if (!plan.shm_srcs.empty()) {
+        MPI_Win_sync(plan.flag_win);
+        for (const int src : plan.shm_srcs)
+            if (plan.my_flags[ARRIVED * node_size + src] != plan.seq) return TaskStatus::incomplete;
+        MPI_Win_sync(plan.data_win);
+    }
+#endif
+    Flag("HaloExchange::Finish");
+    auto P = md->PackVariables(std::vector<MetadataFlag>{Metadata::FillGhost, Metadata::Cell});
+    const int ncomp = P.GetDim(4);
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    if (plan.nrecv > 0 && ncomp > 0) {
+        auto rows = plan.recv_rows;
+        auto recv_buf = plan.recv_buf;
+        const Real *shm = plan.shm_base;
+        parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "halo_unpack", pmb0->exec_space,
+            0, 1, 0, plan.nrecv - 1, 0, ncomp - 1,
+            KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& l, const int& v) {
+                const int b = rows(l, BLOCK), n1 = rows(l, N1), n2 = rows(l, N2);
+                const int is = rows(l, LO1), js = rows(l, LO2), ks = rows(l, LO3);
+                const int nn = n1 * n2 * rows(l, N3);
+                const Real *buf = ((rows(l, DEST) == SHARED) ? shm : recv_buf.data()) + rows(l, OFFSET) + v * nn;
+                parthenon::par_for_inner(member, 0, nn - 1,
+                    [&](const int& m) {
+                        P(b, v, ks + m / (n1 * n2), js + (m / n1) % n2, is + m % n1) = buf[m];
+                    }
+                );
+            }
+        );
+    }
+#if ENABLE_MPI
+    // Let the senders on the node know they can write again
+    if (!plan.shm_srcs.empty()) {
+        pmb0->exec_space.fence();
+        for (const int src : plan.shm_srcs) plan.my_flags[UNPACKED * node_size + src] = plan.seq;
+        MPI_Win_sync(plan.flag_win);
+    }
+#endif
+    in_flight = nullptr;
+    EndFlag();
+    return TaskStatus::complete;
+}
@@ -0,0 +1,96 @@
+/*
+ *  File: halo_exchange.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * KHARMA's own ghost zone exchange for uniform meshes, enabled with halo/exchange=persistent.
+ *
+ * Parthenon's boundary communication posts fresh sends & receives for every neighbor, every time a
+ * MeshData is synchronized.  The neighbors of a block never change between re-meshes, so this instead
+ * builds a "plan" the first time each set of variables is synchronized: every message this rank sends
+ * to (or receives from) another rank is packed into one contiguous buffer, and a persistent request
+ * (MPI_Send_init/MPI_Recv_init) is created for each neighboring rank.  Each exchange after that is
+ * just MPI_Startall, a single pack kernel, MPI_Testall and a single unpack kernel.
+ * Exchanges between blocks on the same rank are copied directly, without MPI.
+ *
+ * With halo/shared_memory=true (CPU builds only), messages between ranks on the same node skip MPI too.
+ * Each plan allocates an MPI-3 shared-memory window over the node (MPI_Win_allocate_shared), in which
+ * every rank holds a segment for its incoming on-node messages.  Senders pack straight into the receiver's
+ * segment, then bump a counter next to it; the receiver unpacks once every counter has reached the current
+ * exchange, then bumps a counter of its own to say the segment may be overwritten.  Only messages
+ * to other nodes still go through MPI_Send_init/MPI_Recv_init.
+ *
+ * Plans are only valid for the mesh passed to Initialize, which must be called again after the mesh is
+ * rebuilt (see reblock.hpp).  Exchanges this can't do fall back to Parthenon's, see Handles().
+ * As with Parthenon's exchange on GPUs, the buffers are device memory, so MPI must be GPU-aware.
+ */
+namespace HaloExchange {
+
+/**
+ * Read options and gather the layout of 'pmesh', dropping any plans for a previous mesh.  Collective.
+ * Call after building each mesh, before it is first synchronized.
+ * With halo/shared_memory, building a plan is collective over the node: every rank builds its plans at the
+ * same exchanges, since all ranks synchronize the same variables in the same order
+ */
+void Initialize(ParameterInput *pin, Mesh *pmesh);
+
+/**
+ * Free all plans, buffers and MPI requests.  Collective, call before MPI & Kokkos are finalized
+ */
+void Finalize();
+
+/**
+ * Whether Start/Finish can synchronize 'md': the exchange is enabled, the mesh isn't refined,
+ * 'md' holds all of this rank's blocks, and every FillGhost variable is dense and cell-centered.
+ * The answer is the same on all ranks
+ */
+bool Handles(MeshData<Real> *md);
+
+/**
+ * Start receives, pack all outgoing ghost zones, and start sends.
+ * Messages are matched by the order exchanges are started, so only one exchange is in flight at a time:
+ * this waits (returns incomplete) until any other has finished.
+ */
+TaskStatus Start(MeshData<Real> *md);
+
+/**
+ * Once all messages have arrived, fill the ghost zones of 'md'.
+ * Physical boundaries are not applied here, see KHARMADriver::AddBoundarySync
+ */
+TaskStatus Finish(MeshData<Real> *md);
+
+}
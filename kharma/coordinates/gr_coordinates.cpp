@@ -42,6 +42,9 @@
 // types, which are not available when importing this file's header
 #include "types.hpp"
 
+#include <map>
+#include <tuple>
+
 using Kokkos::MDRangePolicy;
 using Kokkos::Rank;
 
@@ -72,6 +75,7 @@ GRCoordinates::GRCoordinates(const RegionSize &rs, ParameterInput *pin): Uniform
 
     connection_average_points = pin->GetOrAddInteger("coordinates", "connection_average_points", 1);
     correct_connections = pin->GetOrAddBoolean("coordinates", "correct_connections", false);
+    share_geometry = pin->GetOrAddBoolean("coordinates", "share_geometry", true);
 
     init_GRCoordinates(*this);
 }
@@ -79,12 +83,40 @@ GRCoordinates::GRCoordinates(const RegionSize &rs, ParameterInput *pin): Uniform
 GRCoordinates::GRCoordinates(const GRCoordinates &src, int coarsen): UniformCartesian(src, coarsen),
     coords(src.coords), n1(src.n1/coarsen), n2(src.n2/coarsen), n3(src.n3/coarsen),
     connection_average_points(src.connection_average_points),
-    correct_connections(src.correct_connections)
+    correct_connections(src.correct_connections),
+    share_geometry(src.share_geometry)
 {
     //std::cerr << "Calling coarsen constructor" << std::endl;
     init_GRCoordinates(*this);
 }
 
+/**
+ * Geometry caches depend only on the block's X1/X2 extent & size (and the coordinate system,
+ * which is fixed for a run).  So, blocks which share these (e.g. every block in a stack along X3,
+ * in spherical coordinates) can share a single copy of the caches, rather than each block
+ * computing and storing its own.
+ *
+ * This is the map from those parameters to existing caches.  Views are reference-counted,
+ * so we just keep a copy of each here until Kokkos finalizes.
+ */
+typedef std::tuple<int, int, GReal, GReal, GReal, GReal, int, bool> GeomCacheKey;
+struct GeomCacheEntry {
+    GeomTensor2 gcon_direct, gcov_direct;
+    GeomScalar gdet_direct;
+    GeomTensor3 conn_direct, gdet_conn_direct;
+};
+std::map<GeomCacheKey, GeomCacheEntry>& GeomCache()
+{
+    static std::map<GeomCacheKey, GeomCacheEntry> cache;
+    static bool registered_hook = false;
+    if (!registered_hook) {
+        // Views must be freed before Kokkos is finalized, so we can't wait for static destructors
+        Kokkos::push_finalize_hook([]() { GeomCache().clear(); });
+        registered_hook = true;
+    }
+    return cache;
+}
+
 /**
  * Initialize any cached geometry that GRCoordinates will need to return. While
  * GRCoordinates objects will be moved device-side, this can be run only on the
@@ -100,6 +132,19 @@ void init_GRCoordinates(GRCoordinates& G) {
     const bool correct_connections = G.correct_connections;
     const int connection_average_points = G.connection_average_points;
 
+    // If another block with the same X1/X2 extent already computed its geometry, use that
+    const GeomCacheKey key = std::make_tuple(n1, n2, G.Xf<1>(0), G.Dxc<1>(0), G.Xf<2>(0), G.Dxc<2>(0),
+                                             connection_average_points, correct_connections);
+    if (G.share_geometry && GeomCache().count(key)) {
+        const auto& entry = GeomCache().at(key);
+        G.gcon_direct = entry.gcon_direct;
+        G.gcov_direct = entry.gcov_direct;
+        G.gdet_direct = entry.gdet_direct;
+        G.conn_direct = entry.conn_direct;
+        G.gdet_conn_direct = entry.gdet_conn_direct;
+        return;
+    }
+
     //cerr << "Creating GRCoordinate cache size " << n1 << " " << n2 << std::endl;
     // Cache geometry.  May be faster than re-computing. May not be.
     G.gcon_direct = GeomTensor2("gcon", NLOC, n2+1, n1+1, GR_DIM, GR_DIM);
@@ -245,5 +290,10 @@ void init_GRCoordinates(GRCoordinates& G) {
             }
         );
     }
+
+    // Register the new caches for any other blocks which match
+    if (G.share_geometry) {
+        GeomCache()[key] = GeomCacheEntry{gcon_local, gcov_local, gdet_local, conn_local, gdet_conn_local};
+    }
 }
 #endif // FAST_CARTESIAN
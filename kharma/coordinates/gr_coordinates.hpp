@@ -82,6 +82,10 @@ public:
     // metric determinant derivatives discretized at faces
     bool correct_connections = false;
 
+    // Whether to share geometry caches between blocks with identical X1/X2 extents.
+    // Must be disabled for any geometry which varies along X3
+    bool share_geometry = true;
+
     // Caches for geometry values at zone centers/faces/etc
 #if !FAST_CARTESIAN && !NO_CACHE
     GeomTensor2 gcon_direct, gcov_direct;
@@ -102,7 +106,8 @@ public:
     KOKKOS_FUNCTION GRCoordinates(const GRCoordinates &src): UniformCartesian(src),
         n1(src.n1), n2(src.n2), n3(src.n3), coords(src.coords),
         connection_average_points(src.connection_average_points),
-        correct_connections(src.correct_connections)
+        correct_connections(src.correct_connections),
+        share_geometry(src.share_geometry)
     {
         //std::cerr << "Calling copy constructor size " << src.n1 << " " << src.n2 << std::endl;
 #if !FAST_CARTESIAN && !NO_CACHE
@@ -125,6 +130,7 @@ public:
         n3 = src.n3;
         connection_average_points = src.connection_average_points;
         correct_connections = src.correct_connections;
+        share_geometry = src.share_geometry;
 #if !FAST_CARTESIAN && !NO_CACHE
         gcon_direct = src.gcon_direct;
         gcov_direct = src.gcov_direct;
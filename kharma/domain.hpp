@@ -197,4 +197,107 @@ inline IndexSize3 GetBlockSize(T data, IndexDomain domain=IndexDomain::entire)
     return IndexSize3{n1, n2, n3};
 }
 
+/**
+ * List of flagged (e.g. failed) zones across all blocks of a MeshData object, for fixups.
+ * Failures are rare, so rather than launching a kernel over every zone of every block,
+ * ListZones counts flagged zones in one mesh-wide pass (which is all a healthy step costs),
+ * and only if there are any, stream-compacts them into a list for fixups to run over.
+ */
+struct ZoneList {
+    // Number of listed zones
+    int n = 0;
+    // Listed zones as 4*n entries: b, k, j, i
+    ParArray1D<int> zones;
+    // Range searched in each block as 6*nblocks entries, in IndexRange3 order.
+    // Fixups should use these to check which neighbors are available
+    ParArray1D<int> ranges;
+};
+
+/**
+ * Build a ZoneList of all zones where is_failed(flag) is true, for the given field.
+ * If physical_only, search only the physical range of each block (see GetPhysicalRange),
+ * otherwise the entire block.
+ */
+template<typename F>
+inline ZoneList ListZones(MeshData<Real> *md, const std::string& flag_name, bool physical_only, const F& is_failed)
+{
+    ZoneList list;
+    auto& flag = md->PackVariables(std::vector<std::string>{flag_name});
+    const int nb = flag.GetDim(5);
+    if (nb == 0) return list;
+
+    // Ranges can differ by block, e.g. physical ranges at the domain edges
+    list.ranges = ParArray1D<int>("zone_list_ranges", 6*nb);
+    auto ranges_h = list.ranges.GetHostMirror();
+    for (int b=0; b < nb; ++b) {
+        const auto rc = md->GetBlockData(b).get();
+        const IndexRange3 r = (physical_only) ? GetPhysicalRange(rc) : GetRange(rc, IndexDomain::entire);
+        ranges_h[6*b + 0] = r.is; ranges_h[6*b + 1] = r.ie;
+        ranges_h[6*b + 2] = r.js; ranges_h[6*b + 3] = r.je;
+        ranges_h[6*b + 4] = r.ks; ranges_h[6*b + 5] = r.ke;
+    }
+    list.ranges.DeepCopy(ranges_h);
+    const auto ranges = list.ranges;
+
+    // Search over a flattened index, so the same index can be compacted in a scan.
+    // Large packs can hold more than 2^31 zones, so the index is 64-bit
+    const IndexRange3 be = GetRange(md, IndexDomain::entire);
+    const int64_t n1 = be.ie - be.is + 1;
+    const int64_t n2 = be.je - be.js + 1;
+    const int64_t n3 = be.ke - be.ks + 1;
+    const int64_t ntot = nb * n3 * n2 * n1;
+    auto policy = Kokkos::RangePolicy<DevExecSpace, Kokkos::IndexType<int64_t>>(DevExecSpace(), 0, ntot);
+
+    int n = 0;
+    Kokkos::parallel_reduce("count_" + flag_name, policy,
+        KOKKOS_LAMBDA (const int64_t &idx, int &local_n) {
+            const int b = idx / (n3 * n2 * n1);
+            const int k = be.ks + (idx / (n2 * n1)) % n3;
+            const int j = be.js + (idx / n1) % n2;
+            const int i = be.is + idx % n1;
+            if (i >= ranges(6*b + 0) && i <= ranges(6*b + 1) &&
+                j >= ranges(6*b + 2) && j <= ranges(6*b + 3) &&
+                k >= ranges(6*b + 4) && k <= ranges(6*b + 5) &&
+                is_failed(flag(b, 0, k, j, i)))
+                ++local_n;
+        }
+    , n);
+    list.n = n;
+    if (n == 0) return list;
+
+    list.zones = ParArray1D<int>("zone_list", 4*n);
+    const auto zones = list.zones;
+    Kokkos::parallel_scan("list_" + flag_name, policy,
+        KOKKOS_LAMBDA (const int64_t &idx, int &offset, const bool &final) {
+            const int b = idx / (n3 * n2 * n1);
+            const int k = be.ks + (idx / (n2 * n1)) % n3;
+            const int j = be.js + (idx / n1) % n2;
+            const int i = be.is + idx % n1;
+            if (i >= ranges(6*b + 0) && i <= ranges(6*b + 1) &&
+                j >= ranges(6*b + 2) && j <= ranges(6*b + 3) &&
+                k >= ranges(6*b + 4) && k <= ranges(6*b + 5) &&
+                is_failed(flag(b, 0, k, j, i))) {
+                if (final) {
+                    zones(4*offset + 0) = b;
+                    zones(4*offset + 1) = k;
+                    zones(4*offset + 2) = j;
+                    zones(4*offset + 3) = i;
+                }
+                ++offset;
+            }
+        }
+    );
+
+    return list;
+}
+
+/**
+ * Get the range a ZoneList searched in block b, device-side
+ */
+KOKKOS_INLINE_FUNCTION IndexRange3 ListedRange(const ParArray1D<int>& ranges, const int& b)
+{
+    return IndexRange3{ranges(6*b + 0), ranges(6*b + 1), ranges(6*b + 2),
+                       ranges(6*b + 3), ranges(6*b + 4), ranges(6*b + 5)};
+}
+
 }
@@ -32,6 +32,7 @@
  *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "kharma_driver.hpp"
+#include "polar_filter.hpp"
 
 #include "decs.hpp"
 
@@ -73,8 +74,12 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
     const bool use_implicit = pkgs.count("Implicit");
     const bool use_jcon = pkgs.count("Current");
     const bool use_linesearch = (use_implicit) ? pkgs.at("Implicit")->Param<bool>("linesearch") : false;
-    const bool emhd_enabled = pkgs.count("EMHD");
-    const bool use_ideal_guess = (emhd_enabled) ? pkgs.at("GRMHD")->Param<bool>("ideal_guess") : false;
+    // Any implicit run may start its solve from the explicit ideal MHD update
+    const bool use_ideal_guess = (use_implicit) ? pkgs.at("GRMHD")->Param<bool>("ideal_guess") : false;
+    // Zones inside Globals "reduced_work_r" skip the solve.  If the whole grid doesn't get the ideal update
+    // as a guess, they're given it separately
+    const bool use_reduced_update = use_implicit && !use_ideal_guess &&
+                                    pkgs.at("Globals")->Param<Real>("reduced_work_r") > 0.;
 
     // Allocate/copy the things we need
     // TODO these can now be reduced by including the var lists/flags which actually need to be allocated
@@ -194,8 +199,11 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
         // Add any source terms: geometric \Gamma * T, wind, damping, etc etc
         auto t_sources = tl.AddTask(t_flux_div, Packages::AddSource, md_sub_step_init.get(), md_flux_src.get(), IndexDomain::interior);
 
+        // Optionally damp unresolved azimuthal modes near the poles, see polar_filter.hpp
+        auto t_filter = tl.AddTask(t_sources, PolarFilter::Apply, md_sub_step_init.get(), md_flux_src.get());
+
         // Update explicit state with the explicit fluxes/sources
-        auto t_update = KHARMADriver::AddStateUpdate(t_sources, tl, md_full_step_init.get(), md_sub_step_init.get(),
+        auto t_update = KHARMADriver::AddStateUpdate(t_filter, tl, md_full_step_init.get(), md_sub_step_init.get(),
                                                      md_flux_src.get(), md_solver.get(),
                                                      std::vector<MetadataFlag>{Metadata::GetUserFlag("Explicit"), Metadata::Independent},
                                                      use_b_ct, stage);
@@ -205,7 +213,7 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
         // An additional `AddStateUpdate` task just for variables marked with the `IdealGuess` flag
         auto t_ideal_guess = t_update;
         if (use_ideal_guess) {
-            t_ideal_guess = KHARMADriver::AddStateUpdateIdealGuess(t_sources,  tl, md_full_step_init.get(), md_sub_step_init.get(),
+            t_ideal_guess = KHARMADriver::AddStateUpdateIdealGuess(t_filter,  tl, md_full_step_init.get(), md_sub_step_init.get(),
                                                      md_flux_src.get(), md_solver.get(),
                                                      std::vector<MetadataFlag>{Metadata::GetUserFlag("IdealGuess"), Metadata::Independent},
                                                      false, stage);
@@ -238,6 +246,11 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
             }
 
             auto t_guess_ready = t_explicit | t_copy_guess;
+            if (use_reduced_update) {
+                t_guess_ready = tl.AddTask(t_guess_ready, Implicit::ReducedWorkUpdate, md_full_step_init.get(), md_sub_step_init.get(),
+                                           md_flux_src.get(), md_solver.get(), integrator->gam0[stage-1], integrator->gam1[stage-1],
+                                           integrator->beta[stage-1] * integrator->dt);
+            }
 
             // The `solver` MeshData object now has the implicit primitives corresponding to initial/half step and
             // explicit variables have been updated to match the current step.
@@ -38,7 +38,10 @@
 #include "boundaries.hpp"
 #include "flux.hpp"
 #include "get_flux.hpp"
+#include "halo_exchange.hpp"
 #include "inverter.hpp"
+#include "polar_filter.hpp"
+#include "reblock.hpp"
 
 std::shared_ptr<KHARMAPackage> KHARMADriver::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
 {
@@ -77,6 +80,9 @@ std::shared_ptr<KHARMAPackage> KHARMADriver::Initialize(ParameterInput *pin, std
     bool two_sync = pin->GetOrAddBoolean("driver", "two_sync", true);
     params.Add("two_sync", two_sync);
 
+    // Optionally filter high azimuthal modes near the poles, to take longer steps
+    PolarFilter::Initialize(pin, params);
+
     // When using the Implicit package we need to globally distinguish implicit & explicit vars
     // All independent variables should be marked one or the other,
     // so we define the flags here to avoid loading order issues
@@ -147,10 +153,18 @@ TaskID KHARMADriver::AddBoundarySync(const TaskID t_start, TaskList &tl, std::sh
 
     // The Parthenon exchange tasks include applying physical boundary conditions now.
     // We generally do not take advantage of this yet, but good to know when reasoning about initialization.
-    Flag("ParthenonAddSync");
-    auto t_sync_done = parthenon::AddBoundaryExchangeTasks(t_start_sync, tl, mc1, multilevel);
+    TaskID t_sync_done;
+    if (HaloExchange::Handles(mc1.get())) {
+        // Our persistent exchange, see halo_exchange.hpp.  Physical bounds as Parthenon would apply them
+        auto t_halo_start = tl.AddTask(t_start_sync, HaloExchange::Start, mc1.get());
+        auto t_halo_finish = tl.AddTask(t_halo_start, HaloExchange::Finish, mc1.get());
+        t_sync_done = tl.AddTask(t_halo_finish, parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD, mc1, false);
+    } else {
+        Flag("ParthenonAddSync");
+        t_sync_done = parthenon::AddBoundaryExchangeTasks(t_start_sync, tl, mc1, multilevel);
+        EndFlag();
+    }
     auto t_bounds = t_sync_done;
-    EndFlag();
 
     // We always just sync'd the "conserved" magnetic field
     // Translate back to "primitive" (& cell-centered) field if that's what we'll be using
@@ -211,6 +225,9 @@ TaskID KHARMADriver::AddFluxCalculations(TaskID& t_start, TaskList& tl, MeshData
     auto t_start_fluxes = t_start;
     if (md->GetMeshPointer()->packages.AllPackages().count("B_CT"))
         t_start_fluxes = tl.AddTask(t_start, B_CT::MeshUtoP, md, IndexDomain::entire, false);
+    // Fourth-order fluxes reconstruct from cell averages of the primitives
+    if (pkgs.at("Flux")->Param<bool>("fourth_order"))
+        t_start_fluxes = tl.AddTask(t_start_fluxes, Flux::PrimsToAverage, md);
 
     // Calculate fluxes in each direction using given reconstruction
     // Must be spelled out so as to generate each templated version of GetFlux<> to be available at runtime
@@ -254,6 +271,21 @@ TaskID KHARMADriver::AddFluxCalculations(TaskID& t_start, TaskList& tl, MeshData
         t_calculate_flux2 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5, X2DIR>, md);
         t_calculate_flux3 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5, X3DIR>, md);
         break;
+    case RType::weno5_hybrid:
+        t_calculate_flux1 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid, X1DIR>, md);
+        t_calculate_flux2 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid, X2DIR>, md);
+        t_calculate_flux3 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid, X3DIR>, md);
+        break;
+    case RType::weno5_hybrid_lower_edges:
+        t_calculate_flux1 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid_lower_edges, X1DIR>, md);
+        t_calculate_flux2 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid_lower_edges, X2DIR>, md);
+        t_calculate_flux3 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid_lower_edges, X3DIR>, md);
+        break;
+    case RType::weno5_hybrid_lower_poles:
+        t_calculate_flux1 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid_lower_poles, X1DIR>, md);
+        t_calculate_flux2 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid_lower_poles, X2DIR>, md);
+        t_calculate_flux3 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_hybrid_lower_poles, X3DIR>, md);
+        break;
     case RType::weno5_linear:
         t_calculate_flux1 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_linear, X1DIR>, md);
         t_calculate_flux2 = tl.AddTask(t_start_fluxes, Flux::GetFlux<RType::weno5_linear, X2DIR>, md);
@@ -345,7 +377,7 @@ TaskID KHARMADriver::AddStateUpdate(TaskID& t_start, TaskList& tl, MeshData<Real
     std::vector<MetadataFlag> flags_cell = flags; flags_cell.push_back(Metadata::Cell);
     std::vector<MetadataFlag> flags_face = flags; flags_face.push_back(Metadata::Face);
     // TODO splitting this is stupid, but maybe the parallelization actually helps? Eh.
-    auto t_avg_data_c = tl.AddTask(t_start, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
+    auto t_avg_data_c = tl.AddTask(t_start, WeightedSumData<MetadataFlag>,
                                 std::vector<MetadataFlag>(flags_cell),
                                 md_sub_step_init, md_full_step_init,
                                 integrator->gam0[stage-1], integrator->gam1[stage-1],
@@ -359,7 +391,7 @@ TaskID KHARMADriver::AddStateUpdate(TaskID& t_start, TaskList& tl, MeshData<Real
                                 md_update);
     }
     // apply du/dt to the result
-    auto t_update_c = tl.AddTask(t_avg_data, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
+    auto t_update_c = tl.AddTask(t_avg_data, WeightedSumData<MetadataFlag>,
                                 std::vector<MetadataFlag>(flags_cell),
                                 md_update, md_flux_src,
                                 1.0, integrator->beta[stage-1] * integrator->dt,
@@ -395,7 +427,7 @@ TaskID KHARMADriver::AddStateUpdateIdealGuess(TaskID& t_start, TaskList& tl, Mes
     std::vector<MetadataFlag> flags_cell = flags; flags_cell.push_back(Metadata::Cell);
     std::vector<MetadataFlag> flags_face = flags; flags_face.push_back(Metadata::Face);
     // TODO splitting this is stupid, but maybe the parallelization actually helps? Eh.
-    auto t_avg_data_c = tl.AddTask(t_start, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
+    auto t_avg_data_c = tl.AddTask(t_start, WeightedSumData<MetadataFlag>,
                                 std::vector<MetadataFlag>(flags_cell),
                                 md_sub_step_init, md_full_step_init,
                                 integrator->gam0[stage-1], integrator->gam1[stage-1],
@@ -409,7 +441,7 @@ TaskID KHARMADriver::AddStateUpdateIdealGuess(TaskID& t_start, TaskList& tl, Mes
                                 md_update);
     }
     // apply du/dt to the result
-    auto t_update_c = tl.AddTask(t_avg_data, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
+    auto t_update_c = tl.AddTask(t_avg_data, WeightedSumData<MetadataFlag>,
                                 std::vector<MetadataFlag>(flags_cell),
                                 md_update, md_flux_src,
                                 1.0, integrator->beta[stage-1] * integrator->dt,
@@ -461,6 +493,14 @@ void KHARMADriver::SetGlobalTimeStep()
 
 void KHARMADriver::PostExecute(DriverStatus status)
 {
+    if (Reblock::Pending()) {
+        // We're not done, just stopping to re-block: the next driver picks up from here
+        pinput->SetReal("parthenon/time", "start_time", tm.time);
+        pinput->SetInteger("parthenon/time", "ncycle", tm.ncycle);
+        pinput->SetReal("parthenon/time", "dt", tm.dt);
+        pinput->SetBoolean("parthenon/time", "start_dt_light", false);
+        return;
+    }
     Packages::PostExecute(pmesh, pinput, tm);
     EvolutionDriver::PostExecute(status);
 }
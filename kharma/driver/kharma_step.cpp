@@ -32,6 +32,7 @@
  *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "kharma_driver.hpp"
+#include "polar_filter.hpp"
 
 // TODO CLEAN
 //Packages
@@ -48,6 +49,7 @@
 #include "flux.hpp"
 #include "kharma.hpp"
 #include "implicit.hpp"
+#include "reblock.hpp"
 #include "resize_restart.hpp"
 
 #include <parthenon/parthenon.hpp>
@@ -58,6 +60,9 @@ TaskCollection KHARMADriver::MakeTaskCollection(BlockList_t &blocks, int stage)
 {
     DriverType driver_type = blocks[0]->packages.Get("Driver")->Param<DriverType>("type");
     Flag("MakeTaskCollection");
+    // Make this the last step if we're asked to re-block, see reblock.hpp
+    if (stage == 1 && Reblock::CheckTrigger(tm.ncycle))
+        tm.nlim = tm.ncycle + 1;
     TaskCollection tc;
     switch (driver_type) {
     case DriverType::kharma:
@@ -201,7 +206,10 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
         // Also where CT sets the change in face fields
         auto t_sources = tl.AddTask(t_flux_div, Packages::AddSource, md_sub_step_init.get(), md_flux_src.get(), IndexDomain::interior);
 
-        auto t_update = KHARMADriver::AddStateUpdate(t_sources, tl, md_full_step_init.get(), md_sub_step_init.get(),
+        // Optionally damp unresolved azimuthal modes near the poles, see polar_filter.hpp
+        auto t_filter = tl.AddTask(t_sources, PolarFilter::Apply, md_sub_step_init.get(), md_flux_src.get());
+
+        auto t_update = KHARMADriver::AddStateUpdate(t_filter, tl, md_full_step_init.get(), md_sub_step_init.get(),
                                                   md_flux_src.get(), md_sub_step_final.get(),
                                                   std::vector<MetadataFlag>{Metadata::GetUserFlag("Explicit"), Metadata::Independent},
                                                   use_b_ct, stage);
@@ -0,0 +1,249 @@
+/*
+ *  File: polar_filter.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "polar_filter.hpp"
+
+#include "domain.hpp"
+
+namespace {
+
+/**
+ * Remove modes above m_keep from a ring of n3 values held in team scratch, in place.
+ * 'a' and 'c' are scratch for the cosine & sine coefficients
+ */
+KOKKOS_INLINE_FUNCTION void FilterRing(parthenon::team_mbr_t& member, ScratchPad1D<Real>& ring,
+                                       ScratchPad1D<Real>& a, ScratchPad1D<Real>& c,
+                                       const int& n3, const int& m_keep)
+{
+    const int nmodes = n3 / 2 + 1;
+    // Coefficients of only the modes we remove
+    parthenon::par_for_inner(member, m_keep + 1, nmodes - 1,
+        [&](const int& mode) {
+            Real am = 0., cm = 0.;
+            for (int k = 0; k < n3; ++k) {
+                const Real phase = 2. * M_PI * mode * k / n3;
+                am += ring(k) * m::cos(phase);
+                cm += ring(k) * m::sin(phase);
+            }
+            // The Nyquist mode of an even ring is counted once
+            const Real norm = (2 * mode == n3) ? 1. / n3 : 2. / n3;
+            a(mode) = am * norm;
+            c(mode) = cm * norm;
+        }
+    );
+    member.team_barrier();
+    parthenon::par_for_inner(member, 0, n3 - 1,
+        [&](const int& k) {
+            Real high = 0.;
+            for (int mode = m_keep + 1; mode < nmodes; ++mode) {
+                const Real phase = 2. * M_PI * mode * k / n3;
+                high += a(mode) * m::cos(phase) + c(mode) * m::sin(phase);
+            }
+            ring(k) -= high;
+        }
+    );
+    member.team_barrier();
+}
+
+/**
+ * Filter every variable in the pack 'dUdt' except indices skip_s through skip_e
+ */
+template<typename PackType>
+void FilterRings(MeshData<Real> *md, PackType& dUdt, const Real sin_filter, const int skip_s, const int skip_e)
+{
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::interior);
+    const IndexRange block = IndexRange{0, dUdt.GetDim(5) - 1};
+    const int nvar = dUdt.GetDim(4);
+    const int n3 = b.ke - b.ks + 1;
+    const int nmodes = n3 / 2 + 1;
+    if (nvar == 0) return;
+
+    const int scratch_level = 1;
+    const size_t scratch_bytes = parthenon::ScratchPad1D<Real>::shmem_size(n3) +
+                                 2 * parthenon::ScratchPad1D<Real>::shmem_size(nmodes);
+    parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "polar_filter", pmb0->exec_space,
+        scratch_bytes, scratch_level, block.s, block.e, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& bl, const int& j, const int& i) {
+            const auto& G = dUdt.GetCoords(bl);
+            // Most rings are outside the filter.  This is uniform over the team
+            const int m_keep = PolarFilter::KeptModes(G.th(b.ks, j, i), sin_filter, n3);
+            if (m_keep < 0) return;
+
+            ScratchPad1D<Real> ring(member.team_scratch(scratch_level), n3);
+            ScratchPad1D<Real> a(member.team_scratch(scratch_level), nmodes);
+            ScratchPad1D<Real> c(member.team_scratch(scratch_level), nmodes);
+            for (int v = 0; v < nvar; ++v) {
+                if (v >= skip_s && v <= skip_e) continue;
+                parthenon::par_for_inner(member, 0, n3 - 1,
+                    [&](const int& k) {
+                        ring(k) = dUdt(bl, v, b.ks + k, j, i);
+                    }
+                );
+                member.team_barrier();
+                FilterRing(member, ring, a, c, n3, m_keep);
+                parthenon::par_for_inner(member, 0, n3 - 1,
+                    [&](const int& k) {
+                        dUdt(bl, v, b.ks + k, j, i) = ring(k);
+                    }
+                );
+                member.team_barrier();
+            }
+        }
+    );
+}
+
+/**
+ * Component 'e' of an EMF: B_CT keeps these as an edge field, B_FluxCT as a cell-centered vector
+ * with the same (edge) locations
+ */
+template<bool EDGE, typename PackType>
+KOKKOS_FORCEINLINE_FUNCTION Real& EMFElement(const PackType& emf, const int& bl, const int& e,
+                                             const int& k, const int& j, const int& i)
+{
+    if constexpr (EDGE) {
+        return emf(bl, (e == V1) ? E1 : ((e == V2) ? E2 : E3), 0, k, j, i);
+    } else {
+        return emf(bl, e, k, j, i);
+    }
+}
+
+template<bool EDGE>
+void FilterEMFRings(MeshData<Real> *md, const std::string& name, const Real sin_filter)
+{
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    const auto& emf = md->PackVariables(std::vector<std::string>{name});
+    // Edges run one past the last zone in each direction
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::interior, 0, 1);
+    const IndexRange block = IndexRange{0, emf.GetDim(5) - 1};
+    // Each ring has one edge per zone: the last X3 face is the first one, again
+    const int n3 = b.ke - b.ks;
+    const int nmodes = n3 / 2 + 1;
+
+    const int scratch_level = 1;
+    const size_t scratch_bytes = parthenon::ScratchPad1D<Real>::shmem_size(n3) +
+                                 2 * parthenon::ScratchPad1D<Real>::shmem_size(nmodes);
+    parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "polar_filter_emf", pmb0->exec_space,
+        scratch_bytes, scratch_level, block.s, block.e, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& bl, const int& j, const int& i) {
+            const auto& G = emf.GetCoords(bl);
+            ScratchPad1D<Real> ring(member.team_scratch(scratch_level), n3);
+            ScratchPad1D<Real> a(member.team_scratch(scratch_level), nmodes);
+            ScratchPad1D<Real> c(member.team_scratch(scratch_level), nmodes);
+            for (int e = V1; e <= V3; ++e) {
+                // E1 & E3 lie on X2 faces, E2 at X2 centers.  E1 & E2 lie on X3 faces
+                const int m_keep = PolarFilter::KeptModes(G.th(b.ks, j, i, (e == V2) ? Loci::center : Loci::face2), sin_filter, n3);
+                if (m_keep < 0) continue;
+                const bool on_k_face = (e != V3);
+
+                parthenon::par_for_inner(member, 0, n3 - 1,
+                    [&](const int& k) {
+                        ring(k) = EMFElement<EDGE>(emf, bl, e, b.ks + k, j, i);
+                    }
+                );
+                member.team_barrier();
+                FilterRing(member, ring, a, c, n3, m_keep);
+                parthenon::par_for_inner(member, 0, n3 - 1,
+                    [&](const int& k) {
+                        EMFElement<EDGE>(emf, bl, e, b.ks + k, j, i) = ring(k);
+                        if (on_k_face && k == 0) EMFElement<EDGE>(emf, bl, e, b.ks + n3, j, i) = ring(k);
+                    }
+                );
+                member.team_barrier();
+            }
+        }
+    );
+}
+
+} // namespace
+
+void PolarFilter::Initialize(ParameterInput *pin, Params &params)
+{
+    const bool on = pin->GetOrAddBoolean("polar_filter", "on", false);
+    params.Add("polar_filter", on);
+    if (!on) {
+        params.Add("polar_filter_sin", 0.);
+        return;
+    }
+    // Degrees from either pole
+    const Real angle = pin->GetOrAddReal("polar_filter", "angle", 15.);
+    if (angle <= 0. || angle >= 90.)
+        throw std::invalid_argument("polar_filter/angle must be between 0 and 90 degrees!");
+    params.Add("polar_filter_sin", m::sin(angle * M_PI / 180.));
+
+    if (!pin->GetBoolean("coordinates", "spherical") || pin->GetInteger("parthenon/mesh", "nx3") < 2)
+        throw std::invalid_argument("Polar filter requires 3D spherical coordinates!");
+    // Meshblock sizes default to the mesh size
+    if (pin->GetOrAddInteger("parthenon/meshblock", "nx3", pin->GetInteger("parthenon/mesh", "nx3")) !=
+        pin->GetInteger("parthenon/mesh", "nx3"))
+        throw std::invalid_argument("Polar filter requires meshblocks spanning all of X3!  Try placement/policy=spherical.");
+    // B is filtered through its EMFs, which constraint damping doesn't have
+    const std::string b_solver = pin->DoesParameterExist("b_field", "solver") ? pin->GetString("b_field", "solver") : "";
+    if (b_solver == "constraint_damping" || b_solver == "cd")
+        throw std::invalid_argument("Polar filter requires a CT magnetic field transport, face_ct or flux_ct!");
+}
+
+TaskStatus PolarFilter::Apply(MeshData<Real> *md, MeshData<Real> *mdudt)
+{
+    auto pmesh = md->GetMeshPointer();
+    const auto& pars = pmesh->packages.Get("Driver")->AllParams();
+    if (!pars.Get<bool>("polar_filter")) return TaskStatus::complete;
+
+    Flag("PolarFilter");
+    const Real sin_filter = pars.Get<Real>("polar_filter_sin");
+    // Everything the timestep relaxation applies to: fluid, electrons, EMHD, floor trackers...
+    // B_FluxCT's cell-centered B is updated by the (already filtered) EMFs instead
+    PackIndexMap cons_map;
+    auto dUdt = mdudt->PackVariables(std::vector<MetadataFlag>{Metadata::Conserved, Metadata::Cell}, cons_map);
+    const int B1 = cons_map["cons.B"].first;
+    FilterRings(md, dUdt, sin_filter, B1, (B1 >= 0) ? B1 + NVEC - 1 : -1);
+    EndFlag();
+
+    return TaskStatus::complete;
+}
+
+void PolarFilter::FilterEMF(MeshData<Real> *md, const std::string& name, bool edge)
+{
+    const auto& pars = md->GetMeshPointer()->packages.Get("Driver")->AllParams();
+    if (!pars.Get<bool>("polar_filter")) return;
+
+    Flag("PolarFilterEMF");
+    const Real sin_filter = pars.Get<Real>("polar_filter_sin");
+    if (edge) {
+        FilterEMFRings<true>(md, name, sin_filter);
+    } else {
+        FilterEMFRings<false>(md, name, sin_filter);
+    }
+    EndFlag();
+}
@@ -0,0 +1,92 @@
+/*
+ *  File: polar_filter.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * Polar Fourier filter for full-sphere 3D runs, enabled with polar_filter/on=true.
+ *
+ * Near the poles, the X3 zone width shrinks as sin(theta), and sets the timestep for the whole grid.
+ * Within polar_filter/angle degrees of either pole, we instead remove azimuthal modes which the
+ * ring could not resolve at the filter edge: rings keep only modes m <= (N3/2) sin(theta)/sin(angle).
+ * The filter is applied to the change in every cell-centered conserved variable except B each stage, and
+ * GRMHD::EstimateTimestep then treats these rings as if they had the X3 resolution at the filter edge.
+ *
+ * The magnetic field is filtered through its EMFs instead, by B_CT and B_FluxCT: since the update to B
+ * is still the curl of the (filtered) EMFs, divB is unchanged.  Each ring is transformed directly,
+ * with one team per ring, so every meshblock must span the full X3 range.
+ */
+namespace PolarFilter {
+
+/**
+ * Read & check options.  Called from the Driver package
+ */
+void Initialize(ParameterInput *pin, Params &params);
+
+/**
+ * Filter the stage update 'mdudt' of all cell-centered conserved variables other than B
+ */
+TaskStatus Apply(MeshData<Real> *md, MeshData<Real> *mdudt);
+
+/**
+ * Filter the X3 rings of the edge-centered EMFs 'name', in place.  'edge' should be true for
+ * an edge field (B_CT), false for edge values stored as a cell-centered vector (B_FluxCT)
+ */
+void FilterEMF(MeshData<Real> *md, const std::string& name, bool edge);
+
+/**
+ * Highest azimuthal mode kept by a ring of 'n3' zones at colatitude 'th', or -1 if it is outside the filter.
+ * Always at least 1, so the mean and lowest mode survive even right at the pole.
+ */
+KOKKOS_INLINE_FUNCTION int KeptModes(const GReal& th, const Real& sin_filter, const int& n3)
+{
+    const Real sin_th = m::abs(m::sin(th));
+    if (sin_filter <= 0. || sin_th >= sin_filter) return -1;
+    const int m_keep = m::max(static_cast<int>((n3 / 2) * sin_th / sin_filter), 1);
+    return (m_keep >= n3 / 2) ? -1 : m_keep;
+}
+
+/**
+ * Factor by which the filter lengthens the effective X3 zone width, in a ring of 'n3' zones
+ * at colatitude 'th'.  1 outside the filtered region.
+ */
+KOKKOS_INLINE_FUNCTION Real WidthFactor(const GReal& th, const Real& sin_filter, const int& n3)
+{
+    const int m_keep = KeptModes(th, sin_filter, n3);
+    return (m_keep > 0) ? static_cast<Real>(n3 / 2) / m_keep : 1.;
+}
+
+}
@@ -32,6 +32,7 @@
  *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include "kharma_driver.hpp"
+#include "polar_filter.hpp"
 
 #include "inverter.hpp"
 #include "flux.hpp"
@@ -96,15 +97,18 @@ TaskCollection KHARMADriver::MakeSimpleTaskCollection(BlockList_t &blocks, int s
         // Add any source terms: geometric \Gamma * T, wind, damping, etc etc
         auto t_sources = tl.AddTask(t_flux_div, Packages::AddSource, md_sub_step_init.get(), md_flux_src.get(), IndexDomain::interior);
 
+        // Optionally damp unresolved azimuthal modes near the poles, see polar_filter.hpp
+        auto t_filter = tl.AddTask(t_sources, PolarFilter::Apply, md_sub_step_init.get(), md_flux_src.get());
+
         // Perform the update using the source term
         // Add any proportion of the step start required by the integrator (e.g., RK2)
-        auto t_avg_data = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
+        auto t_avg_data = tl.AddTask(t_sources, WeightedSumData<MetadataFlag>,
                                     std::vector<MetadataFlag>({Metadata::Independent}),
                                     md_sub_step_init.get(), md_full_step_init.get(),
                                     integrator->gam0[stage-1], integrator->gam1[stage-1],
                                     md_sub_step_final.get());
         // apply du/dt to the result
-        auto t_update = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
+        auto t_update = tl.AddTask(t_filter, WeightedSumData<MetadataFlag>,
                                     std::vector<MetadataFlag>({Metadata::Independent}),
                                     md_sub_step_final.get(), md_flux_src.get(),
                                     1.0, integrator->beta[stage-1] * integrator->dt,
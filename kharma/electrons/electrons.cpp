@@ -35,11 +35,13 @@
 
 #include "decs.hpp"
 #include "domain.hpp"
+#include "fast_math.hpp"
 #include "kharma_driver.hpp"
 #include "flux.hpp"
 #include "grmhd.hpp"
 #include "kharma.hpp"
 #include "gaussian.hpp"
+#include "transients.hpp"
 
 #include <parthenon/parthenon.hpp>
 #include <utils/string_utils.hpp>
@@ -144,8 +146,9 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
         std::vector<int> s_vector({2});
         Metadata m_vector = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy}, s_vector);
         Metadata m = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
-        pkg->AddField("grf_normalized", m_vector);
-        pkg->AddField("alfven_speed", m);
+        // Both are filled & used within each kick, and kept only if requested for analysis
+        Transients::AddField(pkg, pin, "grf_normalized", m_vector, Transients::Phase::heating, Transients::Phase::heating);
+        Transients::AddField(pkg, pin, "alfven_speed", m, Transients::Phase::heating, Transients::Phase::heating);
     }
 
     // Individual models
@@ -192,8 +195,9 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
         std::vector<int> s_vector({2});
         Metadata m_vector = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy}, s_vector);
         Metadata m = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
-        pkg->AddField("grf_normalized", m_vector);
-        pkg->AddField("alfven_speed", m);
+        // Both are filled & used within each kick, and kept only if requested for analysis
+        Transients::AddField(pkg, pin, "grf_normalized", m_vector, Transients::Phase::heating, Transients::Phase::heating);
+        Transients::AddField(pkg, pin, "alfven_speed", m, Transients::Phase::heating, Transients::Phase::heating);
     }
 
     pkg->BlockUtoP = Electrons::BlockUtoP;
@@ -312,6 +316,7 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
     const Real tptemax = pmb->packages.Get("Electrons")->Param<Real>("tp_over_te_max");
     const bool enforce_positive_diss = pmb->packages.Get("Electrons")->Param<bool>("enforce_positive_dissipation");
     const bool limit_kel = pmb->packages.Get("Electrons")->Param<bool>("limit_kel");
+    const Real r_reduced = pmb->packages.Get("Globals")->Param<Real>("reduced_work_r");
 
     // This function (and any primitive-variable sources) needs to be run over the entire domain,
     // because the boundary zones have already been updated and so the same calculations must be applied
@@ -322,15 +327,21 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
     const IndexRange kb = rc->GetBoundsK(IndexDomain::entire);
     pmb->par_for("heat_electrons", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
         KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
+            // Calculate the new total entropy in this cell considering heating
+            const Real k_energy_conserving = (gam-1.) * P_new(m_p.UU, k, j, i) / fm::pow(P_new(m_p.RHO, k, j, i), gam);
+
+            // Deep inside the EH, just advect the electron entropies, see Globals "reduced_work_r"
+            if (G.r(k, j, i) < r_reduced) {
+                P_new(m_p.KTOT, k, j, i) = k_energy_conserving;
+                return;
+            }
+
             FourVectors Dtmp;
             GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
             Real bsq = dot(Dtmp.bcon, Dtmp.bcov);
 
-            // Calculate the new total entropy in this cell considering heating
-            const Real k_energy_conserving = (gam-1.) * P_new(m_p.UU, k, j, i) / m::pow(P_new(m_p.RHO, k, j, i), gam);
-
             // Dissipation is the real entropy k_energy_conserving minus any advected entropy from the previous (sub-)step P_new(KTOT)
-            Real diss_tmp = (game-1.) / (gam-1.) * m::pow(P(m_p.RHO, k, j, i), gam - game) * (k_energy_conserving - P_new(m_p.KTOT, k, j, i));
+            Real diss_tmp = (game-1.) / (gam-1.) * fm::pow(P(m_p.RHO, k, j, i), gam - game) * (k_energy_conserving - P_new(m_p.KTOT, k, j, i));
             //this is eq27                  ratio of heating: Qi/Qe                           advected entropy from prev step
             // ^ denotes the solution corresponding to entropy conservation
 
@@ -347,9 +358,9 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
             // We'll be applying floors inline as we heat electrons, so
             // we cache the floors as entropy limits so they'll be cheaper to apply.
             // Note tp_te_min -> kel_max & vice versa
-            const Real kel_max = P(m_p.KTOT, k, j, i) * m::pow(P(m_p.RHO, k, j, i), gam - game) /
+            const Real kel_max = P(m_p.KTOT, k, j, i) * fm::pow(P(m_p.RHO, k, j, i), gam - game) /
                                     (tptemin * (gam - 1.) / (gamp-1.) + (gam-1.) / (game-1.)); //0.001
-            const Real kel_min = P(m_p.KTOT, k, j, i) * m::pow(P(m_p.RHO, k, j, i), gam - game) /
+            const Real kel_min = P(m_p.KTOT, k, j, i) * fm::pow(P(m_p.RHO, k, j, i), gam - game) /
                                     (tptemax * (gam - 1.) / (gamp-1.) + (gam-1.) / (game-1.)); //1000
             // Note this differs a little from Ressler '15, who ensure u_e/u_g > 0.01 rather than use temperatures
 
@@ -374,32 +385,32 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
                 }
             }
             if (m_p.K_HOWES >= 0) {
-                const Real Tel = m::max(P(m_p.K_HOWES, k, j, i) * m::pow(P(m_p.RHO, k, j, i), game-1), SMALL);
+                const Real Tel = m::max(P(m_p.K_HOWES, k, j, i) * fm::pow(P(m_p.RHO, k, j, i), game-1), SMALL);
 
                 const Real Trat = Tpr / Tel;
                 const Real pres = P(m_p.RHO, k, j, i) * Tpr; // Proton pressure
                 const Real beta = m::min(pres / bsq * 2, 1.e20);// If somebody enables electrons in a GRHD sim
 
-                const Real logTrat = log10(Trat);
+                const Real logTrat = fm::log10(Trat);
                 const Real mbeta = 2. - 0.2*logTrat;
 
                 const Real c2 = (Trat <= 1.) ? 1.6/Trat : 1.2/Trat;
                 const Real c3 = (Trat <= 1.) ? 18. + 5.*logTrat : 18.;
 
-                const Real beta_pow = m::pow(beta, mbeta);
-                const Real qrat = 0.92 * (c2*c2 + beta_pow)/(c3*c3 + beta_pow) * m::exp(-1./beta) * m::sqrt(MP/ME * Trat);
+                const Real beta_pow = fm::pow(beta, mbeta);
+                const Real qrat = 0.92 * (c2*c2 + beta_pow)/(c3*c3 + beta_pow) * fm::exp(-1./beta) * m::sqrt(MP/ME * Trat);
                 const Real fel = 1./(1. + qrat);
                 P_new(m_p.K_HOWES, k, j, i) = clip(P_new(m_p.K_HOWES, k, j, i) + fel * diss, kel_min, kel_max);
             }
             if (m_p.K_KAWAZURA >= 0) {
                 // Equation (2) in http://www.pnas.org/lookup/doi/10.1073/pnas.1812491116
-                const Real Tel = m::max(P(m_p.K_KAWAZURA, k, j, i) * m::pow(P(m_p.RHO, k, j, i), game-1), SMALL);
+                const Real Tel = m::max(P(m_p.K_KAWAZURA, k, j, i) * fm::pow(P(m_p.RHO, k, j, i), game-1), SMALL);
 
                 const Real Trat = Tpr / Tel;
                 const Real pres = P(m_p.RHO, k, j, i) * Tpr; // Proton pressure
                 const Real beta = m::min(pres / bsq * 2, 1.e20);// If somebody enables electrons in a GRHD sim
 
-                const Real QiQe = 35. / (1. + m::pow(beta/15., -1.4) * m::exp(-0.1 / Trat));
+                const Real QiQe = 35. / (1. + fm::pow(beta/15., -1.4) * fm::exp(-0.1 / Trat));
                 const Real fel = 1./(1. + QiQe);
                 P_new(m_p.K_KAWAZURA, k, j, i) = clip(P_new(m_p.K_KAWAZURA, k, j, i) + fel * diss, kel_min, kel_max);
             }
@@ -417,12 +428,12 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
                 const Real beta = pres / bsq * 2;
                 const Real sigma = bsq / (P(m_p.RHO, k, j, i) + P(m_p.UU, k, j, i) + pg);
                 const Real betamax = 0.25 / sigma;
-                const Real fel = 0.5 * m::exp(-m::pow(1 - beta/betamax, 3.3) / (1 + 1.2*m::pow(sigma, 0.7)));
+                const Real fel = 0.5 * fm::exp(-fm::pow(1 - beta/betamax, 3.3) / (1 + 1.2*fm::pow(sigma, 0.7)));
                 P_new(m_p.K_ROWAN, k, j, i) = clip(P_new(m_p.K_ROWAN, k, j, i) + fel * diss, kel_min, kel_max);
             }
             if (m_p.K_SHARMA >= 0) {
                 // Equation for \delta on  pg. 719 (Section 4) in https://iopscience.iop.org/article/10.1086/520800
-                const Real Tel = m::max(P(m_p.K_SHARMA, k, j, i) * m::pow(P(m_p.RHO, k, j, i), game-1), SMALL);
+                const Real Tel = m::max(P(m_p.K_SHARMA, k, j, i) * fm::pow(P(m_p.RHO, k, j, i), game-1), SMALL);
 
                 const Real Trat_inv = Tel / Tpr; // Inverse of the temperature ratio in KAWAZURA
                 const Real QeQi = 0.33 * m::sqrt(Trat_inv);
@@ -444,7 +455,7 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
         const auto& G = pmb->coords;
         GridScalar rho = rc->Get("prims.rho").data;
         GridVector uvec = rc->Get("prims.uvec").data;
-        GridVector grf_normalized = rc->Get("grf_normalized").data;
+        GridVector grf_normalized = rc->Get(Transients::Name("grf_normalized")).data;
         const Real t = pmb->packages.Get("Globals")->Param<Real>("time");
         Real counter = pmb->packages.Get("GRMHD")->Param<Real>("counter");
         const Real dt_kick=  pmb->packages.Get("GRMHD")->Param<Real>("dt_kick");
@@ -456,7 +467,7 @@ TaskStatus ApplyElectronHeating(MeshBlockData<Real> *rc_old, MeshBlockData<Real>
             const Real lx1=  pmb->packages.Get("GRMHD")->Param<Real>("lx1");
             const Real lx2=  pmb->packages.Get("GRMHD")->Param<Real>("lx2");
             const Real edot= pmb->packages.Get("GRMHD")->Param<Real>("drive_edot");
-            GridScalar alfven_speed = rc->Get("alfven_speed").data;
+            GridScalar alfven_speed = rc->Get(Transients::Name("alfven_speed")).data;
             
             int Nx1 = pmb->cellbounds.ncellsi(IndexDomain::interior);
             int Nx2 = pmb->cellbounds.ncellsj(IndexDomain::interior);
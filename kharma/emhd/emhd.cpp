@@ -149,15 +149,6 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
         pkg->AddField("prims.dP", m_prim);
     }
 
-    // 4vel ucov and temperature Theta are needed as temporaries, but need to be grid-sized anyway.
-    // Allow keeping/saving them.
-    Metadata::AddUserFlag("EMHDTemporary");
-    Metadata m_temp = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy, Metadata::GetUserFlag("EMHDTemporary")});
-    pkg->AddField("Theta", m_temp);
-    std::vector<int> fourv = {GR_DIM};
-    Metadata m_temp_vec = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy, Metadata::GetUserFlag("EMHDTemporary")}, fourv);
-    pkg->AddField("ucov", m_temp_vec);
-
     // This works similarly to the fflag:
     // we register zones where limits on q and dP are hit
     Metadata m = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
@@ -294,6 +285,7 @@ TaskStatus AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain doma
     const auto& gpars = pmb0->packages.Get("GRMHD")->AllParams();
     const Real gam    = gpars.Get<Real>("gamma");
     const int ndim    = pmesh->ndim;
+    const Real r_reduced = pmb0->packages.Get("Globals")->Param<Real>("reduced_work_r");
     // Options: Local
     const auto& pars                   = pmb0->packages.Get("EMHD")->AllParams();
     const EMHD_parameters& emhd_params = pars.Get<EMHD_parameters>("emhd_params");
@@ -305,91 +297,100 @@ TaskStatus AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain doma
     auto dUdt = mdudt->PackVariables(std::vector<MetadataFlag>{Metadata::Conserved}, source_map);
     const VarMap m_p(prims_map, false), m_u(cons_map, true), m_s(source_map, true);
 
-    // Get temporary ucov, Theta for gradients
-    PackIndexMap temps_map;
-    auto Temps = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("EMHDTemporary")}, temps_map);
-    int m_ucov = temps_map["ucov"].first;
-    int m_theta = temps_map["Theta"].first;
-
     // Get ranges
     const IndexRange ib = mdudt->GetBoundsI(domain);
     const IndexRange jb = mdudt->GetBoundsJ(domain);
     const IndexRange kb = mdudt->GetBoundsK(domain);
     const IndexRange block = IndexRange{0, dUdt.GetDim(5) - 1};
-    // 1-zone halo in nontrivial dimensions
+    // 1-zone halo in X1.  Neighboring rows in X2/X3 are cached only where those dimensions are nontrivial
     const IndexRange il = IndexRange{ib.s-1, ib.e+1};
-    const IndexRange jl = (ndim > 1) ? IndexRange{jb.s-1, jb.e+1} : jb;
-    const IndexRange kl = (ndim > 2) ? IndexRange{kb.s-1, kb.e+1} : kb;
+    const int nrows = (ndim > 2) ? NSOURCEROWS : ((ndim > 1) ? row_km : row_jm);
 
-    // Calculate & apply source terms
-    pmb0->par_for("emhd_sources_pre", block.s, block.e, kl.s, kl.e, jl.s, jl.e, il.s, il.e,
-        KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
-            const auto& G    = dUdt.GetCoords(b);
-            // ucon
-            Real ucon[GR_DIM], ucov[GR_DIM];
-            GRMHD::calc_ucon(G, P(b), m_p, k, j, i, Loci::center, ucon);
-            G.lower(ucon, ucov, k, j, i, Loci::center);
-            DLOOP1 Temps(b, m_ucov + mu, k, j, i) = ucov[mu];
-            // theta
-            Temps(b, m_theta, k, j, i) = m::max((gam - 1) * P(b)(m_p.UU, k, j, i) / P(b)(m_p.RHO, k, j, i), SMALL);
-        }
-    );
+    // Cache ucov & Theta for this row and its neighbors, rather than keeping grid-sized temporaries
+    const int n1 = pmb0->cellbounds.ncellsi(IndexDomain::entire);
+    const int scratch_level = 1; // 0 is actual scratch (tiny); 1 is HBM
+    const size_t scratch_bytes = parthenon::ScratchPad3D<Real>::shmem_size(NSOURCEROWS, NTEMPS, n1);
 
     // Calculate & apply source terms
-    pmb0->par_for("emhd_sources", block.s, block.e, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
+    parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "emhd_sources", pmb0->exec_space,
+        scratch_bytes, scratch_level, block.s, block.e, kb.s, kb.e, jb.s, jb.e,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& b, const int& k, const int& j) {
             const auto& G = dUdt.GetCoords(b);
-
-            // Get the EGRMHD parameters
-            Real tau, chi_e, nu_e;
-            EMHD::set_parameters(G, P(b), m_p, emhd_params, gam, k, j, i, tau, chi_e, nu_e);
-
-            // and the 4-vectors
-            FourVectors D;
-            GRMHD::calc_4vecs(G, P(b), m_p, k, j, i, Loci::center, D);
-            const double bsq = m::max(dot(D.bcon, D.bcov), SMALL);
-
-            // Compute gradient of ucov and Theta
-            Real grad_ucov[GR_DIM][GR_DIM], grad_Theta[GR_DIM];
-            // TODO thread the limiter selection through to call
-            EMHD::gradient_calc<KReconstruction::Type::linear_mc>(G, Temps(b), m_ucov, m_theta, b, k, j, i, (ndim > 2), (ndim > 1), grad_ucov, grad_Theta);
-
-            // Compute div of ucon (all terms but the time-derivative ones are nonzero)
-            Real div_ucon    = 0;
-            DLOOP2 div_ucon += G.gcon(Loci::center, j, i, mu, nu) * grad_ucov[mu][nu];
-
-            // Compute+add explicit source terms (conduction and viscosity)
-            const Real& rho = P(b)(m_p.RHO, k, j, i);
-            const Real& Theta = Temps(b)(m_theta, k, j, i);
-
-
-            if (m_s.Q >= 0) {
-                const Real& qtilde = P(b)(m_p.Q, k, j, i);
-                const double inv_mag_b = 1. / m::sqrt(bsq);
-                Real q0            = 0;
-                DLOOP1 q0         -= rho * chi_e * (D.bcon[mu] * inv_mag_b) * grad_Theta[mu];
-                DLOOP2 q0         -= rho * chi_e * (D.bcon[mu] * inv_mag_b) * Theta * D.ucon[nu] * grad_ucov[nu][mu];
-                Real q0_tilde      = q0; 
-                if (emhd_params.higher_order_terms)
-                    q0_tilde *= (chi_e != 0) ? m::sqrt(tau / (chi_e * rho * Theta * Theta)) : 0.0;
-
-                dUdt(b, m_s.Q, k, j, i)  += G.gdet(Loci::center, j, i) * q0_tilde / tau;
-                if (emhd_params.higher_order_terms)
-                    dUdt(b, m_s.Q, k, j, i)  += G.gdet(Loci::center, j, i) * (qtilde / 2.) * div_ucon;
-            }
-
-            if (m_s.DP >= 0) {
-                const Real& dPtilde = P(b)(m_p.DP, k, j, i);
-                Real dP0            = -rho * nu_e * div_ucon;
-                DLOOP2  dP0        += 3. * rho * nu_e * (D.bcon[mu] * D.bcon[nu] / bsq) * grad_ucov[mu][nu];
-                Real dP0_tilde      = dP0;
-                if (emhd_params.higher_order_terms)
-                    dP0_tilde *= (nu_e != 0) ? m::sqrt(tau / (nu_e * rho * Theta)) : 0.0;
-
-                dUdt(b, m_s.DP, k, j, i) += G.gdet(Loci::center, j, i) * dP0_tilde / tau;
-                if (emhd_params.higher_order_terms)
-                    dUdt(b, m_s.DP, k, j, i) += G.gdet(Loci::center, j, i) * (dPtilde / 2.) * div_ucon;
+            ScratchPad3D<Real> T_s(member.team_scratch(scratch_level), NSOURCEROWS, NTEMPS, n1);
+
+            // ucov & Theta.  Only the center row needs the X1 halo
+            for (int row = 0; row < nrows; ++row) {
+                const int jr = j + (row == row_jp) - (row == row_jm);
+                const int kr = k + (row == row_kp) - (row == row_km);
+                const IndexRange ir = (row == row_c) ? il : ib;
+                parthenon::par_for_inner(member, ir.s, ir.e,
+                    [&](const int& i) {
+                        Real ucon[GR_DIM], ucov[GR_DIM];
+                        GRMHD::calc_ucon(G, P(b), m_p, kr, jr, i, Loci::center, ucon);
+                        G.lower(ucon, ucov, kr, jr, i, Loci::center);
+                        DLOOP1 T_s(row, mu, i) = ucov[mu];
+                        T_s(row, TEMP_THETA, i) = m::max((gam - 1) * P(b)(m_p.UU, kr, jr, i) / P(b)(m_p.RHO, kr, jr, i), SMALL);
+                    }
+                );
             }
+            member.team_barrier();
+
+            parthenon::par_for_inner(member, ib.s, ib.e,
+                [&](const int& i) {
+                    // No viscosity or conduction deep inside the EH, see Globals "reduced_work_r"
+                    if (G.r(k, j, i) < r_reduced) return;
+
+                    // Get the EGRMHD parameters
+                    Real tau, chi_e, nu_e;
+                    EMHD::set_parameters(G, P(b), m_p, emhd_params, gam, k, j, i, tau, chi_e, nu_e);
+
+                    // and the 4-vectors
+                    FourVectors D;
+                    GRMHD::calc_4vecs(G, P(b), m_p, k, j, i, Loci::center, D);
+                    const double bsq = m::max(dot(D.bcon, D.bcov), SMALL);
+
+                    // Compute gradient of ucov and Theta
+                    Real grad_ucov[GR_DIM][GR_DIM], grad_Theta[GR_DIM];
+                    // TODO thread the limiter selection through to call
+                    EMHD::gradient_calc<KReconstruction::Type::linear_mc>(G, T_s, k, j, i, (ndim > 2), (ndim > 1), grad_ucov, grad_Theta);
+
+                    // Compute div of ucon (all terms but the time-derivative ones are nonzero)
+                    Real div_ucon    = 0;
+                    DLOOP2 div_ucon += G.gcon(Loci::center, j, i, mu, nu) * grad_ucov[mu][nu];
+
+                    // Compute+add explicit source terms (conduction and viscosity)
+                    const Real& rho = P(b)(m_p.RHO, k, j, i);
+                    const Real& Theta = T_s(row_c, TEMP_THETA, i);
+
+                    if (m_s.Q >= 0) {
+                        const Real& qtilde = P(b)(m_p.Q, k, j, i);
+                        const double inv_mag_b = 1. / m::sqrt(bsq);
+                        Real q0            = 0;
+                        DLOOP1 q0         -= rho * chi_e * (D.bcon[mu] * inv_mag_b) * grad_Theta[mu];
+                        DLOOP2 q0         -= rho * chi_e * (D.bcon[mu] * inv_mag_b) * Theta * D.ucon[nu] * grad_ucov[nu][mu];
+                        Real q0_tilde      = q0; 
+                        if (emhd_params.higher_order_terms)
+                            q0_tilde *= (chi_e != 0) ? m::sqrt(tau / (chi_e * rho * Theta * Theta)) : 0.0;
+
+                        dUdt(b, m_s.Q, k, j, i)  += G.gdet(Loci::center, j, i) * q0_tilde / tau;
+                        if (emhd_params.higher_order_terms)
+                            dUdt(b, m_s.Q, k, j, i)  += G.gdet(Loci::center, j, i) * (qtilde / 2.) * div_ucon;
+                    }
+
+                    if (m_s.DP >= 0) {
+                        const Real& dPtilde = P(b)(m_p.DP, k, j, i);
+                        Real dP0            = -rho * nu_e * div_ucon;
+                        DLOOP2  dP0        += 3. * rho * nu_e * (D.bcon[mu] * D.bcon[nu] / bsq) * grad_ucov[mu][nu];
+                        Real dP0_tilde      = dP0;
+                        if (emhd_params.higher_order_terms)
+                            dP0_tilde *= (nu_e != 0) ? m::sqrt(tau / (nu_e * rho * Theta)) : 0.0;
+
+                        dUdt(b, m_s.DP, k, j, i) += G.gdet(Loci::center, j, i) * dP0_tilde / tau;
+                        if (emhd_params.higher_order_terms)
+                            dUdt(b, m_s.DP, k, j, i) += G.gdet(Loci::center, j, i) * (dPtilde / 2.) * div_ucon;
+                    }
+                }
+            );
         }
     );
 
@@ -35,6 +35,7 @@
 
 #include <parthenon/parthenon.hpp>
 
+#include "fast_math.hpp"
 #include "grmhd_functions.hpp"
 
 using namespace parthenon;
@@ -227,7 +228,7 @@ KOKKOS_INLINE_FUNCTION void set_parameters(const GRCoordinates& G, const Real& r
                         : qtilde;
             const Real q_max   = emhd_params.conduction_alpha * rho * cs2 * m::sqrt(cs2);
             const Real q_ratio = m::abs(q) / q_max;
-            const Real inv_exp_g = m::exp(-(q_ratio - 1.) / lambda);
+            const Real inv_exp_g = fm::exp(-(q_ratio - 1.) / lambda);
             const Real f_fmin    = inv_exp_g / (inv_exp_g + 1.) + 1.e-5;
 
             tau = m::min(tau, f_fmin * tau_dyn);
@@ -245,7 +246,7 @@ KOKKOS_INLINE_FUNCTION void set_parameters(const GRCoordinates& G, const Real& r
                               : m::max(-bsq, -2.99 * pg / 1.07);
 
             const Real dP_ratio = m::abs(dP) / (m::abs(dP_max) + SMALL);
-            const Real inv_exp_g = m::exp((1. - dP_ratio) / lambda);
+            const Real inv_exp_g = fm::exp((1. - dP_ratio) / lambda);
             const Real f_fmin    = inv_exp_g / (inv_exp_g + 1.) + 1.e-5;
 
             tau = m::min(tau, f_fmin * tau_dyn);
@@ -37,7 +37,7 @@
 
 #include "reconstruction.hpp"
 
-using KReconstruction::slope_calc;
+using KReconstruction::slope_limit;
 
 /**
  * Utilities for the EMHD source terms, things we might conceivably use somewhere else,
@@ -45,17 +45,24 @@ using KReconstruction::slope_calc;
  * 
  * 1. Slopes at faces using various linear reconstructions.  Since this is unrelated to
  *    reconstructing all prims, and only called zone-wise, the "same" recon algos are reimplemented here
- * 2. Calculate gradient of each component of ucov & 
+ * 2. Calculate gradient of each component of ucov & Theta
  */
 
 namespace EMHD {
 
-// Compute gradient of four velocities and temperature
-// Called by emhd_explicit_sources
+// Layout of the per-row team scratch used by the explicit source kernel:
+// rows of ucov & Theta at (k,j) and its neighbors in X2 & X3 (only those needed are filled)
+enum SourceRow{row_c=0, row_jm, row_jp, row_km, row_kp};
+constexpr int NSOURCEROWS = 5;
+// Variables in each row: ucov[mu], then Theta
+constexpr int TEMP_THETA = GR_DIM;
+constexpr int NTEMPS = GR_DIM + 1;
+
+// Compute gradient of four velocities and temperature from the cached rows,
+// see EMHD::AddSource
 template<KReconstruction::Type recon>
-KOKKOS_INLINE_FUNCTION void gradient_calc(const GRCoordinates& G, const VariablePack<Real>& Temps,
-                                          const int& uvec_index, const int& theta_index,
-                                          const int& b, const int& k, const int& j, const int& i, 
+KOKKOS_INLINE_FUNCTION void gradient_calc(const GRCoordinates& G, const ScratchPad3D<Real>& T_s,
+                                          const int& k, const int& j, const int& i,
                                           const bool& do_3d, const bool& do_2d,
                                           Real grad_ucov[GR_DIM][GR_DIM], Real grad_Theta[GR_DIM])
 {
@@ -63,19 +70,22 @@ KOKKOS_INLINE_FUNCTION void gradient_calc(const GRCoordinates& G, const Variable
     DLOOP1 {
         grad_ucov[0][mu] = 0;
         // slope in direction nu of component mu
-        grad_ucov[1][mu] = slope_calc<recon, X1DIR>(G, Temps, uvec_index + mu, k, j, i);
-        grad_ucov[2][mu] = (do_2d) ? slope_calc<recon, X2DIR>(G, Temps, uvec_index + mu, k, j, i) : 0.;
-        grad_ucov[3][mu] = (do_3d) ? slope_calc<recon, X3DIR>(G, Temps, uvec_index + mu, k, j, i) : 0.;
+        grad_ucov[1][mu] = slope_limit<recon>(T_s(row_c, mu, i-1), T_s(row_c, mu, i), T_s(row_c, mu, i+1), G.Dxc<X1DIR>(i));
+        grad_ucov[2][mu] = (do_2d) ? slope_limit<recon>(T_s(row_jm, mu, i), T_s(row_c, mu, i), T_s(row_jp, mu, i), G.Dxc<X2DIR>(j)) : 0.;
+        grad_ucov[3][mu] = (do_3d) ? slope_limit<recon>(T_s(row_km, mu, i), T_s(row_c, mu, i), T_s(row_kp, mu, i), G.Dxc<X3DIR>(k)) : 0.;
     }
     // TODO skip this if flat space?
-    DLOOP3 grad_ucov[mu][nu] -= G.conn(j, i, lam, mu, nu) * Temps(uvec_index + lam, k, j, i);
+    DLOOP3 grad_ucov[mu][nu] -= G.conn(j, i, lam, mu, nu) * T_s(row_c, lam, i);
 
     // Compute temperature gradient
     // Time derivative component is computed in time_derivative_sources
     grad_Theta[0] = 0;
-    grad_Theta[1] = slope_calc<recon, X1DIR>(G, Temps, theta_index, k, j, i);
-    grad_Theta[2] = (do_2d) ? slope_calc<recon, X2DIR>(G, Temps, theta_index, k, j, i) : 0.;
-    grad_Theta[3] = (do_3d) ? slope_calc<recon, X3DIR>(G, Temps, theta_index, k, j, i) : 0.;
+    grad_Theta[1] = slope_limit<recon>(T_s(row_c, TEMP_THETA, i-1), T_s(row_c, TEMP_THETA, i),
+                                       T_s(row_c, TEMP_THETA, i+1), G.Dxc<X1DIR>(i));
+    grad_Theta[2] = (do_2d) ? slope_limit<recon>(T_s(row_jm, TEMP_THETA, i), T_s(row_c, TEMP_THETA, i),
+                                                 T_s(row_jp, TEMP_THETA, i), G.Dxc<X2DIR>(j)) : 0.;
+    grad_Theta[3] = (do_3d) ? slope_limit<recon>(T_s(row_km, TEMP_THETA, i), T_s(row_c, TEMP_THETA, i),
+                                                 T_s(row_kp, TEMP_THETA, i), G.Dxc<X3DIR>(k)) : 0.;
 }
 
 } // namespace EMHD
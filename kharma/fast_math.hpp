@@ -0,0 +1,195 @@
+/* 
+ *  File: fast_math.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/**
+ * Approximate transcendental functions for the hottest per-zone kernels: electron heating,
+ * floors, EMHD parameters and the primitive variable inversions, which call pow/exp many
+ * times per zone per stage.
+ *
+ * These are compiled in with the CMake option KHARMA_FAST_MATH ("./make.sh [OPTIONS] fastmath"),
+ * otherwise everything here calls straight through to m::.  The approximations are a few
+ * multiplies and adds with no library calls or data-dependent branches, so loops over zones
+ * vectorize on CPUs.  On GPUs the library versions are already fast, so there's little to gain.
+ *
+ * Error bounds in double precision, for arguments in the normal range:
+ * log:   |err| < 1e-12 absolute (mantissa in [sqrt(1/2), sqrt(2)), atanh series through s^13)
+ * exp:   |err| < 2e-14 relative (|r| <= ln2/2, degree-11 Taylor)
+ * pow:   |err| < 1e-12 max(1, |y|) relative, as exp(y log(x)).  KHARMA's exponents are O(1)
+ * rsqrt: |err| < 1e-15 relative (bit-trick guess, four Newton steps)
+ *
+ * Special & out-of-range values are as libm's: log(0) = -inf, exp underflows through the subnormals to 0
+ * and overflows to inf, pow(0, y > 0) = 0, pow(x, 0) = 1, rsqrt(0) = inf, rsqrt(inf) = 0, and NaN or
+ * negative arguments give NaN.  The one difference is pow(x < 0, integer y), which is NaN here: KHARMA only
+ * raises densities, temperatures, beta and sigma to powers, and none are negative except by a bug.
+ * sqrt is a single instruction & not approximated.
+ *
+ * Accuracy is checked by running the convergence tests in tests/bondi and tests/mhdmodes
+ * against a fastmath build, see those run.sh files.
+ */
+namespace fm {
+
+#if FAST_MATH
+namespace detail {
+KOKKOS_FORCEINLINE_FUNCTION double from_bits(const uint64_t bits)
+{
+    double x;
+    memcpy(&x, &bits, sizeof(double));
+    return x;
+}
+KOKKOS_FORCEINLINE_FUNCTION uint64_t to_bits(const double x)
+{
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(double));
+    return bits;
+}
+static constexpr double LN2_HI = 6.93147180369123816490e-01; // Exact in 32 bits, so n*LN2_HI is exact
+static constexpr double LN2_LO = 1.90821492927058770002e-10;
+static constexpr double LN2 = 0.693147180559945309417;
+static constexpr double LOG2E = 1.44269504088896340736;
+static constexpr double LOG10E = 0.434294481903251827651;
+// For scaling subnormals into the normal range
+static constexpr double TWO54 = 18014398509481984.0;
+static constexpr double TWO27 = 134217728.0;
+static constexpr double INF = std::numeric_limits<double>::infinity();
+static constexpr double NAN_D = std::numeric_limits<double>::quiet_NaN();
+} // namespace detail
+#endif
+
+KOKKOS_INLINE_FUNCTION Real log(const Real x)
+{
+#if FAST_MATH
+    using namespace detail;
+    // Scale subnormals up, and clamp everything else finite & positive so the bit manipulation is valid.
+    // Special values are patched up at the end
+    const bool subnormal = x < DBL_MIN;
+    const double xc = m::min(m::max((subnormal) ? x * TWO54 : (double) x, DBL_MIN), DBL_MAX);
+    const uint64_t bits = to_bits(xc);
+    // x = mant * 2^e, mant in [1, 2), then shift mant into [sqrt(1/2), sqrt(2))
+    double e = static_cast<double>(static_cast<int>((bits >> 52) & 0x7ff) - 1023) - ((subnormal) ? 54. : 0.);
+    double mant = from_bits((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+    const bool high = mant > 1.41421356237309504880;
+    mant = high ? 0.5 * mant : mant;
+    e = high ? e + 1. : e;
+    // log(mant) = 2 atanh(s) = 2 (s + s^3/3 + s^5/5 + ...), |s| < 0.172
+    const double s = (mant - 1.) / (mant + 1.);
+    const double s2 = s * s;
+    const double series = 1. + s2*(1./3 + s2*(1./5 + s2*(1./7 + s2*(1./9 + s2*(1./11 + s2*(1./13))))));
+    const double result = 2. * s * series + e * LN2;
+    return (x > 0. && x <= DBL_MAX) ? result : ((x == 0.) ? -INF : ((x > DBL_MAX) ? INF : NAN_D));
+#else
+    return m::log(x);
+#endif
+}
+
+KOKKOS_INLINE_FUNCTION Real log10(const Real x)
+{
+#if FAST_MATH
+    return fm::log(x) * detail::LOG10E;
+#else
+    return m::log10(x);
+#endif
+}
+
+KOKKOS_INLINE_FUNCTION Real exp(const Real x)
+{
+#if FAST_MATH
+    using namespace detail;
+    // Beyond these, the result is 0 or inf anyway
+    const double xc = (x == x) ? m::min(m::max((double) x, -746.), 710.) : 0.;
+    // x = n ln2 + r, |r| <= ln2/2, with ln2 split so that r is accurate
+    const double n = m::floor(xc * LOG2E + 0.5);
+    const double r = (xc - n * LN2_HI) - n * LN2_LO;
+    const double p = 1. + r*(1. + r*(1./2 + r*(1./6 + r*(1./24 + r*(1./120 + r*(1./720
+                     + r*(1./5040 + r*(1./40320 + r*(1./362880 + r*(1./3628800 + r*(1./39916800)))))))))));
+    // Build 2^n directly in the exponent bits, as two factors which are always normal numbers,
+    // so that the product overflows to inf or rounds into the subnormals & 0 as libm does
+    const double n1 = m::floor(0.5 * n), n2 = n - n1;
+    const double scale1 = from_bits(static_cast<uint64_t>(static_cast<int64_t>(n1) + 1023) << 52);
+    const double scale2 = from_bits(static_cast<uint64_t>(static_cast<int64_t>(n2) + 1023) << 52);
+    return (x == x) ? (p * scale1) * scale2 : x;
+#else
+    return m::exp(x);
+#endif
+}
+
+/**
+ * x^y.  Unlike m::pow, this is NaN for *any* negative x, including integer y: fm::pow(-2., 2.) is NaN,
+ * not 4.  For non-integer y the two agree (NaN), so this can only matter where a call site's exponent
+ * is a whole number, e.g. gam = 2, and its base goes negative, e.g. a density before floors.
+ * Guard such bases with m::max(x, SMALL) or use m::pow.
+ */
+KOKKOS_INLINE_FUNCTION Real pow(const Real x, const Real y)
+{
+#if FAST_MATH
+    // log & exp take care of x = 0 & infinities.  Like libm, x^0 = 1 for all x
+    return (y == 0.) ? 1. : fm::exp(y * fm::log(x));
+#else
+    return m::pow(x, y);
+#endif
+}
+
+/**
+ * 1/sqrt(x).  Usually this is a sqrt & a divide, both slow and poorly pipelined
+ */
+KOKKOS_INLINE_FUNCTION Real rsqrt(const Real x)
+{
+#if FAST_MATH
+    using namespace detail;
+    // Scale subnormals up, so the guess is valid
+    const bool subnormal = x < DBL_MIN;
+    const double xs = (subnormal) ? x * TWO54 : x;
+    // Initial guess good to 3.5%, then each Newton step squares the error
+    double y = from_bits(0x5fe6eb50c7b537a9ULL - (to_bits(xs) >> 1));
+    const double half_x = 0.5 * xs;
+    y = y * (1.5 - half_x * y * y);
+    y = y * (1.5 - half_x * y * y);
+    y = y * (1.5 - half_x * y * y);
+    y = y * (1.5 - half_x * y * y);
+    y = (subnormal) ? y * TWO27 : y;
+    // As 1/sqrt(x): +-0 -> +-inf, inf -> 0, negative or NaN -> NaN
+    return (x > 0. && x <= DBL_MAX) ? y : ((x == 0.) ? 1. / x : ((x > DBL_MAX) ? 0. : NAN_D));
+#else
+    return 1. / m::sqrt(x);
+#endif
+}
+
+} // namespace fm
@@ -40,6 +40,7 @@
 #include "grmhd_functions.hpp"
 #include "inverter.hpp"
 #include "pack.hpp"
+#include "transients.hpp"
 
 // Floors.  Apply limits to fluid values to maintain integrable state
 
@@ -103,10 +104,12 @@ std::shared_ptr<KHARMAPackage> Floors::Initialize(ParameterInput *pin, std::shar
 
     // These preserve floor values between the "mark" pass and the actual floor application
     // We need them even if floors are disabled, to apply initial values based on some prescription
-    // as a part of problem setup
+    // as a part of problem setup.  Each mark pass is followed directly by its application, but
+    // FOFC also marks & applies floors on its guess state during the flux phase, so the values
+    // must not share storage with anything live from flux through floors
     Metadata m = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
-    pkg->AddField("Floors.rho_floor", m);
-    pkg->AddField("Floors.u_floor", m);
+    Transients::AddField(pkg, pin, "Floors.rho_floor", m, Transients::Phase::flux, Transients::Phase::floors);
+    Transients::AddField(pkg, pin, "Floors.u_floor", m, Transients::Phase::flux, Transients::Phase::floors);
 
     // Flag for which floor conditions were violated.  Used for diagnostics
     // TODO(BSP) Should switch these to "Integer" fields when Parthenon supports it
@@ -126,12 +129,69 @@ std::shared_ptr<KHARMAPackage> Floors::Initialize(ParameterInput *pin, std::shar
     hst_vars.emplace_back(parthenon::HistoryOutputVar(UserHistoryOperation::sum, CountFFlags, "FFlags"));
     // TODO Domain::entire version?
     // TODO entries for each individual flag?
+
+    // Optionally keep a budget of mass & energy added by floors and fixups, by reason & radial band.
+    // Bands are split at budget_nbands-1 radii, spaced logarithmically from budget_r_min to budget_r_max
+    Budget budget;
+    budget.enabled = pin->GetOrAddBoolean("floors", "budget", false);
+    if (budget.enabled) {
+        budget.nbands = m::max(pin->GetOrAddInteger("floors", "budget_nbands", 4), 1);
+        const GReal r_min = pin->GetOrAddReal("floors", "budget_r_min", 2.);
+        const GReal r_max = pin->GetOrAddReal("floors", "budget_r_max", 200.);
+        if (r_min <= 0. || r_max <= r_min)
+            throw std::invalid_argument("Floor budget bands must satisfy 0 < budget_r_min < budget_r_max!");
+        budget.lr_min = m::log(r_min);
+        budget.dlr = (budget.nbands > 2) ? (m::log(r_max) - m::log(r_min)) / (budget.nbands - 2) : 1.;
+        budget.ndim = pin->GetInteger("parthenon/mesh", "nx3") > 1 ? 3 : (pin->GetInteger("parthenon/mesh", "nx2") > 1 ? 2 : 1);
+        // Reasons are indexed by bit, so the flags must be consecutive bits from FFlag::MINIMUM
+        budget.nfloor = FFlag::flag_names.size();
+        int bit = 0;
+        for (auto &flag : FFlag::flag_names)
+            if (flag.first != (FFlag::MINIMUM << bit++))
+                throw std::runtime_error("Floor flags must be consecutive bits to keep a floor budget!");
+        budget.totals = ParArray3D<Real>("floor_budget", budget.NReason(), budget.nbands, 2);
+        budget.scatter = Kokkos::Experimental::create_scatter_view(budget.totals);
+        budget.totals_host = Kokkos::create_mirror_view(budget.totals);
+
+        std::vector<std::string> reasons = {"UTOP_FIXUP", "SOLVE_FIXUP"};
+        for (auto &flag : FFlag::flag_names) reasons.push_back(flag.second);
+        for (int reason = 0; reason < budget.NReason(); ++reason) {
+            for (int band = 0; band < budget.nbands; ++band) {
+                for (int q = 0; q < 2; ++q) {
+                    const std::string label = std::string((q == 0) ? "FloorM_" : "FloorE_") + reasons[reason]
+                                            + "_r" + std::to_string(band);
+                    hst_vars.emplace_back(parthenon::HistoryOutputVar(UserHistoryOperation::sum,
+                        [reason, band, q](MeshData<Real> *md) { return BudgetTotal(md, reason, band, q); }, label));
+                }
+            }
+        }
+    }
+    params.Add("budget", budget);
+
     // add callbacks for HST output to the Params struct, identified by the `hist_param_key`
     pkg->AddParam<>(parthenon::hist_param_key, hst_vars);
 
     return pkg;
 }
 
+Real Floors::BudgetTotal(MeshData<Real> *md, int reason, int band, int quantity)
+{
+    auto pmesh = md->GetMeshPointer();
+    if (md->GetBlockData(0)->GetBlockPointer()->gid != pmesh->block_list[0]->gid) return 0.;
+    // The host copy is refreshed after every step, see CopyBudget
+    const auto& budget = pmesh->packages.Get("Floors")->Param<Budget>("budget");
+    return budget.totals_host(reason, band, quantity);
+}
+
+void Floors::CopyBudget(MeshData<Real> *md)
+{
+    auto pmesh = md->GetMeshPointer();
+    const auto& budget = pmesh->packages.Get("Floors")->Param<Budget>("budget");
+    // Totals are per-rank, so copy them once, for the partition holding the first block
+    if (!budget.enabled || md->GetBlockData(0)->GetBlockPointer()->gid != pmesh->block_list[0]->gid) return;
+    Kokkos::deep_copy(budget.totals_host, budget.totals);
+}
+
 TaskStatus Floors::ApplyInitialFloors(ParameterInput *pin, MeshBlockData<Real> *mbd, IndexDomain domain)
 {
     Flag("ApplyInitialFloors");
@@ -207,15 +267,17 @@ TaskStatus Floors::DetermineGRMHDFloors(MeshData<Real> *md, IndexDomain domain,
     auto fflag = md->PackVariables(std::vector<std::string>{"fflag"});
     auto pflag = md->PackVariables(std::vector<std::string>{"pflag"});
     PackIndexMap floors_map;
-    auto floor_vals = md->PackVariables(std::vector<std::string>{"Floors.rho_floor", "Floors.u_floor"}, floors_map);
-    const int rhofi = floors_map["Floors.rho_floor"].first;
-    const int ufi = floors_map["Floors.u_floor"].first;
+    const std::string rho_floor_name = Transients::Name("Floors.rho_floor");
+    const std::string u_floor_name = Transients::Name("Floors.u_floor");
+    auto floor_vals = md->PackVariables(std::vector<std::string>{rho_floor_name, u_floor_name}, floors_map);
+    const int rhofi = floors_map[rho_floor_name].first;
+    const int ufi = floors_map[u_floor_name].first;
 
     const Real gam = pmb0->packages.Get("GRMHD")->Param<Real>("gamma");
 
     const IndexRange3 b = KDomain::GetRange(md, domain);
     const IndexRange block = IndexRange{0, P.GetDim(5) - 1};
-    pmb0->par_for("determine_floors", block.s, block.e, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+    Tiling::par_for("determine_floors", pmb0->exec_space, block.s, block.e, b.ks, b.ke, b.js, b.je, b.is, b.ie,
         KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i) {
             const auto& G = P.GetCoords(b);
             fflag(b, 0, k, j, i) = static_cast<int>(fflag(b, 0, k, j, i)) |
@@ -264,6 +326,9 @@ TaskStatus Floors::PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
         Reductions::CheckFlagReduceAndPrintHits(md, "fflag", FFlag::flag_names, IndexDomain::interior, true, 0);
     }
 
+    // Keep the host copy of the floor budget current for any history output this step
+    CopyBudget(md);
+
     // Anything else (energy conservation? Added material stats?)
 
     return TaskStatus::complete;
@@ -36,6 +36,8 @@
 #include "decs.hpp"
 #include "types.hpp"
 
+#include <Kokkos_ScatterView.hpp>
+
 #include "b_flux_ct.hpp"
 #include "flux_functions.hpp"
 #include "grmhd_functions.hpp"
@@ -116,6 +118,78 @@ class Prescription {
         Real floors_switch_r;
 };
 
+/**
+ * Running totals of the mass & energy added by floors and fixups, binned by reason and by radial band.
+ * The kernels which modify the state add their changes as they go, through a ScatterView
+ * (per-thread copies on the host, atomics on GPUs), and call Contribute() once afterward.
+ * Totals are per-rank, accumulated since the run (or restart) began.
+ * Reasons are the UtoP & implicit solver fixups, followed by the FFlag bits in order
+ * (a zone hitting several floors counts under the lowest bit).
+ */
+class Budget {
+    public:
+        static constexpr int UTOP_FIXUP = 0;
+        static constexpr int SOLVE_FIXUP = 1;
+        static constexpr int NFIXUP = 2;
+
+        // Totals (reason, band, mass=0/energy=1), the ScatterView kernels add into,
+        // and a host copy refreshed after each step, see CopyBudget
+        ParArray3D<Real> totals;
+        Kokkos::Experimental::ScatterView<Real***, LayoutWrapper, DevExecSpace> scatter;
+        ParArray3D<Real>::HostMirror totals_host;
+        // Bands are logarithmic in r, open-ended at both ends
+        GReal lr_min = 0., dlr = 1.;
+        int nbands = 1, ndim = 3;
+        // One reason per entry in FFlag::flag_names, set in Floors::Initialize
+        int nfloor = 0;
+        bool enabled = false;
+
+        int NReason() const { return NFIXUP + nfloor; }
+
+        KOKKOS_INLINE_FUNCTION int FloorReason(const int fflag) const
+        {
+            int bit = 0;
+            while (bit < nfloor - 1 && !(fflag & (FFlag::MINIMUM << bit))) ++bit;
+            return NFIXUP + bit;
+        }
+
+        /**
+         * Record a zone's change in conserved rest mass & total energy (-T^t_t, which includes rest mass),
+         * given the changes in the conserved variables RHO & UU
+         */
+        KOKKOS_INLINE_FUNCTION void Add(const GRCoordinates& G, const int reason, const int& k, const int& j, const int& i,
+                                        const Real& dU_rho, const Real& dU_uu) const
+        {
+            const GReal lr = m::log(m::max(G.r(k, j, i), (GReal) SMALL));
+            const int band = m::min(m::max(static_cast<int>(m::floor((lr - lr_min) / dlr)) + 1, 0), nbands - 1);
+            const Real dV = G.Dxc<1>(i) * ((ndim > 1) ? G.Dxc<2>(j) : 1.) * ((ndim > 2) ? G.Dxc<3>(k) : 1.);
+            auto access = scatter.access();
+            access(reason, band, 0) += dU_rho * dV;
+            access(reason, band, 1) += (dU_rho - dU_uu) * dV;
+        }
+
+        /**
+         * Fold anything added since the last call into the totals.  Call after each kernel using Add(),
+         * on the same execution space
+         */
+        void Contribute(const DevExecSpace& exec_space)
+        {
+            if (!enabled) return;
+            scatter.contribute_into(exec_space, totals);
+            scatter.reset_except(exec_space, totals);
+        }
+};
+
+/**
+ * Get the floor & fixup budget, or a disabled one if the Floors package isn't loaded
+ */
+inline Budget GetBudget(Packages_t& packages)
+{
+    if (packages.AllPackages().count("Floors"))
+        return packages.Get("Floors")->Param<Budget>("budget");
+    return Budget();
+}
+
 inline Prescription MakePrescription(parthenon::ParameterInput *pin, std::string block="floors")
 {
     Prescription p;
@@ -253,6 +327,18 @@ TaskStatus ApplyInitialFloors(ParameterInput *pin, MeshBlockData<Real> *mbd, Ind
  */
 int CountFFlags(MeshData<Real> *md);
 
+/**
+ * Total mass (quantity 0) or energy (1) added for one reason in one radial band.
+ * Each rank reports its totals with its first MeshData partition, for Parthenon to sum
+ */
+Real BudgetTotal(MeshData<Real> *md, int reason, int band, int quantity);
+
+/**
+ * Copy the floor budget totals back to the host, from PostStepDiagnostics,
+ * so BudgetTotal returns the same values whatever order the history is evaluated in
+ */
+void CopyBudget(MeshData<Real> *md);
+
 /**
  * Print a summary of floors which were hit
  */
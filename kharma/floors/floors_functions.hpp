@@ -33,6 +33,7 @@
  */
 #pragma once
 
+#include "fast_math.hpp"
 #include "floors.hpp"
 #include "onedw.hpp"
 
@@ -58,7 +59,7 @@ KOKKOS_INLINE_FUNCTION void apply_ceilings(const GRCoordinates& G, const Variabl
 
     // Compute max values for ceilings
     Real gamma      = GRMHD::lorentz_calc(G, P, m_p, k, j, i, loc);
-    Real ktot       = (gam - 1.) * P(m_p.UU, k, j, i) / m::pow(P(m_p.RHO, k, j, i), gam);
+    Real ktot       = (gam - 1.) * P(m_p.UU, k, j, i) / fm::pow(P(m_p.RHO, k, j, i), gam);
     Real u_over_rho = P(m_p.UU, k, j, i) / P(m_p.RHO, k, j, i);
 
     // 1. Limit gamma with respect to normal observer
@@ -96,9 +97,9 @@ KOKKOS_INLINE_FUNCTION int determine_floors(const GRCoordinates& G, const Variab
     if(G.coords.is_spherical()) {
         const GReal r = G.r(k, j, i);
         // r_char sets more aggressive floor close to EH but backs off
-        Real rhoscal = (myfloors.use_r_char) ? 1. / ((r*r) * (1 + r / myfloors.r_char)) : 1. / m::sqrt(r*r*r);
+        Real rhoscal = (myfloors.use_r_char) ? 1. / ((r*r) * (1 + r / myfloors.r_char)) : fm::rsqrt(r*r*r);
         rhoflr_geom = m::max(myfloors.rho_min_geom * rhoscal, myfloors.rho_min_const);
-        uflr_geom   = m::max(myfloors.u_min_geom * m::pow(rhoscal, gam), myfloors.u_min_const);
+        uflr_geom   = m::max(myfloors.u_min_geom * fm::pow(rhoscal, gam), myfloors.u_min_const);
     } else {
         rhoflr_geom = myfloors.rho_min_const;
         uflr_geom   = myfloors.u_min_const;
@@ -150,7 +151,7 @@ KOKKOS_INLINE_FUNCTION int determine_floors(const GRCoordinates& G, const Variab
     if (GRMHD::lorentz_calc(G, P, m_p, k, j, i, Loci::center) > myfloors.gamma_max)
         fflag |= FFlag::GAMMA;
 
-    if ((gam - 1.) * P(m_p.UU, k, j, i) / m::pow(P(m_p.RHO, k, j, i), gam) > myfloors.ktot_max)
+    if ((gam - 1.) * P(m_p.UU, k, j, i) / fm::pow(P(m_p.RHO, k, j, i), gam) > myfloors.ktot_max)
         fflag |= FFlag::KTOT;
 
     if (myfloors.temp_adjust_u && (P(m_p.UU, k, j, i) / P(m_p.RHO, k, j, i) > myfloors.u_over_rho_max))
@@ -230,7 +231,7 @@ KOKKOS_INLINE_FUNCTION int apply_floors<InjectionFrame::drift>(FLOOR_ONE_ARGS)
 
     Real ucon_dr[GR_DIM] = {0};
     // t-component of drift velocity (refer R17 Eqn B13)
-    ucon_dr[0] = 1. / m::sqrt(1. / (Dtmp.ucon[0]*Dtmp.ucon[0]) + vpar*vpar);
+    ucon_dr[0] = fm::rsqrt(1. / (Dtmp.ucon[0]*Dtmp.ucon[0]) + vpar*vpar);
     // spatial components of drift velocity (refer R17 Eqn B11)
     DLOOP1 ucon_dr[mu] = Dtmp.ucon[mu] * (ucon_dr[0] / Dtmp.ucon[0]) - (vpar * Bcon[mu] * ucon_dr[0] / B_mag);
 
@@ -245,7 +246,7 @@ KOKKOS_INLINE_FUNCTION int apply_floors<InjectionFrame::drift>(FLOOR_ONE_ARGS)
     vpar = x / (1 + m::sqrt(1 + x*x)) * (1. / ucon_dr[0]);
 
     // New fluid four velocity (refer R17 Eqns B13 and B11)
-    Dtmp.ucon[0] = 1. / m::sqrt(1/(ucon_dr[0]*ucon_dr[0]) - vpar*vpar);
+    Dtmp.ucon[0] = fm::rsqrt(1/(ucon_dr[0]*ucon_dr[0]) - vpar*vpar);
     DLOOP1 Dtmp.ucon[mu] = ucon_dr[mu] * (Dtmp.ucon[0] / ucon_dr[0]) + (vpar * Bcon[mu] * Dtmp.ucon[0] / B_mag);
     G.lower(Dtmp.ucon, Dtmp.ucov, k, j, i, Loci::center);
 
@@ -312,9 +313,9 @@ KOKKOS_INLINE_FUNCTION int apply_geo_floors(const GRCoordinates& G, Local& P, co
     if(G.coords.is_spherical()) {
         const GReal r = G.r(0, j, i);
         // r_char sets more aggressive floor close to EH but backs off
-        Real rhoscal = (myfloors.use_r_char) ? 1. / ((r*r) * (1 + r / myfloors.r_char)) : 1. / m::sqrt(r*r*r);
+        Real rhoscal = (myfloors.use_r_char) ? 1. / ((r*r) * (1 + r / myfloors.r_char)) : fm::rsqrt(r*r*r);
         rhoflr_geom = m::max(myfloors.rho_min_geom * rhoscal, myfloors.rho_min_const);
-        uflr_geom   = m::max(myfloors.u_min_geom * m::pow(rhoscal, gam), myfloors.u_min_const);
+        uflr_geom   = m::max(myfloors.u_min_geom * fm::pow(rhoscal, gam), myfloors.u_min_const);
     } else {
         rhoflr_geom = myfloors.rho_min_const;
         uflr_geom   = myfloors.u_min_const;
@@ -346,9 +347,9 @@ KOKKOS_INLINE_FUNCTION int apply_geo_floors(const GRCoordinates& G, Global& P, c
     if(G.coords.is_spherical()) {
         const GReal r = G.r(0, j, i);
         // r_char sets more aggressive floor close to EH but backs off
-        Real rhoscal = (myfloors.use_r_char) ? 1. / ((r*r) * (1 + r / myfloors.r_char)) : 1. / m::sqrt(r*r*r);
+        Real rhoscal = (myfloors.use_r_char) ? 1. / ((r*r) * (1 + r / myfloors.r_char)) : fm::rsqrt(r*r*r);
         rhoflr_geom = m::max(myfloors.rho_min_geom * rhoscal, myfloors.rho_min_const);
-        uflr_geom   = m::max(myfloors.u_min_geom * m::pow(rhoscal, gam), myfloors.u_min_const);
+        uflr_geom   = m::max(myfloors.u_min_geom * fm::pow(rhoscal, gam), myfloors.u_min_const);
     } else {
         rhoflr_geom = myfloors.rho_min_const;
         uflr_geom   = myfloors.u_min_const;
@@ -36,6 +36,8 @@
 #include "floors.hpp"
 
 #include "domain.hpp"
+#include "tiling.hpp"
+#include "transients.hpp"
 
 namespace Floors {
 
@@ -55,9 +57,11 @@ TaskStatus ApplyFloorsInFrame(MeshData<Real> *md, IndexDomain domain)
     auto fflag = md->PackVariables(std::vector<std::string>{"fflag"});
     auto pflag = md->PackVariables(std::vector<std::string>{"pflag"});
     PackIndexMap floors_map;
-    auto floor_vals = md->PackVariables(std::vector<std::string>{"Floors.rho_floor", "Floors.u_floor"}, floors_map);
-    const int rhofi = floors_map["Floors.rho_floor"].first;
-    const int ufi = floors_map["Floors.u_floor"].first;
+    const std::string rho_floor_name = Transients::Name("Floors.rho_floor");
+    const std::string u_floor_name = Transients::Name("Floors.u_floor");
+    auto floor_vals = md->PackVariables(std::vector<std::string>{rho_floor_name, u_floor_name}, floors_map);
+    const int rhofi = floors_map[rho_floor_name].first;
+    const int ufi = floors_map[u_floor_name].first;
 
     const Real gam = pmb0->packages.Get("GRMHD")->Param<Real>("gamma");
     const EMHD::EMHD_parameters& emhd_params = EMHD::GetEMHDParameters(pmb0->packages);
@@ -68,20 +72,34 @@ TaskStatus ApplyFloorsInFrame(MeshData<Real> *md, IndexDomain domain)
     // Still needed for ceilings and determining floors
     const Floors::Prescription floors = pmb0->packages.Get("Floors")->Param<Floors::Prescription>("prescription");
     const Floors::Prescription floors_inner = pmb0->packages.Get("Floors")->Param<Floors::Prescription>("prescription_inner");
+    // Deep inside the EH, just add material in the fluid frame, and don't tally it
+    const Real r_reduced = pmb0->packages.Get("Globals")->Param<Real>("reduced_work_r");
+
+    // Tally what we add, counting each zone once by skipping ghost zones
+    Budget budget = GetBudget(pmb0->packages);
+    const IndexRange3 bi = KDomain::GetRange(md, IndexDomain::interior);
 
     // Determine floors
     DetermineGRMHDFloors(md, domain, floors, floors_inner);
 
     const IndexRange3 b = KDomain::GetRange(md, domain);
     const IndexRange block = IndexRange{0, P.GetDim(5) - 1};
-    pmb0->par_for("apply_floors", block.s, block.e, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+    Tiling::par_for("apply_floors", pmb0->exec_space, block.s, block.e, b.ks, b.ke, b.js, b.je, b.is, b.ie,
         KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i) {
-            if (static_cast<int>(fflag(b, 0, k, j, i))) {
+            const int fflag_l = static_cast<int>(fflag(b, 0, k, j, i));
+            if (fflag_l) {
                 const auto& G = P.GetCoords(b);
+                const Real rho_before = U(b, m_u.RHO, k, j, i);
+                const Real uu_before = U(b, m_u.UU, k, j, i);
                 // apply_floors can involve another U_to_P call.  Hide the pflag in bottom 5 bits and retrieve both
                 int pflag_l = 0;
+                const bool reduced = G.r(k, j, i) < r_reduced;
                 // These would be constexpr except Nvidia doesn't like lambda-capture in constexpr ifs
-                if (frame == InjectionFrame::mixed_fluid_normal) {
+                if (reduced) {
+                    pflag_l = apply_floors<InjectionFrame::fluid>(G, P(b), m_p, gam, k, j, i,
+                                        floor_vals(b, rhofi, k, j, i), floor_vals(b, ufi, k, j, i),
+                                        U(b), m_u);
+                } else if (frame == InjectionFrame::mixed_fluid_normal) {
                     if (G.r(k, j, i) > switch_r) {
                         pflag_l = apply_floors<InjectionFrame::fluid>(G, P(b), m_p, gam, k, j, i,
                                             floor_vals(b, rhofi, k, j, i), floor_vals(b, ufi, k, j, i),
@@ -120,9 +138,14 @@ TaskStatus ApplyFloorsInFrame(MeshData<Real> *md, IndexDomain domain)
 
                 // P->U for any modified zones
                 Flux::p_to_u_mhd(G, P(b), m_p, emhd_params, gam, k, j, i, U(b), m_u, Loci::center);
+
+                if (budget.enabled && !reduced && KDomain::inside(k, j, i, bi))
+                    budget.Add(G, budget.FloorReason(fflag_l), k, j, i,
+                               U(b, m_u.RHO, k, j, i) - rho_before, U(b, m_u.UU, k, j, i) - uu_before);
             }
         }
     );
+    budget.Contribute(pmb0->exec_space);
 
     return TaskStatus::complete;
 }
@@ -36,8 +36,10 @@
 // Most includes are in the header TODO fix?
 
 #include "b_ct.hpp"
+#include "fourth_order.hpp"
 #include "grmhd.hpp"
 #include "kharma.hpp"
+#include "transients.hpp"
 
 using namespace parthenon;
 
@@ -73,14 +75,14 @@ std::shared_ptr<KHARMAPackage> Flux::Initialize(ParameterInput *pin, std::shared
         default_recon_s = pin->GetString("GRMHD", "reconstruction");
     }
     std::vector<std::string> recon_allowed_vals = {"donor_cell", "donor_cell_c", "linear_vl", "linear_mc",
-                                             "weno5", "weno5_linear", "ppm", "ppmx", "mp5"};
+                                             "weno5", "weno5_linear", "weno5_hybrid", "ppm", "ppmx", "mp5"};
     std::string recon = pin->GetOrAddString("flux", "reconstruction", default_recon_s, recon_allowed_vals);
     bool lower_edges = pin->GetOrAddBoolean("flux", "low_order_edges", false);
     bool lower_poles = pin->GetOrAddBoolean("flux", "low_order_poles", false);
     if (lower_edges && lower_poles)
         throw std::runtime_error("Cannot enable lowered reconstruction on edges and poles!");
-    if ((lower_edges || lower_poles) && recon != "weno5")
-        throw std::runtime_error("Lowered reconstructions can only be enabled with weno5!");
+    if ((lower_edges || lower_poles) && recon != "weno5" && recon != "weno5_hybrid")
+        throw std::runtime_error("Lowered reconstructions can only be enabled with weno5 or weno5_hybrid!");
 
     int stencil = 0;
     if (recon == "donor_cell") {
@@ -104,6 +106,15 @@ std::shared_ptr<KHARMAPackage> Flux::Initialize(ParameterInput *pin, std::shared
     } else if (recon == "weno5") {
         params.Add("recon", KReconstruction::Type::weno5);
         stencil = 5;
+    } else if (recon == "weno5_hybrid" && lower_edges) {
+        params.Add("recon", KReconstruction::Type::weno5_hybrid_lower_edges);
+        stencil = 5;
+    } else if (recon == "weno5_hybrid" && lower_poles) {
+        params.Add("recon", KReconstruction::Type::weno5_hybrid_lower_poles);
+        stencil = 5;
+    } else if (recon == "weno5_hybrid") {
+        params.Add("recon", KReconstruction::Type::weno5_hybrid);
+        stencil = 5;
     } else if (recon == "weno5_linear") {
         params.Add("recon", KReconstruction::Type::weno5_linear);
         stencil = 5;
@@ -119,16 +130,39 @@ std::shared_ptr<KHARMAPackage> Flux::Initialize(ParameterInput *pin, std::shared
         params.Add("recon", KReconstruction::Type::mp5);
         stencil = 5;
     }  // we only allow these options
+    if (recon == "weno5_hybrid") {
+        // Zones pass as smooth where the WENO-Z indicator tau5 is below this fraction of the smallest
+        // smoothness indicator beta_k, i.e., where WENO5 weights would be close to optimal.
+        // Smaller is more conservative (more full WENO5), 0 is (nearly) always WENO5
+        Real hybrid_threshold = pin->GetOrAddReal("flux", "hybrid_threshold", 0.5);
+        params.Add("hybrid_threshold", hybrid_threshold);
+    }
     // Warn if using less than 3 ghost zones w/WENO etc, 2 w/Linear, etc.
     // SMR/AMR independently requires an even number of zones, so we usually use 4
     if (Globals::nghost < (stencil/2 + 1)) {
         throw std::runtime_error("Not enough ghost zones for specified reconstruction!");
     }
 
+    // Optional fourth-order finite-volume scheme, see fourth_order.hpp
+    bool fourth_order = pin->GetOrAddBoolean("flux", "fourth_order", false);
+    params.Add("fourth_order", fourth_order);
+    if (fourth_order) {
+        if (stencil < 5)
+            throw std::invalid_argument("Fourth-order fluxes require a fifth-order reconstruction, e.g. weno5!");
+        // The point/average conversions widen each stencil by a zone
+        if (Globals::nghost < (stencil/2 + 2))
+            throw std::runtime_error("Not enough ghost zones for fourth-order fluxes!");
+        // Match the integrator, unless told otherwise
+        const std::string integrator = pin->GetOrAddString("parthenon/time", "integrator", "rk4");
+        if (integrator != "rk4" && MPIRank0())
+            std::cout << "KHARMA WARNING: Fourth-order fluxes with integrator " << integrator
+                      << " will only converge at the integrator's order!" << std::endl;
+    }
+
     // Floors package *has* been initialized if it's going to be
     // Apply floors for high-order reconstructions
     bool default_recon_floors = packages->AllPackages().count("Floors") &&
-                                (recon == "weno5" || recon == "weno5_linear" || recon == "mp5");
+                                (recon == "weno5" || recon == "weno5_linear" || recon == "weno5_hybrid" || recon == "mp5");
     bool reconstruction_floors = pin->GetOrAddBoolean("flux", "reconstruction_floors", default_recon_floors);
     params.Add("reconstruction_floors", reconstruction_floors);
 
@@ -163,6 +197,15 @@ std::shared_ptr<KHARMAPackage> Flux::Initialize(ParameterInput *pin, std::shared
     pkg->AddField("Flux.Ul", m);
     pkg->AddField("Flux.Fr", m);
     pkg->AddField("Flux.Fl", m);
+    if (fourth_order) {
+        // Cell-average primitives for reconstruction, and point conserved variables for inversion.
+        // Neither outlives the call filling it
+        Transients::AddField(pkg, pin, "Flux.P_avg", m, Transients::Phase::flux, Transients::Phase::flux);
+        Transients::AddField(pkg, pin, "Flux.U_point", m, Transients::Phase::update, Transients::Phase::update);
+        // Point values of the geometric source, to be averaged
+        Transients::AddField(pkg, pin, "Flux.geo_source", Metadata(flags_flux, std::vector<int>({GR_DIM})),
+                             Transients::Phase::sources, Transients::Phase::sources);
+    }
 
     std::vector<int> s_vector({NVEC});
     std::vector<MetadataFlag> flags_speed = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy};
@@ -180,6 +223,8 @@ std::shared_ptr<KHARMAPackage> Flux::Initialize(ParameterInput *pin, std::shared
     }
     bool use_fofc = pin->GetOrAddBoolean("fofc", "on", default_fofc);
     params.Add("use_fofc", use_fofc);
+    if (use_fofc && fourth_order)
+        throw std::invalid_argument("FOFC cannot be used with fourth-order fluxes!");
 
     if (use_fofc) {
         // FOFC-specific options
@@ -419,7 +464,16 @@ void Flux::AddGeoSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain d
     IndexRange3 bd = KDomain::GetRange(md, domain);
     auto block = IndexRange{0, P.GetDim(5)-1};
 
-    pmb0->par_for("tmunu_source", block.s, block.e, bd.ks, bd.ke, bd.js, bd.je, bd.is, bd.ie,
+    // For fourth-order fluxes, record point sources over one more zone (within the block), then add their cell averages
+    const bool fourth_order = pkgs.Get("Flux")->Param<bool>("fourth_order");
+    const IndexRange3 be = KDomain::GetRange(md, IndexDomain::entire);
+    const IndexRange3 bs = (fourth_order) ?
+        IndexRange3{m::max(bd.is - 1, be.is), m::min(bd.ie + 1, be.ie), m::max(bd.js - 1, be.js),
+                    m::min(bd.je + 1, be.je), m::max(bd.ks - 1, be.ks), m::min(bd.ke + 1, be.ke)} : bd;
+    const auto& S = mdudt->PackVariables((fourth_order) ? std::vector<std::string>{Transients::Name("Flux.geo_source")}
+                                                        : std::vector<std::string>{});
+
+    pmb0->par_for("tmunu_source", block.s, block.e, bs.ks, bs.ke, bs.js, bs.je, bs.is, bs.ie,
         KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
             const auto& G = dUdt.GetCoords(b);
             FourVectors D;
@@ -437,10 +491,23 @@ void Flux::AddGeoSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain d
                 }
             }
 
-            dUdt(b, m_u.UU, k, j, i)           += new_du[0];
-            VLOOP dUdt(b, m_u.U1 + v, k, j, i) += new_du[1 + v];
+            if (fourth_order) {
+                for (int lam = 0; lam < GR_DIM; ++lam) S(b, lam, k, j, i) = new_du[lam];
+            } else {
+                dUdt(b, m_u.UU, k, j, i)           += new_du[0];
+                VLOOP dUdt(b, m_u.U1 + v, k, j, i) += new_du[1 + v];
+            }
         }
     );
+
+    if (fourth_order) {
+        pmb0->par_for("tmunu_source_average", block.s, block.e, bd.ks, bd.ke, bd.js, bd.je, bd.is, bd.ie,
+            KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
+                dUdt(b, m_u.UU, k, j, i) += S(b, 0, k, j, i) + Laplacian<0>(S(b), 0, k, j, i, bs) / 24.;
+                VLOOP dUdt(b, m_u.U1 + v, k, j, i) += S(b, 1 + v, k, j, i) + Laplacian<0>(S(b), 1 + v, k, j, i, bs) / 24.;
+            }
+        );
+    }
 }
 
 TaskStatus Flux::CheckCtop(MeshData<Real> *md)
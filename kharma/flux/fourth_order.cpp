@@ -0,0 +1,86 @@
+/* 
+ *  File: fourth_order.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fourth_order.hpp"
+
+#include "domain.hpp"
+#include "tiling.hpp"
+#include "transients.hpp"
+
+TaskStatus Flux::PrimsToAverage(MeshData<Real> *md)
+{
+    Flag("PrimsToAverage");
+    const auto& P     = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive"), Metadata::Cell});
+    const auto& P_avg = md->PackVariables(std::vector<std::string>{Transients::Name("Flux.P_avg")});
+
+    // Reconstruction reads P over the whole block
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::entire);
+    const IndexRange block = IndexRange{0, P.GetDim(5) - 1};
+    const int nprim = P.GetDim(4);
+
+    Tiling::par_for("prims_to_average", DevExecSpace(), block.s, block.e, 0, nprim - 1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int& bl, const int& p, const int& k, const int& j, const int& i) {
+            P_avg(bl, p, k, j, i) = P(bl, p, k, j, i) + Laplacian<0>(P(bl), p, k, j, i, b) / 24.;
+        }
+    );
+
+    EndFlag();
+    return TaskStatus::complete;
+}
+
+TaskStatus Flux::ConsToAverage(MeshData<Real> *md)
+{
+    Flag("ConsToAverage");
+    const auto& U       = md->PackVariables(std::vector<MetadataFlag>{Metadata::Conserved, Metadata::Cell});
+    // Not otherwise in use during initialization
+    const auto& U_point = md->PackVariables(std::vector<std::string>{Transients::Name("Flux.U_point")});
+
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::entire);
+    const IndexRange block = IndexRange{0, U.GetDim(5) - 1};
+    const int nvar = U.GetDim(4);
+
+    Tiling::par_for("cons_copy_point", DevExecSpace(), block.s, block.e, 0, nvar - 1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int& bl, const int& p, const int& k, const int& j, const int& i) {
+            U_point(bl, p, k, j, i) = U(bl, p, k, j, i);
+        }
+    );
+    Tiling::par_for("cons_to_average", DevExecSpace(), block.s, block.e, 0, nvar - 1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int& bl, const int& p, const int& k, const int& j, const int& i) {
+            U(bl, p, k, j, i) = U_point(bl, p, k, j, i) + Laplacian<0>(U_point(bl), p, k, j, i, b) / 24.;
+        }
+    );
+
+    EndFlag();
+    return TaskStatus::complete;
+}
@@ -0,0 +1,109 @@
+/* 
+ *  File: fourth_order.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * Fourth-order finite-volume path, enabled with flux/fourth_order=true.  Following McCorquodale & Colella 2011
+ * and Felker & Stone 2018, conserved variables are treated as cell averages, and primitives as point values
+ * at zone centers.  Each stage then:
+ * 1. Inverts point conserved values U - (1/24) Lap U, giving point primitives (see Inverter::BlockUtoP)
+ * 2. Reconstructs face averages from the cell averages P + (1/24) Lap P (Flux::PrimsToAverage)
+ * 3. Converts reconstructed face averages to face points before computing fluxes (GetFlux)
+ * 4. Takes the face-average flux F + (1/24) Lap_perp F in the divergence (KHARMADriver::FluxDivergence)
+ * 5. Adds the cell average of the geometric source, S + (1/24) Lap S (Flux::AddGeoSource)
+ * With a fourth-order reconstruction (weno5, mp5, ppm) and integrator (rk4), smooth flows converge at 4th order.
+ *
+ * Point/average conversions use ghost zones, so only the outermost ghost zone of each block is truncated;
+ * GetFlux reconstructs an extra transverse row so that the fluxes read by FaceAverageFlux are fully corrected.
+ * Several pieces of KHARMA remain second order: magnetic field transport (both CT schemes), floors,
+ * and the other packages' U->P.
+ * All grids are uniform in native coordinates, so Laplacians are just undivided second differences.
+ */
+namespace Flux {
+
+/**
+ * Undivided Laplacian of v(p) at a zone (or face) k, j, i, in all directions except 'skip_dir'
+ * (use 0 for the full Laplacian).  Directions in which the stencil would leave the range b are skipped,
+ * as are directions beyond NDIM, at compile time.
+ */
+template<int skip_dir, int NDIM=3, typename V>
+KOKKOS_FORCEINLINE_FUNCTION Real Laplacian(const V& v, const int& p, const int& k, const int& j, const int& i,
+                                           const IndexRange3& b)
+{
+    Real lap = 0.;
+    if (skip_dir != X1DIR && i > b.is && i < b.ie)
+        lap += v(p, k, j, i + 1) - 2.*v(p, k, j, i) + v(p, k, j, i - 1);
+    if (skip_dir != X2DIR && NDIM > 1 && j > b.js && j < b.je)
+        lap += v(p, k, j + 1, i) - 2.*v(p, k, j, i) + v(p, k, j - 1, i);
+    if (skip_dir != X3DIR && NDIM > 2 && k > b.ks && k < b.ke)
+        lap += v(p, k + 1, j, i) - 2.*v(p, k, j, i) + v(p, k - 1, j, i);
+    return lap;
+}
+
+/**
+ * Face-averaged flux through face k, j, i in direction dir, from the point fluxes stored in v
+ * (or just the stored flux, if !FourthOrder).  Fluxes are always calculated one face beyond
+ * the interior in the transverse directions, and their point values corrected using one more
+ * (see GetFlux), so this is valid everywhere we take the divergence
+ */
+template<int dir, int NDIM, bool FourthOrder, typename T>
+KOKKOS_FORCEINLINE_FUNCTION Real FaceAverageFlux(const T& v, const int& l, const int& k, const int& j, const int& i)
+{
+    const Real F = v.flux(dir, l, k, j, i);
+    if constexpr (!FourthOrder) return F;
+    Real lap = 0.;
+    if constexpr (dir != X1DIR)
+        lap += v.flux(dir, l, k, j, i + 1) - 2.*F + v.flux(dir, l, k, j, i - 1);
+    if constexpr (dir != X2DIR && NDIM > 1)
+        lap += v.flux(dir, l, k, j + 1, i) - 2.*F + v.flux(dir, l, k, j - 1, i);
+    if constexpr (dir != X3DIR && NDIM > 2)
+        lap += v.flux(dir, l, k + 1, j, i) - 2.*F + v.flux(dir, l, k - 1, j, i);
+    return F + lap / 24.;
+}
+
+/**
+ * Fill Flux.P_avg with cell averages of the primitive variables, for reconstruction.
+ */
+TaskStatus PrimsToAverage(MeshData<Real> *md);
+
+/**
+ * Convert freshly-initialized conserved variables, which are point values, into cell averages.
+ * Called once from PostInitialize, not on restarts.
+ */
+TaskStatus ConsToAverage(MeshData<Real> *md);
+
+}
@@ -37,6 +37,9 @@
 
 #include "domain.hpp"
 #include "floors_functions.hpp"
+#include "fourth_order.hpp"
+#include "roofline.hpp"
+#include "transients.hpp"
 
 namespace Flux {
 
@@ -56,18 +59,17 @@ namespace Flux {
  * need fluxes in three directions, we can recompile the function for every combination.
  * This allows some extra optimization from knowing that dir != 0 in parcticular, and inlining
  * the particular reconstruction call we need.
+ * It is also templated on the mesh dimension NDIM, chosen by GetFlux below, so that lower-dimensional
+ * runs compile out the transverse work: the X3 (X2) terms of the fourth-order corrections, and the
+ * trivial k loop of the Riemann solve.
  */
-template <KReconstruction::Type Recon, int dir>
-inline TaskStatus GetFlux(MeshData<Real> *md)
+template <KReconstruction::Type Recon, int dir, int NDIM>
+inline TaskStatus GetFluxDim(MeshData<Real> *md)
 {
+    static_assert(dir <= NDIM, "No fluxes in trivial directions!");
     // Pointers
-    auto pmesh = md->GetMeshPointer();
     auto pmb0  = md->GetBlockData(0)->GetBlockPointer();
     auto& packages = pmb0->packages;
-    // Exit on trivial operations
-    const int ndim = pmesh->ndim;
-    if (ndim < 3 && dir == X3DIR) return TaskStatus::complete;
-    if (ndim < 2 && dir == X2DIR) return TaskStatus::complete;
 
     Flag("GetFlux_"+std::to_string(dir));
 
@@ -91,6 +93,8 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
     const Floors::Prescription& floors_inner = floors_inner_temp;
 
     const bool reconstruction_fallback = pars.Get<bool>("reconstruction_fallback");
+    const Real hybrid_threshold = (KReconstruction::is_hybrid(Recon)) ? pars.Get<Real>("hybrid_threshold") : 0.;
+    const bool fourth_order = pars.Get<bool>("fourth_order");
 
     const Real gam = mhd_pars.Get<Real>("gamma");
 
@@ -118,10 +122,22 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
     const auto& Ur_all = md->PackVariables(std::vector<std::string>{"Flux.Ur"});
     const auto& Fl_all = md->PackVariables(std::vector<std::string>{"Flux.Fl"});
     const auto& Fr_all = md->PackVariables(std::vector<std::string>{"Flux.Fr"});
+    // The fourth-order scheme reconstructs face averages from cell averages, see fourth_order.hpp
+    const auto& P_recon = (fourth_order) ? md->PackVariables(std::vector<std::string>{Transients::Name("Flux.P_avg")})
+                                         : P_all;
 
     // Get the domain size
     // We need fluxes outside the domain for flux-CT and FOFC: one extra zone update on each side
     const IndexRange3 b = KDomain::GetRange(md, IndexDomain::interior, FaceOf(dir), -1, 1);
+    // The fourth-order face averages of those outermost fluxes need their point values corrected in turn,
+    // so reconstruct one further row in each transverse direction, see fourth_order.hpp
+    IndexRange3 br = b;
+    if (fourth_order) {
+        const IndexRange3 bw = KDomain::GetRange(md, IndexDomain::interior, FaceOf(dir), -2, 2);
+        if constexpr (dir != X1DIR) { br.is = bw.is; br.ie = bw.ie; }
+        if constexpr (dir != X2DIR) { br.js = bw.js; br.je = bw.je; }
+        if constexpr (dir != X3DIR) { br.ks = bw.ks; br.ke = bw.ke; }
+    }
     // Get other sizes we need
     const int n1 = pmb0->cellbounds.ncellsi(IndexDomain::entire);
     const IndexRange block = IndexRange{0, cmax.GetDim(5) - 1};
@@ -141,16 +157,36 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
     // Allocate enough to cache prims, conserved, and fluxes, for left and right faces,
     // plus temporaries inside reconstruction (most use none, donor_cell uses one, linear_vl uses a bunch)
     using RType = KReconstruction::Type;
+    // Hybrid WENO uses two more lines, to flag smooth zones
     const size_t recon_scratch_bytes = (4 + 1*(Recon == RType::donor_cell) +
                                             5*(Recon == RType::linear_vl)) * var_size_in_bytes +
-                                        line_size_in_bytes;
+                                        (1 + 2*KReconstruction::is_hybrid(Recon)) * line_size_in_bytes;
     const size_t flux_scratch_bytes = 3 * var_size_in_bytes;
 
+    // Rough per-zone work estimates, if we're profiling kernels.  See roofline.hpp
+    if (Roofline::Enabled()) {
+        const double nzones = static_cast<double>(block.e - block.s + 1) * (b.ke - b.ks + 1)
+                                                    * (b.je - b.js + 1) * (b.ie - b.is + 1);
+        const int nprim = P_all.GetDim(4);
+        const double recon_flops = (Recon == RType::donor_cell || Recon == RType::donor_cell_c) ? 0. :
+                                   (Recon == RType::linear_vl || Recon == RType::linear_mc) ? 12. :
+                                   (Recon == RType::ppm || Recon == RType::ppmx) ? 60. :
+                                   (Recon == RType::mp5) ? 120. : 90.; // WENO5 variants
+        // Stencil reads of P are mostly cached: count one read, plus the writes of Pl, Pr
+        Roofline::AddWork("calc_flux_recon", nzones, 8. * 3 * nprim, recon_flops * nprim);
+        // Read P & face geometry (gcon, gcov, gdet), write U, F, cmax/cmin.
+        // FLOPs are mostly in calc_4vecs, prim_to_flux & vchar
+        Roofline::AddWork("calc_flux_left", nzones, 8. * (nprim + 21 + 2*nvar + 2), 400. + 10.*nvar);
+        Roofline::AddWork("calc_flux_right", nzones, 8. * (nprim + 21 + 2*nvar + 4), 400. + 10.*nvar);
+        // Per variable: read Fl, Fr, Ul, Ur, cmax, cmin, write the flux
+        Roofline::AddWork((use_hlle) ? "flux_hlle" : "flux_llf", nzones * nvar, 8. * 7, (use_hlle) ? 8. : 6.);
+    }
+
     // This isn't a pmb0->par_for_outer because Parthenon's current overloaded definitions
     // do not accept three pairs of bounds, which we need in order to iterate over blocks
     Flag("GetFlux_"+std::to_string(dir)+"_recon");
     parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "calc_flux_recon", pmb0->exec_space,
-        recon_scratch_bytes, scratch_level, block.s, block.e, b.ks, b.ke, b.js, b.je,
+        recon_scratch_bytes, scratch_level, block.s, block.e, br.ks, br.ke, br.js, br.je,
         KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& bl, const int& k, const int& j) {
             const auto& G = U_all.GetCoords(bl);
             ScratchPad2D<Real> Pl_s(member.team_scratch(scratch_level), nvar, n1);
@@ -162,12 +198,17 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
             // We template on reconstruction type to avoid a big switch statement here.
             // Instead, a version of GetFlux() is generated separately for each reconstruction/direction pair.
             // See reconstruction.hpp for all the implementations.
-            KReconstruction::ReconstructRow<Recon, dir>(member, P_all(bl), k, j, b.is, b.ie, Pl_s, Pr_s);
+            if constexpr (KReconstruction::is_hybrid(Recon)) {
+                KReconstruction::ReconstructRowHybrid<Recon, dir>(member, P_recon(bl), m_p.RHO, m_p.UU, hybrid_threshold,
+                                                                  k, j, br.is, br.ie, Pl_s, Pr_s);
+            } else {
+                KReconstruction::ReconstructRow<Recon, dir>(member, P_recon(bl), k, j, br.is, br.ie, Pl_s, Pr_s);
+            }
 
             // Sync all threads in the team so that scratch memory is consistent
             member.team_barrier();
 
-            parthenon::par_for_inner(member, b.is, b.ie,
+            parthenon::par_for_inner(member, br.is, br.ie,
                 [&](const int& i) {
                     auto Pl = Kokkos::subview(Pl_s, Kokkos::ALL(), i);
                     auto Pr = Kokkos::subview(Pr_s, Kokkos::ALL(), i);
@@ -184,10 +225,10 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
 
             if (reconstruction_fallback) {
                 // TODO without the whole thing again? Also, option of scheme?
-                KReconstruction::ReconstructRow<RType::ppm, dir>(member, P_all(bl), k, j, b.is, b.ie, Plf_s, Prf_s);
+                KReconstruction::ReconstructRow<RType::ppm, dir>(member, P_recon(bl), k, j, br.is, br.ie, Plf_s, Prf_s);
                 member.team_barrier();
                 for (int p = 0; p <= P_all.GetDim(4) - 1; ++p) {
-                    parthenon::par_for_inner(member, b.is, b.ie,
+                    parthenon::par_for_inner(member, br.is, br.ie,
                         [&](const int& i) {
                             if (fallback_tvd(i)) {
                                 Pl_s(p, i) = Plf_s(p, i);
@@ -201,7 +242,7 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
 
             // Copy out state (TODO(BSP) eliminate)
             for (int p=0; p < nvar; ++p) {
-                parthenon::par_for_inner(member, b.is, b.ie,
+                parthenon::par_for_inner(member, br.is, br.ie,
                     [&](const int& i) {
                         Pl_all(bl, p, k, j, i) = Pl_s(p, i);
                         Pr_all(bl, p, k, j, i) = Pr_s(p, i);
@@ -246,7 +287,9 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
             for (int p=0; p < nvar; ++p) {
                 parthenon::par_for_inner(member, b.is, b.ie,
                     [&](const int& i) {
-                        Pl_s(p, i) = Pl_all(bl, p, k, j, i);
+                        // Face averages -> face points, for the fourth-order scheme
+                        Pl_s(p, i) = (fourth_order) ? Pl_all(bl, p, k, j, i) - Laplacian<dir, NDIM>(Pl_all(bl), p, k, j, i, br) / 24.
+                                                    : Pl_all(bl, p, k, j, i);
                     }
                 );
             }
@@ -303,7 +346,8 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
             for (int p=0; p < nvar; ++p) {
                 parthenon::par_for_inner(member, b.is, b.ie,
                     [&](const int& i) {
-                        Pr_s(p, i) = Pr_all(bl, p, k, j, i);
+                        Pr_s(p, i) = (fourth_order) ? Pr_all(bl, p, k, j, i) - Laplacian<dir, NDIM>(Pr_all(bl), p, k, j, i, br) / 24.
+                                                    : Pr_all(bl, p, k, j, i);
                     }
                 );
             }
@@ -349,20 +393,24 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
 
     // Apply what we've calculated
     Flag("GetFlux_"+std::to_string(dir)+"_riemann");
-    if (use_hlle) { // More fluxes would need a template
-        pmb0->par_for("flux_hlle", block.s, block.e, 0, nvar-1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
-            KOKKOS_LAMBDA(const int& bl, const int& p, const int& k, const int& j, const int& i) {
-                U_all(bl).flux(dir, p, k, j, i) = hlle(Fl_all(bl, p, k, j, i), Fr_all(bl, p, k, j, i),
-                                                      cmax(bl, dir-1, k, j, i), cmin(bl, dir-1, k, j, i),
-                                                      Ul_all(bl, p, k, j, i), Ur_all(bl, p, k, j, i));
-            }
-        );
+    const auto riemann = KOKKOS_LAMBDA(const int& bl, const int& p, const int& k, const int& j, const int& i) {
+        U_all(bl).flux(dir, p, k, j, i) = (use_hlle) ? // More fluxes would need a template
+            hlle(Fl_all(bl, p, k, j, i), Fr_all(bl, p, k, j, i),
+                 cmax(bl, dir-1, k, j, i), cmin(bl, dir-1, k, j, i),
+                 Ul_all(bl, p, k, j, i), Ur_all(bl, p, k, j, i)) :
+            llf(Fl_all(bl, p, k, j, i), Fr_all(bl, p, k, j, i),
+                cmax(bl, dir-1, k, j, i), cmin(bl, dir-1, k, j, i),
+                Ul_all(bl, p, k, j, i), Ur_all(bl, p, k, j, i));
+    };
+    if constexpr (NDIM > 2) {
+        pmb0->par_for((use_hlle) ? "flux_hlle" : "flux_llf", block.s, block.e, 0, nvar-1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+                      riemann);
     } else {
-        pmb0->par_for("flux_llf", block.s, block.e, 0, nvar-1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
-            KOKKOS_LAMBDA(const int& bl, const int& p, const int& k, const int& j, const int& i) {
-                U_all(bl).flux(dir, p, k, j, i) = llf(Fl_all(bl, p, k, j, i), Fr_all(bl, p, k, j, i),
-                                                     cmax(bl, dir-1, k, j, i), cmin(bl, dir-1, k, j, i),
-                                                     Ul_all(bl, p, k, j, i), Ur_all(bl, p, k, j, i));
+        // Lower-dimensional runs have a single k
+        const int k = b.ks;
+        pmb0->par_for((use_hlle) ? "flux_hlle" : "flux_llf", block.s, block.e, 0, nvar-1, b.js, b.je, b.is, b.ie,
+            KOKKOS_LAMBDA(const int& bl, const int& p, const int& j, const int& i) {
+                riemann(bl, p, k, j, i);
             }
         );
     }
@@ -372,4 +420,29 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
     return TaskStatus::complete;
 }
 
+/**
+ * Calculate fluxes in direction 'dir' with reconstruction 'Recon', see GetFluxDim above.
+ * Fluxes in trivial directions are skipped.
+ */
+template <KReconstruction::Type Recon, int dir>
+inline TaskStatus GetFlux(MeshData<Real> *md)
+{
+    const int ndim = md->GetMeshPointer()->ndim;
+    if (ndim < dir) return TaskStatus::complete;
+    if constexpr (dir == X3DIR) {
+        return GetFluxDim<Recon, dir, 3>(md);
+    } else if constexpr (dir == X2DIR) {
+        return (ndim > 2) ? GetFluxDim<Recon, dir, 3>(md) : GetFluxDim<Recon, dir, 2>(md);
+    } else {
+        switch (ndim) {
+        case 1:
+            return GetFluxDim<Recon, dir, 1>(md);
+        case 2:
+            return GetFluxDim<Recon, dir, 2>(md);
+        default:
+            return GetFluxDim<Recon, dir, 3>(md);
+        }
+    }
+}
+
 } // Flux
@@ -46,7 +46,16 @@ namespace KReconstruction
 constexpr Real EPS = 1.e-26;
 
 // Enum for all supported reconstruction types.
-enum class Type{donor_cell=0, donor_cell_c, linear_mc, linear_vl, ppm, ppmx, mp5, weno5, weno5_lower_edges, weno5_lower_poles, weno5_linear};
+enum class Type{donor_cell=0, donor_cell_c, linear_mc, linear_vl, ppm, ppmx, mp5, weno5, weno5_lower_edges, weno5_lower_poles, weno5_linear,
+                 weno5_hybrid, weno5_hybrid_lower_edges, weno5_hybrid_lower_poles, poly5};
+
+// Whether a reconstruction switches per-zone between WENO5 and its fixed-weight (linear) version.
+// These are run with ReconstructRowHybrid, rather than ReconstructRow
+KOKKOS_FORCEINLINE_FUNCTION constexpr bool is_hybrid(const Type recon_type)
+{
+    return recon_type == Type::weno5_hybrid || recon_type == Type::weno5_hybrid_lower_edges ||
+           recon_type == Type::weno5_hybrid_lower_poles;
+}
 
 // Component functions
 KOKKOS_FORCEINLINE_FUNCTION Real mc(const Real dm, const Real dp)
@@ -203,6 +212,46 @@ KOKKOS_FORCEINLINE_FUNCTION void reconstruct_right<Type::weno5>(RECONSTRUCT_ONE_
             ((3./8.)*x3 + (3./4.)*x4 - (1./8.)*x5)*(wtr[2] / Wr);
 }
 
+// Fixed-weight 5th-order reconstruction: WENO5 with the optimal weights (1/16, 5/8, 5/16), which it
+// approaches in smooth flows.  Not TVD or otherwise limited, so only used where flagged smooth, see below
+template<>
+KOKKOS_FORCEINLINE_FUNCTION void reconstruct<Type::poly5>(RECONSTRUCT_ONE_ARGS)
+{
+    lout = (3.*x5 - 20.*x4 + 90.*x3 + 60.*x2 - 5.*x1) * (1./128.);
+    rout = (3.*x1 - 20.*x2 + 90.*x3 + 60.*x4 - 5.*x5) * (1./128.);
+}
+template<>
+KOKKOS_FORCEINLINE_FUNCTION void reconstruct_left<Type::poly5>(RECONSTRUCT_ONE_LEFT_ARGS)
+{
+    lout = (3.*x5 - 20.*x4 + 90.*x3 + 60.*x2 - 5.*x1) * (1./128.);
+}
+template<>
+KOKKOS_FORCEINLINE_FUNCTION void reconstruct_right<Type::poly5>(RECONSTRUCT_ONE_RIGHT_ARGS)
+{
+    rout = (3.*x1 - 20.*x2 + 90.*x3 + 60.*x4 - 5.*x5) * (1./128.);
+}
+
+/**
+ * Smoothness test for hybrid WENO5, using the WENO-Z global indicator tau5 = |beta2 - beta0|
+ * (Borges et al. 2008).  tau5 is O(dx^5) in smooth flows even at extrema, vs. O(jump^2)
+ * across discontinuities, so comparing it to the smallest beta tells whether the nonlinear
+ * weights would differ appreciably from the optimal ones.
+ * Variations below ~1e-6 of the central value are ignored, as they are for the WENO weights themselves.
+ */
+KOKKOS_FORCEINLINE_FUNCTION bool weno5_smooth(const Real& x1, const Real& x2, const Real& x3, const Real& x4, const Real& x5,
+                                              const Real& tol)
+{
+    Real beta[3], c1, c2;
+    c1 = x1 - 2.*x2 + x3; c2 = x1 - 4.*x2 + 3.*x3;
+    beta[0] = (13./12.)*c1*c1 + (1./4.)*c2*c2;
+    c1 = x2 - 2.*x3 + x4; c2 = x4 - x2;
+    beta[1] = (13./12.)*c1*c1 + (1./4.)*c2*c2;
+    c1 = x3 - 2.*x4 + x5; c2 = x5 - 4.*x4 + 3.*x3;
+    beta[2] = (13./12.)*c1*c1 + (1./4.)*c2*c2;
+    const Real tau5 = m::abs(beta[2] - beta[0]);
+    return tau5 <= tol * (m::min(beta[0], m::min(beta[1], beta[2])) + 1.e-12*x3*x3 + EPS);
+}
+
 // Linearized WENO, stolen from Phoebus
 // Note lout/rout are SWITCHED until output to aid comparison with Phoebus,
 // which uses the opposite L/R convention in per-zone calculations
@@ -770,6 +819,132 @@ KOKKOS_FORCEINLINE_FUNCTION void ReconstructRow<Type::weno5_lower_poles, X3DIR>(
     }
 }
 
+// Hybrid WENO5:
+// Flag each zone as smooth or not based on its density and internal energy stencils, then use
+// fixed-weight poly5 for smooth zones and full WENO5 for the rest.  Rows which are entirely smooth
+// (or entirely not) skip the per-zone selection.
+// The lower_edges/lower_poles variants keep the same linear_mc regions as their WENO5 counterparts.
+template <Type smooth_type, Type rough_type>
+KOKKOS_FORCEINLINE_FUNCTION void reconstruct_select(const int& smooth, RECONSTRUCT_ONE_ARGS)
+{
+    if (smooth) reconstruct<smooth_type>(x1, x2, x3, x4, x5, lout, rout);
+    else reconstruct<rough_type>(x1, x2, x3, x4, x5, lout, rout);
+}
+template <Type smooth_type, Type rough_type>
+KOKKOS_FORCEINLINE_FUNCTION void reconstruct_select_left(const int& smooth, RECONSTRUCT_ONE_LEFT_ARGS)
+{
+    if (smooth) reconstruct_left<smooth_type>(x1, x2, x3, x4, x5, lout);
+    else reconstruct_left<rough_type>(x1, x2, x3, x4, x5, lout);
+}
+template <Type smooth_type, Type rough_type>
+KOKKOS_FORCEINLINE_FUNCTION void reconstruct_select_right(const int& smooth, RECONSTRUCT_ONE_RIGHT_ARGS)
+{
+    if (smooth) reconstruct_right<smooth_type>(x1, x2, x3, x4, x5, rout);
+    else reconstruct_right<rough_type>(x1, x2, x3, x4, x5, rout);
+}
+
+/**
+ * Reconstruct a row, choosing per-zone based on 'smooth'.
+ * smooth(0, i) refers to zone i in X1, or to the zone at j-1 (k-1) supplying ql in X2 (X3).
+ * smooth(1, i) refers to the zone at j (k) supplying qr.
+ */
+template <Type smooth_type, Type rough_type, int dir>
+KOKKOS_FORCEINLINE_FUNCTION void ReconstructRowSelect(parthenon::team_mbr_t& member, const VariablePack<Real> &q,
+                                        const int& k, const int& j, const int& il, const int& iu,
+                                        const ScratchPad2D<int>& smooth, ScratchPad2D<Real> ql, ScratchPad2D<Real> qr)
+{
+    for (int p = 0; p <= q.GetDim(4) - 1; ++p) {
+        parthenon::par_for_inner(member, il, iu,
+            KOKKOS_LAMBDA (const int& i) {
+                if constexpr (dir == X1DIR) {
+                    reconstruct_select<smooth_type, rough_type>(smooth(0, i),
+                        q(p, k, j, i - 2), q(p, k, j, i - 1), q(p, k, j, i), q(p, k, j, i + 1), q(p, k, j, i + 2),
+                        qr(p, i), ql(p, i+1));
+                } else if constexpr (dir == X2DIR) {
+                    reconstruct_select_right<smooth_type, rough_type>(smooth(0, i),
+                        q(p, k, j - 3, i), q(p, k, j - 2, i), q(p, k, j - 1, i), q(p, k, j, i), q(p, k, j + 1, i),
+                        ql(p, i));
+                    reconstruct_select_left<smooth_type, rough_type>(smooth(1, i),
+                        q(p, k, j - 2, i), q(p, k, j - 1, i), q(p, k, j, i), q(p, k, j + 1, i), q(p, k, j + 2, i),
+                        qr(p, i));
+                } else {
+                    reconstruct_select_right<smooth_type, rough_type>(smooth(0, i),
+                        q(p, k - 3, j, i), q(p, k - 2, j, i), q(p, k - 1, j, i), q(p, k, j, i), q(p, k + 1, j, i),
+                        ql(p, i));
+                    reconstruct_select_left<smooth_type, rough_type>(smooth(1, i),
+                        q(p, k - 2, j, i), q(p, k - 1, j, i), q(p, k, j, i), q(p, k + 1, j, i), q(p, k + 2, j, i),
+                        qr(p, i));
+                }
+            }
+        );
+    }
+}
+
+/**
+ * Hybrid WENO5 row reconstruction.  Needs the indices of the variables to test for smoothness,
+ * 'p_rho' and 'p_u', the threshold 'tol' for weno5_smooth, and two rows of integer scratch.
+ */
+template <Type recon_type, int dir>
+KOKKOS_FORCEINLINE_FUNCTION void ReconstructRowHybrid(parthenon::team_mbr_t& member, const VariablePack<Real> &P,
+                                        const int& p_rho, const int& p_u, const Real& tol,
+                                        const int& k, const int& j, const int& is_l, const int& ie_l,
+                                        ScratchPad2D<Real> ql, ScratchPad2D<Real> qr)
+{
+    // Same rows as weno5_lower_poles are entirely linear
+    if constexpr (recon_type == Type::weno5_hybrid_lower_poles) {
+        constexpr int o = 6;
+        if (!(j > o && j < P.GetDim(2) - o)) {
+            ReconstructRow<Type::linear_mc, dir>(member, P, k, j, is_l, ie_l, ql, qr);
+            return;
+        }
+    }
+    // Same X1 faces as weno5_lower_edges are linear
+    int is_h = is_l, ie_h = ie_l;
+    if constexpr (recon_type == Type::weno5_hybrid_lower_edges && dir == X1DIR) {
+        constexpr int o = 5;
+        ReconstructX1<Type::linear_mc>(member, k, j, is_l, is_l+o-1, P, ql, qr);
+        ReconstructX1<Type::linear_mc>(member, k, j, ie_l-o+1, ie_l, P, ql, qr);
+        is_h = is_l + o;
+        ie_h = ie_l - o;
+    }
+
+    // Flag smooth zones, and count the rest
+    ScratchPad2D<int> smooth(member.team_scratch(1), 2, P.GetDim(1));
+    int nrough = 0;
+    Kokkos::Sum<int> sum_reducer(nrough);
+    parthenon::par_reduce_inner(member, is_h, ie_h,
+        [&](const int& i, int& local_rough) {
+            if constexpr (dir == X1DIR) {
+                smooth(0, i) = weno5_smooth(P(p_rho, k, j, i-2), P(p_rho, k, j, i-1), P(p_rho, k, j, i),
+                                            P(p_rho, k, j, i+1), P(p_rho, k, j, i+2), tol) &&
+                               weno5_smooth(P(p_u, k, j, i-2), P(p_u, k, j, i-1), P(p_u, k, j, i),
+                                            P(p_u, k, j, i+1), P(p_u, k, j, i+2), tol);
+                smooth(1, i) = smooth(0, i);
+            } else {
+                constexpr int dj = (dir == X2DIR), dk = (dir == X3DIR);
+                for (int s = 0; s < 2; ++s) {
+                    // Zone supplying ql is one behind
+                    const int kz = k - (1 - s)*dk, jz = j - (1 - s)*dj;
+                    smooth(s, i) = weno5_smooth(P(p_rho, kz-2*dk, jz-2*dj, i), P(p_rho, kz-dk, jz-dj, i), P(p_rho, kz, jz, i),
+                                                P(p_rho, kz+dk, jz+dj, i), P(p_rho, kz+2*dk, jz+2*dj, i), tol) &&
+                                   weno5_smooth(P(p_u, kz-2*dk, jz-2*dj, i), P(p_u, kz-dk, jz-dj, i), P(p_u, kz, jz, i),
+                                                P(p_u, kz+dk, jz+dj, i), P(p_u, kz+2*dk, jz+2*dj, i), tol);
+                }
+            }
+            local_rough += !smooth(0, i) + !smooth(1, i);
+        }
+    , sum_reducer);
+    member.team_barrier();
+
+    if (nrough == 0) {
+        ReconstructRow<Type::poly5, dir>(member, P, k, j, is_h, ie_h, ql, qr);
+    } else if (nrough == 2 * (ie_h - is_h + 1)) {
+        ReconstructRow<Type::weno5, dir>(member, P, k, j, is_h, ie_h, ql, qr);
+    } else {
+        ReconstructRowSelect<Type::poly5, Type::weno5, dir>(member, P, k, j, is_h, ie_h, smooth, ql, qr);
+    }
+}
+
 /**
  * Versions computing just the (limited) slope, for linear reconstructions.
  * Used for gradient calculations needed to implement Extended GRMHD.
@@ -48,6 +48,7 @@
 #include "inverter.hpp"
 #include "kharma.hpp"
 #include "kharma_driver.hpp"
+#include "polar_filter.hpp"
 
 #include <memory>
 
@@ -299,6 +300,9 @@ Real EstimateTimestep(MeshData<Real> *md)
 
     // TODO version preserving location, with switch to keep this fast one
     // TODO maybe split normal, ISMR timesteps? Excised pole/recalculated ctop too?
+    // Rings near the pole are filtered to the X3 resolution at the filter edge, see polar_filter.hpp
+    const Real sin_filter = pmesh->packages.Get("Driver")->Param<Real>("polar_filter_sin");
+    const int n3 = b.ke - b.ks + 1;
     double min_ndt = std::numeric_limits<double>::max();
     for (auto &pmb : pmesh->block_list) {
         auto rc = pmb->meshblock_data.Get().get();
@@ -315,11 +319,12 @@ Real EstimateTimestep(MeshData<Real> *md)
                         double &local_result) {
                 const auto& G = cmax.GetCoords();
                 int ismr_factor = 1;
+                const Real polar_factor = (sin_filter > 0.) ? PolarFilter::WidthFactor(G.th(k, j, i), sin_filter, n3) : 1.;
                 double courant_limit = 1.0;
 
                 double ndt_zone = courant_limit / (1 / (G.Dxc<1>(i) /  m::max(cmax(V1, k, j, i), cmin(V1, k, j, i))) +
                                     1 / (G.Dxc<2>(j) /  m::max(cmax(V2, k, j, i), cmin(V2, k, j, i))) +
-                                    1 / (G.Dxc<3>(k) * ismr_factor /  m::max(cmax(V3, k, j, i), cmin(V3, k, j, i))));
+                                    1 / (G.Dxc<3>(k) * ismr_factor * polar_factor /  m::max(cmax(V3, k, j, i), cmin(V3, k, j, i))));
 
                 if (!m::isnan(ndt_zone) && (ndt_zone < local_result)) {
                     local_result = ndt_zone;
@@ -41,70 +41,75 @@
 #define NFVAR_MAX 10
 
 // TODO(BSP) should merge this with FixUtoP by generalizing that
-TaskStatus Implicit::FixSolve(MeshBlockData<Real> *mbd) {
+TaskStatus Implicit::FixSolve(MeshData<Real> *md) {
 
     Flag("FixSolve");
-    // Get MeshBlock pointer and obtain flag for primitives
-    auto pmb = mbd->GetBlockPointer();
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+
+    // Since we're after sync, we run over the entire domain
+    // Rather than checking every zone, list just the failed ones.  Usually there are none.
+    // Remember "failed" here has a different implementation
+    const auto fails = KDomain::ListZones(md, "solve_fail", false,
+                            KOKKOS_LAMBDA (const Real &solve_fail_l) { return failed(solve_fail_l); });
+    if (fails.n == 0) {
+        EndFlag();
+        return TaskStatus::complete;
+    }
+    const auto zones = fails.zones;
+    const auto ranges = fails.ranges;
 
     // Get number of implicit variables
     PackIndexMap implicit_prims_map;
-    auto implicit_vars = Implicit::GetOrderedNames(mbd, Metadata::GetUserFlag("Primitive"), true);
-    auto& P            = mbd->PackVariables(implicit_vars, implicit_prims_map);
+    auto implicit_vars = Implicit::GetOrderedNames(md->GetBlockData(0).get(), Metadata::GetUserFlag("Primitive"), true);
+    auto& P            = md->PackVariables(implicit_vars, implicit_prims_map);
     const int nfvar    = P.GetDim(4);
 
-    // Since we're after sync, we run over the entire domain
-    const IndexRange3 b = KDomain::GetRange(mbd, IndexDomain::entire);
-    const auto& G = pmb->coords;
-
-    GridScalar solve_fail = mbd->Get("solve_fail").data;
-
-    const Real gam    = pmb->packages.Get("GRMHD")->Param<Real>("gamma");
-    const int flag_verbose = pmb->packages.Get("Globals")->Param<int>("flag_verbose");
-
-    pmb->par_for("fix_solver_failures", b.ks, b.ke, b.js, b.je, b.is, b.ie,
-        KOKKOS_LAMBDA (const int& k, const int& j, const int& i) {
-            // Fix only bad zones
-            // Remember "failed" here has a different implementation
-            if (failed(solve_fail(k, j, i))) {
-                //printf("Fixing zone %d %d %d!\n", i, j, k);
-                double wsum = 0., wsum_x = 0.;
-                double sum[NFVAR_MAX] = {0.}, sum_x[NFVAR_MAX] = {0.};
-                // For all neighboring cells...
-                for (int n = -1; n <= 1; n++) {
-                    for (int m = -1; m <= 1; m++) {
-                        for (int l = -1; l <= 1; l++) {
-                            int ii = i + l, jj = j + m, kk = k + n;
-                            // If we haven't overstepped array bounds...
-                            if (KDomain::inside(kk, jj, ii, b)) {
-                                // Weight by distance
-                                // TODO abs(l) == l*l always?
-                                double w = 1./(m::abs(l) + m::abs(m) + m::abs(n) + 1);
-
-                                // Count only the good cells, if we can
-                                if (!failed(solve_fail(kk, jj, ii))) {
-                                    // Weight by distance.  Note interpolated "fixed" cells stay flagged
-                                    wsum += w;
-                                    FLOOP sum[ip] += w * P(ip, kk, jj, ii);
-                                }
-                                // Just in case, keep a sum of even the bad ones
-                                wsum_x += w;
-                                FLOOP sum_x[ip] += w * P(ip, kk, jj, ii);
+    auto solve_fail = md->PackVariables(std::vector<std::string>{"solve_fail"});
+
+    const Real gam    = pmb0->packages.Get("GRMHD")->Param<Real>("gamma");
+    const int flag_verbose = pmb0->packages.Get("Globals")->Param<int>("flag_verbose");
+
+    pmb0->par_for("fix_solver_failures", 0, fails.n - 1,
+        KOKKOS_LAMBDA (const int& z) {
+            const int bl = zones(4*z), k = zones(4*z + 1), j = zones(4*z + 2), i = zones(4*z + 3);
+            const IndexRange3 b = KDomain::ListedRange(ranges, bl);
+            //printf("Fixing zone %d %d %d!\n", i, j, k);
+            double wsum = 0., wsum_x = 0.;
+            double sum[NFVAR_MAX] = {0.}, sum_x[NFVAR_MAX] = {0.};
+            // For all neighboring cells...
+            for (int n = -1; n <= 1; n++) {
+                for (int m = -1; m <= 1; m++) {
+                    for (int l = -1; l <= 1; l++) {
+                        int ii = i + l, jj = j + m, kk = k + n;
+                        // If we haven't overstepped array bounds...
+                        if (KDomain::inside(kk, jj, ii, b)) {
+                            // Weight by distance
+                            // TODO abs(l) == l*l always?
+                            double w = 1./(m::abs(l) + m::abs(m) + m::abs(n) + 1);
+
+                            // Count only the good cells, if we can
+                            if (!failed(solve_fail(bl, 0, kk, jj, ii))) {
+                                // Weight by distance.  Note interpolated "fixed" cells stay flagged
+                                wsum += w;
+                                FLOOP sum[ip] += w * P(bl, ip, kk, jj, ii);
                             }
+                            // Just in case, keep a sum of even the bad ones
+                            wsum_x += w;
+                            FLOOP sum_x[ip] += w * P(bl, ip, kk, jj, ii);
                         }
                     }
                 }
+            }
 
-                if(wsum < 1.e-10) {
-                    // TODO probably should crash here.
+            if(wsum < 1.e-10) {
+                // TODO probably should crash here.
 #ifndef KOKKOS_ENABLE_SYCL
-                    if (flag_verbose >= 3) // && KDomain::inside(k, j, i, kb_b, jb_b, ib_b)) // If an interior zone...
-                        printf("No neighbors were available at %d %d %d!\n", i, j, k);
+                if (flag_verbose >= 3) // && KDomain::inside(k, j, i, kb_b, jb_b, ib_b)) // If an interior zone...
+                    printf("No neighbors were available at %d %d %d!\n", i, j, k);
 #endif
-                    FLOOP P(ip, k, j, i) = sum_x[ip]/wsum_x;
-                } else {
-                    FLOOP P(ip, k, j, i) = sum[ip]/wsum;
-                }
+                FLOOP P(bl, ip, k, j, i) = sum_x[ip]/wsum_x;
+            } else {
+                FLOOP P(bl, ip, k, j, i) = sum[ip]/wsum;
             }
         }
     );
@@ -113,19 +118,31 @@ TaskStatus Implicit::FixSolve(MeshBlockData<Real> *mbd) {
     // Compute new conserved variables
     // TODO encapsulate version from FixUtoP & try calling whole thing here?
     PackIndexMap prims_map, cons_map;
-    auto& P_all = mbd->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive")}, prims_map);
-    auto& U_all = mbd->PackVariables(std::vector<MetadataFlag>{Metadata::Conserved}, cons_map);
+    auto& P_all = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive")}, prims_map);
+    auto& U_all = md->PackVariables(std::vector<MetadataFlag>{Metadata::Conserved}, cons_map);
     const VarMap m_u(cons_map, true), m_p(prims_map, false);
 
     // Need emhd_params object
-    const EMHD::EMHD_parameters emhd_params = EMHD::GetEMHDParameters(pmb->packages);
-
-    pmb->par_for("fix_solver_failures_PtoU", b.ks, b.ke, b.js, b.je, b.is, b.ie,
-        KOKKOS_LAMBDA (const int& k, const int& j, const int& i) {
-            if (failed(solve_fail(k, j, i)))
-                Flux::p_to_u(G, P_all, m_p, emhd_params, gam, k, j, i, U_all, m_u);
+    const EMHD::EMHD_parameters emhd_params = EMHD::GetEMHDParameters(pmb0->packages);
+
+    // Tally the change in interior zones, see Floors::Budget
+    Floors::Budget budget = Floors::GetBudget(pmb0->packages);
+    const IndexRange3 bi = KDomain::GetRange(md, IndexDomain::interior);
+
+    pmb0->par_for("fix_solver_failures_PtoU", 0, fails.n - 1,
+        KOKKOS_LAMBDA (const int& z) {
+            const int bl = zones(4*z), k = zones(4*z + 1), j = zones(4*z + 2), i = zones(4*z + 3);
+            const auto& G = P_all.GetCoords(bl);
+            const Real rho_before = U_all(bl, m_u.RHO, k, j, i);
+            const Real uu_before = U_all(bl, m_u.UU, k, j, i);
+            Flux::p_to_u(G, P_all(bl), m_p, emhd_params, gam, k, j, i, U_all(bl), m_u);
+
+            if (budget.enabled && KDomain::inside(k, j, i, bi))
+                budget.Add(G, Floors::Budget::SOLVE_FIXUP, k, j, i,
+                           U_all(bl, m_u.RHO, k, j, i) - rho_before, U_all(bl, m_u.UU, k, j, i) - uu_before);
         }
     );
+    budget.Contribute(pmb0->exec_space);
 
     EndFlag();
     return TaskStatus::complete;
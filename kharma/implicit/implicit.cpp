@@ -34,11 +34,15 @@
 
 #include "implicit.hpp"
 
+#include "domain.hpp"
 #include "grmhd.hpp"
 #include "grmhd_functions.hpp"
+#include "inverter.hpp"
 #include "kharma.hpp"
 #include "pack.hpp"
 #include "reductions.hpp"
+#include "roofline.hpp"
+#include "transients.hpp"
 #include "types.hpp"
 
 #if DISABLE_IMPLICIT
@@ -50,6 +54,8 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
 // We still need a stub for Step() in order to compile, but it will never be called
 TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
                 MeshData<Real> *md_linesearch, MeshData<Real> *md_solver, const Real& dt) {}
+TaskStatus Implicit::ReducedWorkUpdate(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
+                                       MeshData<Real> *md_solver, const Real gam0, const Real gam1, const Real beta_dt) {}
 
 #else
 
@@ -61,6 +67,24 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
 #include <KokkosBatched_Trsv_Decl.hpp>
 #include <KokkosBatched_ApplyPivot_Decl.hpp>
 
+/**
+ * Solve A x = b in place in x, given the output of SerialQR (A, t, p) and a workspace w.
+ * Used to re-apply a single-precision factorization during iterative refinement.
+ */
+template<typename MatT, typename VecT, typename PivT, typename WorkT>
+KOKKOS_INLINE_FUNCTION void qr_solve_factored(const MatT& A, const VecT& t, const PivT& p, const WorkT& w, const VecT& x)
+{
+    const typename MatT::non_const_value_type one(1.0);
+    KokkosBatched::SerialApplyQ<KokkosBatched::Side::Left, KokkosBatched::Trans::Transpose,
+                                KokkosBatched::Algo::ApplyQ::Unblocked>
+    ::invoke(A, t, x, w);
+    KokkosBatched::SerialTrsv<KokkosBatched::Uplo::Upper, KokkosBatched::Trans::NoTranspose,
+                              KokkosBatched::Diag::NonUnit, KokkosBatched::Algo::Trsv::Unblocked>
+    ::invoke(one, A, x);
+    KokkosBatched::SerialApplyPivot<KokkosBatched::Side::Left,KokkosBatched::Direct::Backward>
+    ::invoke(p, x);
+}
+
 std::vector<std::string> Implicit::GetOrderedNames(MeshBlockData<Real> *rc, const MetadataFlag& flag, bool only_implicit)
 {
     auto pmb0 = rc->GetBlockPointer();
@@ -87,6 +111,54 @@ int Implicit::CountSolverFails(MeshData<Real> *md)
     return Reductions::CountFlags(md, "solve_fail", Implicit::status_names, IndexDomain::interior, false)[0];
 }
 
+TaskStatus Implicit::ReducedWorkUpdate(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
+                                       MeshData<Real> *md_solver, const Real gam0, const Real gam1, const Real beta_dt)
+{
+    auto pmb0 = md_solver->GetBlockData(0)->GetBlockPointer();
+    const Real r_reduced = pmb0->packages.Get("Globals")->Param<Real>("reduced_work_r");
+    if (r_reduced <= 0.) return TaskStatus::complete;
+
+    Flag("ReducedWorkUpdate");
+    // Same flags in each container, so the same map applies to all of them
+    PackIndexMap cons_map, prims_map;
+    auto U_full_step_init = GRMHD::PackMHDCons(md_full_step_init, cons_map);
+    auto U_sub_step_init = GRMHD::PackMHDCons(md_sub_step_init, cons_map);
+    auto flux_src = GRMHD::PackMHDCons(md_flux_src, cons_map);
+    auto U_solver = GRMHD::PackMHDCons(md_solver, cons_map);
+    auto P_solver = GRMHD::PackHDPrims(md_solver, prims_map);
+    const VarMap m_u(cons_map, true), m_p(prims_map, false);
+
+    const Real gam = pmb0->packages.Get("GRMHD")->Param<Real>("gamma");
+    // Floors are applied after the step, as everywhere else
+    const Floors::Prescription no_floors = {0};
+
+    // Same zones the solver skips, see Step
+    const IndexRange3 b = KDomain::GetRange(md_solver, IndexDomain::interior);
+    const IndexRange block = IndexRange{0, U_solver.GetDim(5) - 1};
+    pmb0->par_for("implicit_reduced_work_update", block.s, block.e, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int& bl, const int& k, const int& j, const int& i) {
+            const auto& G = U_solver.GetCoords(bl);
+            if (G.r(k, j, i) < r_reduced) {
+                // The update AddStateUpdateIdealGuess makes over the whole grid with emhd/ideal_guess.
+                // B is explicit, and was already updated along with the other explicit variables
+                const int hd_vars[5] = {m_u.RHO, m_u.UU, m_u.U1, m_u.U1 + 1, m_u.U1 + 2};
+                for (int p = 0; p < 5; ++p) {
+                    const int ip = hd_vars[p];
+                    U_solver(bl, ip, k, j, i) = gam0 * U_sub_step_init(bl, ip, k, j, i) + gam1 * U_full_step_init(bl, ip, k, j, i)
+                                                + beta_dt * flux_src(bl, ip, k, j, i);
+                }
+                // Starting from the sub-step's primitives, already copied in as the solver guess.
+                // A failure here keeps them, as a failed UtoP would
+                Inverter::u_to_p<Inverter::Type::onedw>(G, U_solver(bl), m_u, gam, k, j, i, P_solver(bl), m_p,
+                                                        Loci::center, no_floors, 8, 1e-8);
+            }
+        }
+    );
+    EndFlag();
+
+    return TaskStatus::complete;
+}
+
 std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
 {
     auto pkg = std::make_shared<KHARMAPackage>("Implicit");
@@ -108,6 +180,17 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
     // The alternative LU decomposition does not, and should mostly be used for debugging.
     bool use_qr = pin->GetOrAddBoolean("implicit", "use_qr", true);
     params.Add("use_qr", use_qr);
+    // Factorize the Jacobian and solve for the Newton step in single precision, then recover full accuracy
+    // with a few rounds of iterative refinement against the double-precision Jacobian & residual.
+    // The Jacobian is still assembled in double, since the finite-difference delta is below float epsilon.
+    // Refinement needs that double Jacobian, so the float copies are extra: this uses ~1.5x the solver
+    // scratch memory, trading it for a faster factorization
+    bool mixed_precision = pin->GetOrAddBoolean("implicit", "mixed_precision", false);
+    params.Add("mixed_precision", mixed_precision);
+    int refinement_iter = pin->GetOrAddInteger("implicit", "refinement_iter", 2);
+    params.Add("refinement_iter", refinement_iter);
+    if (mixed_precision && !use_qr)
+        throw std::invalid_argument("Mixed-precision implicit solve is only implemented with implicit/use_qr=true!");
 
     bool linesearch = pin->GetOrAddBoolean("implicit", "linesearch", true);
     params.Add("linesearch", linesearch);
@@ -135,9 +218,9 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
     pkg->AddField("Implicit.dU_implicit", m);
 
     // Allocate additional fields that reflect the success of the solver
-    // L2 norm of the residual
+    // L2 norm of the residual.  Only written for output, so live only during the solve unless requested
     Metadata m_real = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy});
-    pkg->AddField("solve_norm", m_real);
+    Transients::AddField(pkg, pin, "solve_norm", m_real, Transients::Phase::update, Transients::Phase::update);
     // Integer field that saves where the solver fails (rho + drho < 0 || u + du < 0)
     m_real = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy, Metadata::FillGhost});
     pkg->AddField("solve_fail", m_real); // TODO: Replace with m_int once Integer is supported for CellVariable
@@ -174,9 +257,12 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     const Real delta         = implicit_par.Get<Real>("jacobian_delta");
     const Real rootfind_tol  = implicit_par.Get<Real>("rootfind_tol");
     const bool use_qr        = implicit_par.Get<bool>("use_qr");
+    const bool mixed_precision = implicit_par.Get<bool>("mixed_precision");
+    const int refinement_iter  = implicit_par.Get<int>("refinement_iter");
     const auto& globals      = pmb_full_step_init->packages.Get("Globals")->AllParams();
     const int verbose        = globals.Get<int>("verbose");
     const int flag_verbose   = globals.Get<int>("flag_verbose");
+    const Real r_reduced     = globals.Get<Real>("reduced_work_r");
     const Real gam           = pmb_full_step_init->packages.Get("GRMHD")->Param<Real>("gamma");
 
     const bool linesearch         = implicit_par.Get<bool>("linesearch");
@@ -237,7 +323,7 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     const int nfvar = P_full_step_init_implicit.GetDim(4);
 
     // Pull fields associated with the solver's performance
-    auto& solve_norm_all = md_solver->PackVariables(std::vector<std::string>{"solve_norm"});
+    auto& solve_norm_all = md_solver->PackVariables(std::vector<std::string>{Transients::Name("solve_norm")});
     auto& solve_fail_all = md_solver->PackVariables(std::vector<std::string>{"solve_fail"});
 
     auto& jacobian_all = md_solver->PackVariables(std::vector<std::string>{"Implicit.jacobian"});
@@ -274,7 +360,29 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     const size_t tensor_size_in_bytes = parthenon::ScratchPad3D<Real>::shmem_size(n1, nfvar, nfvar);
     const size_t fvar_size_in_bytes   = parthenon::ScratchPad2D<Real>::shmem_size(n1, nfvar);
     const size_t fvar_int_size_in_bytes = parthenon::ScratchPad2D<int>::shmem_size(n1, nfvar);
-    const size_t total_scratch_bytes = tensor_size_in_bytes + 4 * fvar_size_in_bytes + fvar_int_size_in_bytes;
+    // Single-precision copies of the Jacobian, step, QR transform & workspace, if solving in mixed precision
+    const size_t mixed_scratch_bytes = (mixed_precision) ?
+                                        parthenon::ScratchPad3D<float>::shmem_size(n1, nfvar, nfvar) +
+                                        2 * parthenon::ScratchPad2D<float>::shmem_size(n1, nfvar) +
+                                        parthenon::ScratchPad2D<float>::shmem_size(n1, 2*nfvar) : 0;
+    const size_t total_scratch_bytes = tensor_size_in_bytes + 4 * fvar_size_in_bytes + fvar_int_size_in_bytes
+                                       + mixed_scratch_bytes;
+
+    // Zones deep inside the EH keep the explicit ideal MHD update we were given, either as the guess
+    // or by ReducedWorkUpdate, with no viscosity or conduction, and are left out of the iterations below
+    if (r_reduced > 0.) {
+        pmb_solver->par_for("implicit_reduced_work", block.s, block.e, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+            KOKKOS_LAMBDA(const int& b, const int& k, const int& j, const int& i) {
+                const auto& G = U_full_step_init_all.GetCoords(b);
+                if (G.r(k, j, i) < r_reduced) {
+                    solve_fail_all(b, 0, k, j, i) = SolverStatusR::skipped;
+                    solve_norm_all(b, 0, k, j, i) = 0.;
+                    if (m_p.Q >= 0) P_solver_all(b, m_p.Q, k, j, i) = 0.;
+                    if (m_p.DP >= 0) P_solver_all(b, m_p.DP, k, j, i) = 0.;
+                }
+            }
+        );
+    }
 
     // Iterate.  This loop is outside the kokkos kernel in order to print max_norm
     // There are generally a low and similar number of iterations between
@@ -282,6 +390,12 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     for (int iter=1; iter <= iter_max; ++iter) {
         // Flags per iter, since debugging here will be rampant
         Flag("ImplicitIteration_"+std::to_string(iter));
+        // Rough per-zone work, for kernel profiling: read each state & source, geometry,
+        // write Jacobian, residual & new state.  FLOPs are (nfvar+1) residuals for the
+        // finite-difference Jacobian, plus the dense LU solve
+        Roofline::AddWork("implicit_solve", static_cast<double>(nblock) * (kb.e - kb.s + 1) * (jb.e - jb.s + 1) * (ib.e - ib.s + 1),
+                          8. * (7*nvar + 21 + nfvar*nfvar + nfvar + 2),
+                          (nfvar + 1) * (200. + 10.*nvar) + 2./3 * nfvar * nfvar * nfvar);
 
 #if SPLIT_IMPLICIT_SOLVE
         pmb_solver->par_for("implicit_jacobian",
@@ -300,7 +414,7 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                 Real &solve_fail = solve_fail_all(b, 0, k, j, i);
 
                 // Perform the solve only if it hadn't failed in any of the previous iterations.
-                if (solve_fail != SolverStatusR::fail) {
+                if (solving(solve_fail)) {
                     // Now that we know that it isn't a bad zone, reset solve_fail for this iteration
                     solve_fail = SolverStatusR::converged;
 
@@ -359,7 +473,43 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                 member.team_barrier();
 
                 // TODO(BSP) even still worth keeping non-QR version?  Much less stable
-                if (use_qr) {
+                if (mixed_precision) {
+                    ScratchPad3D<float> jacobian_fs(member.team_scratch(scratch_level), n1, nfvar, nfvar);
+                    ScratchPad2D<float> correction_fs(member.team_scratch(scratch_level), n1, nfvar);
+                    ScratchPad2D<float> trans_fs(member.team_scratch(scratch_level), n1, nfvar);
+                    ScratchPad2D<float> work_fs(member.team_scratch(scratch_level), n1, 2*nfvar);
+                    parthenon::par_for_inner(member, ib.s, ib.e,
+                        [&](const int& i) {
+                            // Solver variables
+                            auto jacobian_f = Kokkos::subview(jacobian_fs, i, Kokkos::ALL(), Kokkos::ALL());
+                            auto correction = Kokkos::subview(correction_fs, i, Kokkos::ALL());
+                            auto trans      = Kokkos::subview(trans_fs, i, Kokkos::ALL());
+                            auto work       = Kokkos::subview(work_fs, i, Kokkos::ALL());
+                            auto pivot      = Kokkos::subview(pivot_s, i, Kokkos::ALL());
+
+                            if (solving(solve_fail_all(b, 0, k, j, i))) {
+                                // Factorize once in single precision, and take a first step with it
+                                FLOOP2 jacobian_f(ip, jp) = static_cast<float>(jacobian_s(i, ip, jp));
+                                KokkosBatched::SerialQR<KokkosBatched::Algo::QR::Unblocked>::invoke(jacobian_f, trans, pivot, work);
+                                FLOOP correction(ip) = static_cast<float>(delta_prim_s(i, ip));
+                                qr_solve_factored(jacobian_f, trans, pivot, work, correction);
+                                FLOOP delta_prim_s(i, ip) = correction(ip);
+                                // Iterative refinement: the linear residual is computed in double precision
+                                // with the unrounded Jacobian, and only its correction is solved in single
+                                for (int refine = 0; refine < refinement_iter; ++refine) {
+                                    FLOOP {
+                                        Real linear_residual = -residual_all(b)(ip, k, j, i);
+                                        for (int jp = 0; jp < nfvar; ++jp)
+                                            linear_residual -= jacobian_s(i, ip, jp) * delta_prim_s(i, jp);
+                                        correction(ip) = static_cast<float>(linear_residual);
+                                    }
+                                    qr_solve_factored(jacobian_f, trans, pivot, work, correction);
+                                    FLOOP delta_prim_s(i, ip) += correction(ip);
+                                }
+                            }
+                        }
+                    );
+                } else if (use_qr) {
                     parthenon::par_for_inner(member, ib.s, ib.e,
                         [&](const int& i) {
                             // Solver variables
@@ -369,7 +519,7 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                             auto trans      = Kokkos::subview(trans_s, i, Kokkos::ALL());
                             auto work       = Kokkos::subview(work_s, i, Kokkos::ALL());
 
-                            if (solve_fail_all(b, 0, k, j, i) != SolverStatusR::fail) {
+                            if (solving(solve_fail_all(b, 0, k, j, i))) {
                                 // Linear solve by QR decomposition
                                 KokkosBatched::SerialQR<KokkosBatched::Algo::QR::Unblocked>::invoke(jacobian, trans, pivot, work);
                                 KokkosBatched::SerialApplyQ<KokkosBatched::Side::Left, KokkosBatched::Trans::Transpose,
@@ -391,7 +541,7 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                             auto jacobian   = Kokkos::subview(jacobian_s, i, Kokkos::ALL(), Kokkos::ALL());
                             auto delta_prim = Kokkos::subview(delta_prim_s, i, Kokkos::ALL());
 
-                            if (solve_fail_all(b, 0, k, j, i) != SolverStatusR::fail) {
+                            if (solving(solve_fail_all(b, 0, k, j, i))) {
                                 KokkosBatched::SerialLU<KokkosBatched::Algo::LU::Unblocked>::invoke(jacobian, tiny);
                                 KokkosBatched::SerialTrsv<KokkosBatched::Uplo::Upper, KokkosBatched::Trans::NoTranspose, 
                                                         KokkosBatched::Diag::NonUnit, KokkosBatched::Algo::Trsv::Unblocked>
@@ -428,7 +578,7 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                 Real &solve_norm = solve_norm_all(b, 0, k, j, i);
                 Real &solve_fail = solve_fail_all(b, 0, k, j, i);
 
-                if (solve_fail == SolverStatusR::fail) return;
+                if (!solving(solve_fail)) return;
 
                 // Copy `solver` prims to `linesearch`. This doesn't matter for the first step of the solver
                 // since we do a copy in imex_driver just before, but it is required for the subsequent
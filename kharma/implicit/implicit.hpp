@@ -60,8 +60,10 @@ namespace Implicit
 // `fail`: manual backtracking wasn't good enough. FixSolve will be called
 // `beyond_tol`: solver didn't converge to prescribed tolerance but didn't fail
 // `backtrack`: step length of 1 gave negative rho/uu, but manual backtracking (0.1) sufficed
-enum class SolverStatus{converged=0, fail, beyond_tol, backtrack};
+// `skipped`: zone inside Globals "reduced_work_r", kept the explicit ideal MHD update.  Not counted as a failure
+enum class SolverStatus{skipped=-1, converged=0, fail, beyond_tol, backtrack};
 namespace SolverStatusR {
+    static constexpr Real skipped = -1.0;
     static constexpr Real converged = 0.0;
     static constexpr Real fail = 1.0;
     static constexpr Real beyond_tol = 2.0;
@@ -69,6 +71,7 @@ namespace SolverStatusR {
 }
 
 static const std::map<int, std::string> status_names = {
+    {(int) SolverStatus::skipped, "skipped"},
     {(int) SolverStatus::fail, "failed"},
     {(int) SolverStatus::beyond_tol, "beyond tolerance"},
     {(int) SolverStatus::backtrack, "backtrack"}
@@ -81,6 +84,14 @@ KOKKOS_INLINE_FUNCTION bool failed(T status_flag)
     return static_cast<int>(status_flag) == static_cast<int>(SolverStatus::fail);
 }
 
+template <typename T>
+KOKKOS_INLINE_FUNCTION bool solving(T status_flag)
+{
+    // Return zones which are still being iterated
+    return static_cast<int>(status_flag) != static_cast<int>(SolverStatus::fail) &&
+           static_cast<int>(status_flag) != static_cast<int>(SolverStatus::skipped);
+}
+
 /**
  * Initialization.  Set parameters.
  */
@@ -99,6 +110,15 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
 TaskStatus Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
                 MeshData<Real> *md_linesearch, MeshData<Real> *md_solver, const Real& dt);
 
+/**
+ * Give zones inside Globals "reduced_work_r", which Step skips, the explicit ideal MHD update in md_solver.
+ * Only needed when emhd/ideal_guess doesn't already give it to the whole grid.
+ * Applies the same weights as the explicit update, gam0 * U_sub_step_init + gam1 * U_full_step_init + beta_dt * flux_src,
+ * then recovers the GRMHD primitives, starting from the guess already in md_solver.
+ */
+TaskStatus ReducedWorkUpdate(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
+                             MeshData<Real> *md_solver, const Real gam0, const Real gam1, const Real beta_dt);
+
 /**
  * Get the names of all variables matching 'flag' in a deterministic order, placing implicitly-evolved variables first.
  */
@@ -107,18 +127,13 @@ std::vector<std::string> GetOrderedNames(MeshBlockData<Real> *rc, const Metadata
 
 /**
  * @brief Fix bad zones that the implicit solver couldn't integrate. Similar to GRMHD::FixUtoP
+ * Runs only over a compacted list of failed zones across all blocks in md.
  * 
- * @param mbd relevant fluid state
+ * @param md relevant fluid state
  * @return TaskStatus 
  */
-TaskStatus FixSolve(MeshBlockData<Real> *mbd);
-inline TaskStatus MeshFixSolve(MeshData<Real> *md) {
-    Flag("MeshFixSolve");
-    for (int i=0; i < md->NumBlocks(); ++i)
-        FixSolve(md->GetBlockData(i).get());
-    EndFlag();
-    return TaskStatus::complete;
-}
+TaskStatus FixSolve(MeshData<Real> *md);
+inline TaskStatus MeshFixSolve(MeshData<Real> *md) { return FixSolve(md); }
 
 /**
  * Count up all nonzero solver flags on md.  Used for history file reductions.
@@ -44,112 +44,121 @@
 #define NPRIM 5
 #define PRIMLOOP for(int p=0; p < NPRIM; ++p)
 
-TaskStatus Inverter::FixUtoP(MeshBlockData<Real> *rc)
+TaskStatus Inverter::FixUtoP(MeshData<Real> *md)
 {
     // We expect primitives all the way out to 3 ghost zones on all sides.
     // But we can only fix primitives with their neighbors.
     // This may actually mean we require the 4 ghost zones Parthenon "wants" us to have,
     // if we need to use only fixed zones.
-    auto pmb = rc->GetBlockPointer();
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
     // Bail if we're not enabled
-    const bool fix_average = pmb->packages.Get("Inverter")->Param<bool>("fix_average_neighbors");
-    const bool fix_atmo = pmb->packages.Get("Inverter")->Param<bool>("fix_atmosphere");
+    const bool fix_average = pmb0->packages.Get("Inverter")->Param<bool>("fix_average_neighbors");
+    const bool fix_atmo = pmb0->packages.Get("Inverter")->Param<bool>("fix_atmosphere");
     if (!fix_average && !fix_atmo) return TaskStatus::complete;
 
     Flag("Inverter::FixUtoP");
+    // UtoP is applied and fixed over all "Physical" zones -- anything in the domain,
+    // OR in an MPI boundary.  This is because it is applied *after* the MPI sync,
+    // but before physical boundary zones are computed (which it should never use anyway)
+    // Rather than checking every zone, list just the failed ones.  Usually there are none.
+    const auto fails = KDomain::ListZones(md, "pflag", true,
+                            KOKKOS_LAMBDA (const Real &pflag_l) { return failed(pflag_l); });
+    if (fails.n == 0) {
+        EndFlag();
+        return TaskStatus::complete;
+    }
+    const auto zones = fails.zones;
+    const auto ranges = fails.ranges;
+
     // Only fixup the core 5 prims TODO build by flag, HD + anything implicit
-    auto P = GRMHD::PackHDPrims(rc);
+    PackIndexMap hd_map;
+    auto P = GRMHD::PackHDPrims(md, hd_map);
 
-    GridScalar pflag = rc->Get("pflag").data;
+    auto pflag = md->PackVariables(std::vector<std::string>{"pflag"});
 
-    const auto& pars = pmb->packages.Get("GRMHD")->AllParams();
+    const auto& pars = pmb0->packages.Get("GRMHD")->AllParams();
     const Real gam = pars.Get<Real>("gamma");
 
-    // Only yell about neighbors on extreme verbosity.
-    const int flag_verbose = pmb->packages.Get("Globals")->Param<int>("flag_verbose");
-
-    // UtoP is applied and fixed over all "Physical" zones -- anything in the domain,
-    // OR in an MPI boundary.  This is because it is applied *after* the MPI sync,
-    // but before physical boundary zones are computed (which it should never use anyway)
-
-    const IndexRange3 b = KDomain::GetPhysicalRange(rc);
-
-    const auto& G = pmb->coords;
-
-    pmb->par_for("fix_U_to_P", b.ks, b.ke, b.js, b.je, b.is, b.ie,
-        KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
-            if (failed(pflag(k, j, i))) {
-                double wsum = 0.;
-                double sum[NPRIM] = {0.};
-                if (fix_average) {
-                    // Luckily fixups are rare, so we don't have to worry about optimizing this *too* much
-                    // For all neighboring cells...
-                    for (int n = -1; n <= 1; n++) {
-                        for (int m = -1; m <= 1; m++) {
-                            for (int l = -1; l <= 1; l++) {
-                                int ii = i + l, jj = j + m, kk = k + n;
-                                // If we haven't overstepped array bounds...
-                                if (KDomain::inside(kk, jj, ii, b)) {
-                                    // Count only the good cells (not failed AND not corner), if we can
-                                    // Note interpolated "fixed" cells stay flagged
-                                    if (!failed(pflag(kk, jj, ii))) {
-                                        // Weight by distance
-                                        double w = 1./(m::abs(l) + m::abs(m) + m::abs(n) + 1);
-                                        wsum += w;
-                                        PRIMLOOP sum[p] += w * P(p, kk, jj, ii);
-                                    }
+    pmb0->par_for("fix_U_to_P", 0, fails.n - 1,
+        KOKKOS_LAMBDA (const int &z) {
+            const int bl = zones(4*z), k = zones(4*z + 1), j = zones(4*z + 2), i = zones(4*z + 3);
+            const IndexRange3 b = KDomain::ListedRange(ranges, bl);
+            double wsum = 0.;
+            double sum[NPRIM] = {0.};
+            if (fix_average) {
+                // Luckily fixups are rare, so we don't have to worry about optimizing this *too* much
+                // For all neighboring cells...
+                for (int n = -1; n <= 1; n++) {
+                    for (int m = -1; m <= 1; m++) {
+                        for (int l = -1; l <= 1; l++) {
+                            int ii = i + l, jj = j + m, kk = k + n;
+                            // If we haven't overstepped array bounds...
+                            if (KDomain::inside(kk, jj, ii, b)) {
+                                // Count only the good cells (not failed AND not corner), if we can
+                                // Note interpolated "fixed" cells stay flagged
+                                if (!failed(pflag(bl, 0, kk, jj, ii))) {
+                                    // Weight by distance
+                                    double w = 1./(m::abs(l) + m::abs(m) + m::abs(n) + 1);
+                                    wsum += w;
+                                    PRIMLOOP sum[p] += w * P(bl, p, kk, jj, ii);
                                 }
                             }
                         }
                     }
                 }
+            }
 
-                // Set to atmosphere/floors, zero velocity
-                // Fallback fix if we're averaging, only fix if not
-                if(wsum < 1.e-10) {
-                    // We fill this with floor values below
-                    PRIMLOOP P(p, k, j, i) = 0.;
-                } else {
-                    PRIMLOOP P(p, k, j, i) = sum[p]/wsum;
-                }
+            // Set to atmosphere/floors, zero velocity
+            // Fallback fix if we're averaging, only fix if not
+            if(wsum < 1.e-10) {
+                // We fill this with floor values below
+                PRIMLOOP P(bl, p, k, j, i) = 0.;
+            } else {
+                PRIMLOOP P(bl, p, k, j, i) = sum[p]/wsum;
             }
         }
     );
 
     // Re-apply floors to fixed zones
     // Use values from floors package if it's enabled, otherwise any we've been asked to apply
-    const Floors::Prescription floors = pmb->packages.AllPackages().count("Floors") ?
-                                        pmb->packages.Get("Floors")->Param<Floors::Prescription>("prescription") :
-                                        pmb->packages.Get("Inverter")->Param<Floors::Prescription>("inverter_prescription");
-    const Floors::Prescription floors_inner = pmb->packages.AllPackages().count("Floors") ?
-                                        pmb->packages.Get("Floors")->Param<Floors::Prescription>("prescription_inner") :
-                                        pmb->packages.Get("Inverter")->Param<Floors::Prescription>("inverter_prescription");
+    const Floors::Prescription floors = pmb0->packages.AllPackages().count("Floors") ?
+                                        pmb0->packages.Get("Floors")->Param<Floors::Prescription>("prescription") :
+                                        pmb0->packages.Get("Inverter")->Param<Floors::Prescription>("inverter_prescription");
+    const Floors::Prescription floors_inner = pmb0->packages.AllPackages().count("Floors") ?
+                                        pmb0->packages.Get("Floors")->Param<Floors::Prescription>("prescription_inner") :
+                                        pmb0->packages.Get("Inverter")->Param<Floors::Prescription>("inverter_prescription");
 
     // We need the full packs of prims/cons for p_to_u
     // Pack new variables
     PackIndexMap prims_map, cons_map;
-    auto U = GRMHD::PackMHDCons(rc, cons_map);
-    P = GRMHD::PackMHDPrims(rc, prims_map);
+    auto U = GRMHD::PackMHDCons(md, cons_map);
+    auto P_mhd = GRMHD::PackMHDPrims(md, prims_map);
     const VarMap m_u(cons_map, true), m_p(prims_map, false);
-    // Get new sizes
-    const int nvar = P.GetDim(4);
-
-    // Get floor flag
-    GridScalar fflag = rc->Get("fflag").data;
-
-    pmb->par_for("fix_U_to_P_floors", b.ks, b.ke, b.js, b.je, b.is, b.ie,
-        KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
-            if (failed(pflag(k, j, i))) {
-                // Make sure all fixed values still abide by floors
-                // TODO Full floors instead of just geo?
-                Floors::apply_geo_floors(G, P, m_p, gam, k, j, i, floors, floors_inner);
-
-                // Make sure to keep lockstep
-                // This will only be run for GRMHD, so we can call its p_to_u
-                GRMHD::p_to_u(G, P, m_p, gam, k, j, i, U, m_u);
-            }
+
+    // Tally the change in interior zones, see Floors::Budget
+    Floors::Budget budget = Floors::GetBudget(pmb0->packages);
+    const IndexRange3 bi = KDomain::GetRange(md, IndexDomain::interior);
+
+    pmb0->par_for("fix_U_to_P_floors", 0, fails.n - 1,
+        KOKKOS_LAMBDA (const int &z) {
+            const int bl = zones(4*z), k = zones(4*z + 1), j = zones(4*z + 2), i = zones(4*z + 3);
+            const auto& G = P_mhd.GetCoords(bl);
+            const Real rho_before = U(bl, m_u.RHO, k, j, i);
+            const Real uu_before = U(bl, m_u.UU, k, j, i);
+            // Make sure all fixed values still abide by floors
+            // TODO Full floors instead of just geo?
+            Floors::apply_geo_floors(G, P_mhd(bl), m_p, gam, k, j, i, floors, floors_inner);
+
+            // Make sure to keep lockstep
+            // This will only be run for GRMHD, so we can call its p_to_u
+            GRMHD::p_to_u(G, P_mhd(bl), m_p, gam, k, j, i, U(bl), m_u);
+
+            if (budget.enabled && KDomain::inside(k, j, i, bi))
+                budget.Add(G, Floors::Budget::UTOP_FIXUP, k, j, i,
+                           U(bl, m_u.RHO, k, j, i) - rho_before, U(bl, m_u.UU, k, j, i) - uu_before);
         }
     );
+    budget.Contribute(pmb0->exec_space);
 
     EndFlag();
     return TaskStatus::complete;
@@ -45,14 +45,18 @@
 
 namespace Inverter {
 
-// Denote inverter types. Currently just one
-enum class Type{none=0, onedw, kastaun};
+// Denote inverter types
+enum class Type{none=0, onedw, kastaun, tiered};
 
 // Denote inversion failures (pflags)
 // This enum should grow to cover any inversion algorithm
-enum class Status{success=0, neg_input, max_iter, bad_ut, bad_gamma, neg_rho, neg_u, neg_rhou};
+// Negative values record successes of the tiered inverter's later tiers: these are neither
+// fixed nor counted as failures, but are counted individually
+enum class Status{hard_tier=-2, fallback_tier=-1, success=0, neg_input, max_iter, bad_ut, bad_gamma, neg_rho, neg_u, neg_rhou};
 
 static const std::map<int, std::string> status_names = {
+    {(int) Status::hard_tier, "Solved by Kastaun (hard zone)"},
+    {(int) Status::fallback_tier, "Solved by Kastaun (1D_W failed)"},
     {(int) Status::neg_input, "Negative input"},
     {(int) Status::max_iter, "Hit max iter"},
     {(int) Status::bad_ut, "Velocity invalid"},
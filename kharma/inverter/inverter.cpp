@@ -36,13 +36,52 @@
 // inverter.hpp includes the template and instantiations in the correct order
 
 #include "domain.hpp"
+#include "fourth_order.hpp"
 #include "reductions.hpp"
+#include "roofline.hpp"
+#include "tiling.hpp"
+#include "transients.hpp"
 
 int Inverter::CountPFlags(MeshData<Real> *md)
 {
     return Reductions::CountFlags(md, "pflag", Inverter::status_names, IndexDomain::interior, false)[0];
 }
 
+namespace {
+
+// Zones solved by the tiered inverter's later tiers, for history files
+int CountTier(MeshData<Real> *md, Inverter::Status tier)
+{
+    const auto counts = Reductions::CountFlags(md, "pflag", Inverter::status_names, IndexDomain::interior, false);
+    // Counts of individual flags follow the total, in the map's order
+    return counts[1 + std::distance(Inverter::status_names.begin(), Inverter::status_names.find((int) tier))];
+}
+int CountFallbackTier(MeshData<Real> *md) { return CountTier(md, Inverter::Status::fallback_tier); }
+int CountHardTier(MeshData<Real> *md) { return CountTier(md, Inverter::Status::hard_tier); }
+
+// Call through to the chosen inverter, which for the tiered inverter also reports the tier used
+template<Inverter::Type inverter>
+KOKKOS_INLINE_FUNCTION int invert_zone(const GRCoordinates& G, const VariablePack<Real>& U, const VarMap& m_u,
+                                       const Real& gam, const int& k, const int& j, const int& i,
+                                       const VariablePack<Real>& P, const VarMap& m_p,
+                                       const Floors::Prescription& floors, const Inverter::TierOptions& tiers,
+                                       const int& max_iterations, const Real& tol, int& tier)
+{
+    tier = 1;
+    return Inverter::u_to_p<inverter>(G, U, m_u, gam, k, j, i, P, m_p, Loci::center, floors, max_iterations, tol);
+}
+template<>
+KOKKOS_INLINE_FUNCTION int invert_zone<Inverter::Type::tiered>(const GRCoordinates& G, const VariablePack<Real>& U, const VarMap& m_u,
+                                       const Real& gam, const int& k, const int& j, const int& i,
+                                       const VariablePack<Real>& P, const VarMap& m_p,
+                                       const Floors::Prescription& floors, const Inverter::TierOptions& tiers,
+                                       const int& max_iterations, const Real& tol, int& tier)
+{
+    return Inverter::u_to_p_tiered(G, U, m_u, gam, k, j, i, P, m_p, Loci::center, floors, tiers, max_iterations, tol, tier);
+}
+
+} // namespace
+
 std::shared_ptr<KHARMAPackage> Inverter::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
 {
     auto pkg = std::make_shared<KHARMAPackage>("Inverter");
@@ -50,14 +89,18 @@ std::shared_ptr<KHARMAPackage> Inverter::Initialize(ParameterInput *pin, std::sh
 
     // Inversion scheme.  Could be separate packages but they do share a lot,
     // and could share more e.g. inline floor applications
-    std::vector<std::string> allowed_inverter_names = {"none", "onedw", "kastaun"};
+    std::vector<std::string> allowed_inverter_names = {"none", "onedw", "kastaun", "tiered"};
     std::string inverter_name = pin->GetOrAddString("inverter", "type", "kastaun", allowed_inverter_names);
+    // The tiered inverter's last resort is Kastaun, so it takes Kastaun's defaults below
     bool use_kastaun = false;
     if (inverter_name == "onedw") {
         params.Add("inverter_type", Type::onedw);
     } else if (inverter_name == "kastaun") {
         params.Add("inverter_type", Type::kastaun);
         use_kastaun = true;
+    } else if (inverter_name == "tiered") {
+        params.Add("inverter_type", Type::tiered);
+        use_kastaun = true;
     } else if (inverter_name == "none") {
         params.Add("inverter_type", Type::none);
     }
@@ -68,6 +111,13 @@ std::shared_ptr<KHARMAPackage> Inverter::Initialize(ParameterInput *pin, std::sh
     params.Add("err_tol", err_tol);
     int iter_max = pin->GetOrAddInteger("inverter", "iter_max", (use_kastaun) ? 25 : 8);
     params.Add("iter_max", iter_max);
+    // The tiered inverter's first tier (1D_W), and which zones skip it.  See tiered.hpp
+    TierOptions tiers;
+    tiers.fast_iter_max = pin->GetOrAddInteger("inverter", "tier1_iter_max", 5);
+    tiers.fast_tol = pin->GetOrAddReal("inverter", "tier1_err_tol", 1e-8);
+    tiers.hard_sigma = pin->GetOrAddReal("inverter", "hard_sigma", 20.);
+    tiers.hard_beta = pin->GetOrAddReal("inverter", "hard_beta", 0.02);
+    params.Add("tiers", tiers);
 
     // Floor options
     // Use a custom block for inverter floors to allow customization.  Not sure anyone *wants* that but...
@@ -117,6 +167,11 @@ std::shared_ptr<KHARMAPackage> Inverter::Initialize(ParameterInput *pin, std::sh
     parthenon::HstVar_list hst_vars = {};
     // Count total floors as a history item
     hst_vars.emplace_back(parthenon::HistoryOutputVar(UserHistoryOperation::sum, CountPFlags, "PFlags"));
+    // And how many zones needed each of the tiered inverter's fallbacks
+    if (inverter_name == "tiered") {
+        hst_vars.emplace_back(parthenon::HistoryOutputVar(UserHistoryOperation::sum, CountFallbackTier, "PFlagsFallbackTier"));
+        hst_vars.emplace_back(parthenon::HistoryOutputVar(UserHistoryOperation::sum, CountHardTier, "PFlagsHardTier"));
+    }
     // TODO entries for each individual flag?
     // add callbacks for HST output to the Params struct, identified by the `hist_param_key`
     pkg->AddParam<>(parthenon::hist_param_key, hst_vars);
@@ -149,6 +204,7 @@ inline void BlockPerformInversion(MeshBlockData<Real> *rc, IndexDomain domain, b
     auto &pars = pmb->packages.Get("Inverter")->AllParams();
     const Real err_tol = pars.Get<Real>("err_tol");
     const int iter_max = pars.Get<int>("iter_max");
+    const Inverter::TierOptions tiers = pars.Get<Inverter::TierOptions>("tiers");
     const Floors::Prescription inverter_floors       = pars.Get<Floors::Prescription>("inverter_prescription");
     const Floors::Prescription inverter_floors_inner = pars.Get<Floors::Prescription>("inverter_prescription_inner");
     const bool radius_dependent_floors = inverter_floors.radius_dependent_floors;
@@ -160,15 +216,41 @@ inline void BlockPerformInversion(MeshBlockData<Real> *rc, IndexDomain domain, b
     // zones!  These are the only ones which are filled at our point in the step
     auto bounds = coarse ? pmb->c_cellbounds : pmb->cellbounds;
     const IndexRange3 b = KDomain::GetPhysicalRange(rc);
-    pmb->par_for("U_to_P", b.ks, b.ke, b.js, b.je, b.is, b.ie,
+
+    // With fourth-order fluxes, U holds cell averages: invert the point values U - (1/24) Lap U instead.
+    // See flux/fourth_order.hpp
+    const bool fourth_order = pmb->packages.AllPackages().count("Flux") &&
+                              pmb->packages.Get("Flux")->Param<bool>("fourth_order");
+    if (fourth_order) {
+        auto U_point = rc->PackVariables(std::vector<std::string>{Transients::Name("Flux.U_point")});
+        const IndexRange3 be = KDomain::GetRange(rc, IndexDomain::entire, coarse);
+        const int nvar = U.GetDim(4);
+        Tiling::par_for("cons_to_point", pmb->exec_space, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+            KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
+                // Same indices as U, so m_u applies
+                for (int p = 0; p < nvar; ++p)
+                    U_point(p, k, j, i) = U(p, k, j, i) - Flux::Laplacian<0>(U, p, k, j, i, be) / 24.;
+            }
+        );
+        U = U_point;
+    }
+
+    // Rough per-zone work, for kernel profiling: read U, geometry (gcon, gcov, gdet), write P & flags.
+    // FLOPs assume a typical handful of solver iterations
+    Roofline::AddWork("U_to_P", static_cast<double>(b.ke - b.ks + 1) * (b.je - b.js + 1) * (b.ie - b.is + 1),
+                      8. * (U.GetDim(4) + 21 + P.GetDim(4) + 2), 600.);
+    Tiling::par_for("U_to_P", pmb->exec_space, b.ks, b.ke, b.js, b.je, b.is, b.ie,
         KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
             const Floors::Prescription& myfloors = (inverter_floors.radius_dependent_floors
                                             && G.coords.is_spherical()
                                             && G.r(k, j, i) < inverter_floors.floors_switch_r) ?
                                             inverter_floors_inner : inverter_floors;
-            int pflagl = Inverter::u_to_p<inverter>(G, U, m_u, gam, k, j, i, P, m_p, Loci::center,
-                                                    myfloors, iter_max, err_tol);
-            pflag(0, k, j, i) = pflagl % Floors::FFlag::MINIMUM;
+            int tier;
+            int pflagl = invert_zone<inverter>(G, U, m_u, gam, k, j, i, P, m_p, myfloors, tiers, iter_max, err_tol, tier);
+            const int status = pflagl % Floors::FFlag::MINIMUM;
+            // Record successes of the tiered inverter's later tiers, too
+            pflag(0, k, j, i) = (Inverter::valid(status) && tier > 1) ?
+                static_cast<int>((tier == 3) ? Inverter::Status::hard_tier : Inverter::Status::fallback_tier) : status;
             int fflagl = (pflagl / Floors::FFlag::MINIMUM) * Floors::FFlag::MINIMUM;
             fflag(0, k, j, i) = fflagl;
             // Generally after inversion we manipulate P and call this ourselves
@@ -192,6 +274,9 @@ void Inverter::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coars
     case Type::kastaun:
         BlockPerformInversion<Type::kastaun>(rc, domain, coarse);
         break;
+    case Type::tiered:
+        BlockPerformInversion<Type::tiered>(rc, domain, coarse);
+        break;
     case Type::none:
         break;
     }
@@ -41,6 +41,7 @@
 #include "invert_template.hpp"
 #include "onedw.hpp"
 #include "kastaun.hpp"
+#include "tiered.hpp"
 
 #include "pack.hpp"
 
@@ -48,8 +49,8 @@ using namespace parthenon;
 
 /**
  * Recover primitive variables from conserved forms.
- * Currently can only use the 1D_W scheme of Noble et al. (2006),
- * but this is the spot for alternate implementations
+ * Uses the 1D_W scheme of Noble et al. (2006), the robust scheme of Kastaun et al. (2020),
+ * or both in tiers (inverter/type=tiered), see tiered.hpp
  */
 namespace Inverter {
 
@@ -78,15 +79,12 @@ inline TaskStatus MeshUtoP(MeshData<Real> *md, IndexDomain domain, bool coarse)
  * a.k.a. Diffusion?  What diffusion?  There is no diffusion here.
  * 
  * LOCKSTEP: this function expects and should preserve P<->U
+ * 
+ * Only zones with failed pflag are touched, via a compacted list over all blocks in md,
+ * so this costs a single mesh-wide count when nothing failed.
  */
-TaskStatus FixUtoP(MeshBlockData<Real> *rc);
-inline TaskStatus MeshFixUtoP(MeshData<Real> *md) {
-    Flag("MeshFixUtoP");
-    for (int i=0; i < md->NumBlocks(); ++i)
-        FixUtoP(md->GetBlockData(i).get());
-    EndFlag();
-    return TaskStatus::complete;
-}
+TaskStatus FixUtoP(MeshData<Real> *md);
+inline TaskStatus MeshFixUtoP(MeshData<Real> *md) { return FixUtoP(md); }
 
 /**
  * Count up all nonzero PFlags on md.  Used for history file reductions.
@@ -62,6 +62,7 @@
 #include "invert_template.hpp"
 
 #include "coordinate_utils.hpp"
+#include "fast_math.hpp"
 #include "floors_functions.hpp"
 #include "grmhd_functions.hpp"
 #include "kharma_utils.hpp"
@@ -224,7 +225,7 @@ KOKKOS_INLINE_FUNCTION int u_to_p<Type::kastaun>(const GRCoordinates& G, const V
     // if (num_nans > 0) return static_cast<int>(Status::neg_input);
 
     // Transform GRMHD variables for the SRMHD Kastaun solver
-    const Real alpha  = 1. / m::sqrt(-G.gcon(loc, j, i, 0, 0));
+    const Real alpha  = fm::rsqrt(-G.gcon(loc, j, i, 0, 0));
     const Real a_over_g = alpha / G.gdet(loc, j, i);
 
     const Real D = U(m_u.RHO, k, j, i) * a_over_g;
@@ -276,7 +277,7 @@ KOKKOS_INLINE_FUNCTION int u_to_p<Type::kastaun>(const GRCoordinates& G, const V
     Real bdotr = 0.0;
     Real bu[] = {0.0, 0.0, 0.0};
     if (m_u.B1 >= 0) {
-        const Real sD = 1.0 / m::sqrt(D_fl);
+        const Real sD = fm::rsqrt(D_fl);
         // b^i
         SPACELOOP(ii) {
             bu[ii] = (U(m_u.B1 + ii, k, j, i) * a_over_g) * sD;
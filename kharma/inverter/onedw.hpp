@@ -37,6 +37,7 @@
 // We define a specialization based on the Inverter::Type parameter
 #include "invert_template.hpp"
 
+#include "fast_math.hpp"
 #include "grmhd_functions.hpp"
 #include "kharma_utils.hpp"
 
@@ -101,7 +102,7 @@ KOKKOS_INLINE_FUNCTION int u_to_p<Type::onedw>(const GRCoordinates& G, const Var
     }
 
     // Convert from conserved variables to four-vectors
-    const Real alpha = 1./m::sqrt(-G.gcon(loc, j, i, 0, 0));
+    const Real alpha = fm::rsqrt(-G.gcon(loc, j, i, 0, 0));
     const Real gdet = G.gdet(loc, j, i);
     const Real a_over_g = alpha / gdet;
     const Real D = U(m_u.RHO, k, j, i) * a_over_g;
@@ -0,0 +1,93 @@
+/* 
+ *  File: tiered.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+// Built from the two solvers, so include them first
+#include "onedw.hpp"
+#include "kastaun.hpp"
+
+namespace Inverter {
+
+/**
+ * Options for the tiered inverter, see below
+ */
+struct TierOptions {
+    // Iteration cap & tolerance of the first (1D_W) tier
+    int fast_iter_max;
+    Real fast_tol;
+    // Zones with lab-frame magnetization above this, or plasma beta below this,
+    // skip straight to the second (Kastaun) tier
+    Real hard_sigma;
+    Real hard_beta;
+};
+
+/**
+ * Tiered inversion: try the fast 1D_W Newton solve with a small iteration cap, and fall back to
+ * Kastaun's robust solver only where that fails, or in zones we expect it to struggle with (high sigma/low beta).
+ * "Hard" is judged from U's magnetic field and the previous step's P, which 1D_W also uses as its guess.
+ *
+ * Returns the status of the last tier run, as u_to_p does, and sets 'tier' to the tier which ran last:
+ * 1 if 1D_W succeeded, 2 if it failed and fell back, 3 if the zone was hard and went straight to Kastaun.
+ */
+KOKKOS_INLINE_FUNCTION int u_to_p_tiered(const GRCoordinates& G, const VariablePack<Real>& U, const VarMap& m_u,
+                                         const Real& gam, const int& k, const int& j, const int& i,
+                                         const VariablePack<Real>& P, const VarMap& m_p,
+                                         const Loci& loc, const Floors::Prescription& floors,
+                                         const TierOptions& tiers, const int& max_iterations, const Real& tol,
+                                         int& tier)
+{
+    bool hard = false;
+    if (m_u.B1 >= 0) {
+        const Real gdet = G.gdet(loc, j, i);
+        const Real Bcon[GR_DIM] = {0., U(m_u.B1, k, j, i) / gdet, U(m_u.B2, k, j, i) / gdet, U(m_u.B3, k, j, i) / gdet};
+        Real Bsq = 0.;
+        DLOOP2 Bsq += G.gcov(loc, j, i, mu, nu) * Bcon[mu] * Bcon[nu];
+        // D = rho u^t ~ rho.  Lab-frame B^2 >= b^2, so these overestimate sigma & underestimate beta
+        const Real D = U(m_u.RHO, k, j, i) / gdet;
+        hard = Bsq > tiers.hard_sigma * D || Bsq * tiers.hard_beta > 2. * (gam - 1.) * P(m_p.UU, k, j, i);
+    }
+    if (!hard) {
+        // 1D_W leaves P untouched on failure, so Kastaun sees the same state either way
+        const int status = u_to_p<Type::onedw>(G, U, m_u, gam, k, j, i, P, m_p, loc, floors,
+                                               tiers.fast_iter_max, tiers.fast_tol);
+        if (!failed(status % Floors::FFlag::MINIMUM)) {
+            tier = 1;
+            return status;
+        }
+    }
+    tier = (hard) ? 3 : 2;
+    return u_to_p<Type::kastaun>(G, U, m_u, gam, k, j, i, P, m_p, loc, floors, max_iterations, tol);
+}
+
+} // namespace Inverter
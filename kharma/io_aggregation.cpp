@@ -0,0 +1,144 @@
+/*
+ *  File: io_aggregation.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "io_aggregation.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// What we added, so FinishIOAggregation can take it back out
+std::string written_hints_file;
+bool set_romio_hints = false, set_cray_hints = false;
+
+} // namespace
+
+void KHARMA::SetIOAggregation(ParameterInput *pin)
+{
+    if (!pin->GetOrAddBoolean("io", "aggregate", false)) return;
+    const int writers_per_node = pin->GetOrAddInteger("io", "writers_per_node", 1);
+    // Per-aggregator gather buffer.  Larger means fewer, larger writes
+    const int buffer_mb = pin->GetOrAddInteger("io", "cb_buffer_mb", 16);
+    // Lustre stripe count for new files, or 0 to keep the directory default
+    const int stripe_count = pin->GetOrAddInteger("io", "stripe_count", 0);
+    // Written alongside the dumps, which Parthenon names "problem_id.*", and removed at exit
+    const std::string hints_file = pin->GetOrAddString("io", "hints_file",
+                                        pin->GetString("parthenon/job", "problem_id") + ".romio_hints");
+    if (writers_per_node < 1)
+        throw std::invalid_argument("io/writers_per_node must be at least 1!");
+
+#if ENABLE_MPI
+    Flag("SetIOAggregation");
+    // Count nodes as groups of ranks sharing memory
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int node_rank, node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    MPI_Comm_free(&node_comm);
+    int is_node_root = (node_rank == 0), nnodes = 0, max_node_size = 0;
+    MPI_Allreduce(&is_node_root, &nnodes, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&node_size, &max_node_size, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    const int per_node = m::min(writers_per_node, max_node_size);
+    const int nwriters = m::min(nnodes * per_node, MPINumRanks());
+
+    // ROMIO: one "key value" per line.
+    // These apply to every file opened through MPI-IO, including resize_restart's reads and
+    // region_output's independent metadata writes, so nothing here may forbid independent I/O
+    // (i.e. no romio_no_indep_rw)
+    if (std::getenv("ROMIO_HINTS") == nullptr) {
+        if (MPIRank0()) {
+            std::ofstream hints(hints_file);
+            hints << "romio_cb_write enable" << std::endl;
+            hints << "cb_nodes " << nwriters << std::endl;
+            hints << "cb_config_list *:" << per_node << std::endl;
+            hints << "cb_buffer_size " << buffer_mb * 1024 * 1024 << std::endl;
+            if (stripe_count > 0) hints << "striping_factor " << stripe_count << std::endl;
+        }
+        // Everyone reads the file at open, so it must exist first
+        MPIBarrier();
+        setenv("ROMIO_HINTS", hints_file.c_str(), 0);
+        written_hints_file = hints_file;
+        set_romio_hints = true;
+    } else if (MPIRank0()) {
+        std::cerr << "WARNING: ROMIO_HINTS is already set, not adding I/O aggregation hints" << std::endl;
+    }
+
+    // Cray: "pattern:key=value:..." for all files.  Aggregators are placed per-node by default
+    if (std::getenv("MPICH_MPIIO_HINTS") == nullptr) {
+        std::ostringstream cray_hints;
+        cray_hints << "*:romio_cb_write=enable:cb_nodes=" << nwriters
+                   << ":cb_buffer_size=" << buffer_mb * 1024 * 1024;
+        if (stripe_count > 0) cray_hints << ":striping_factor=" << stripe_count;
+        setenv("MPICH_MPIIO_HINTS", cray_hints.str().c_str(), 0);
+        set_cray_hints = true;
+    }
+
+#ifdef OPEN_MPI
+    // OMPIO, OpenMPI's default, takes its settings from MCA parameters instead
+    const char *ompi_io = std::getenv("OMPI_MCA_io");
+    if (MPIRank0() && (ompi_io == nullptr || std::string(ompi_io).find("romio") == std::string::npos)) {
+        std::cerr << "WARNING: OpenMPI's OMPIO ignores I/O aggregation hints, set OMPI_MCA_io to its ROMIO component"
+                  << std::endl;
+    }
+#endif
+    if (MPIRank0()) {
+        std::cout << "I/O aggregation: " << nwriters << " writer ranks on " << nnodes << " nodes, "
+                  << buffer_mb << "MB buffers" << std::endl;
+    }
+    EndFlag();
+#endif
+}
+
+void KHARMA::FinishIOAggregation()
+{
+#if ENABLE_MPI
+    if (set_romio_hints) {
+        unsetenv("ROMIO_HINTS");
+        // Don't pull the file out from under any rank still closing a dump
+        MPIBarrier();
+        if (MPIRank0()) std::remove(written_hints_file.c_str());
+        set_romio_hints = false;
+    }
+    if (set_cray_hints) {
+        unsetenv("MPICH_MPIIO_HINTS");
+        set_cray_hints = false;
+    }
+#endif
+}
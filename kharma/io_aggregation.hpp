@@ -0,0 +1,72 @@
+/*
+ *  File: io_aggregation.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+namespace KHARMA {
+
+/**
+ * Limit which ranks touch the filesystem when writing dumps & restarts, if the user asks with io/aggregate=true.
+ *
+ * Parthenon writes .phdf/.rhdf files with collective parallel HDF5, which goes through MPI-IO.  By default
+ * every rank may open the file and write its own blocks, so metadata traffic scales with the rank count.
+ * MPI-IO can instead run "two-phase" collective buffering: a few aggregator ranks gather block data from
+ * the others over MPI, then do all the (large, contiguous) writes.  This sets that up, with
+ * io/writers_per_node aggregators on each node, by passing hints to the MPI library:
+ * 1. A ROMIO hints file, written to io/hints_file and pointed to by ROMIO_HINTS (MPICH, Intel MPI, MVAPICH,
+ *    and OpenMPI's ROMIO component).
+ *    By default the file is "problem_id.romio_hints", next to the dumps rather than in the working directory.
+ * 2. The equivalent MPICH_MPIIO_HINTS string, for Cray MPICH.
+ * Hints already in the environment are left alone.
+ *
+ * The environment reaches every file opened through MPI-IO afterward, not just Parthenon's outputs,
+ * so only hints which are safe for independent reads & writes are set: collective buffering changes
+ * only how collective writes are scheduled.  The file layout is unchanged.
+ * Note this does *not* gather data on the KHARMA side: the aggregation is entirely MPI-IO's.  OpenMPI's
+ * default OMPIO component ignores ROMIO hints, so there this does nothing unless ROMIO is selected
+ * with OMPI_MCA_io (e.g. romio341 for OpenMPI 4.1), which SetIOAggregation warns about.
+ *
+ * Must be called on all ranks, before the first file is written.
+ */
+void SetIOAggregation(ParameterInput *pin);
+
+/**
+ * Remove the hints file and any environment variables set by SetIOAggregation.
+ * Must be called on all ranks after the last file is written, before MPI is finalized.
+ */
+void FinishIOAggregation();
+
+}
@@ -38,6 +38,12 @@
 #include <parthenon/parthenon.hpp>
 
 #include "decs.hpp"
+#include "block_placement.hpp"
+#include "io_aggregation.hpp"
+#include "region_output.hpp"
+#include "spectra.hpp"
+#include "timeline.hpp"
+#include "transients.hpp"
 #include "version.hpp"
 
 // Packages
@@ -86,6 +92,11 @@ std::shared_ptr<KHARMAPackage> KHARMA::InitializeGlobals(ParameterInput *pin, st
     int extra_checks = pin->GetOrAddInteger("debug", "extra_checks", 0);
     params.Add("extra_checks", extra_checks, true);
 
+    // Zones with r < reduced_work_r are causally disconnected from the rest of the domain.
+    // They take only the explicit ideal MHD update, with fluid-frame floors: no implicit solve,
+    // EMHD sources, electron heating, or floor budget.  Negative to disable (default)
+    params.Add("reduced_work_r", pin->GetOrAddReal("coordinates", "reduced_work_r", -1.));
+
     // Record the problem name, just in case we need to special-case for different problems.
     // Please favor packages & options before using this, and modify problem-specific code
     // to be more general as it matures.
@@ -126,6 +137,7 @@ void KHARMA::PreStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
     }
     globals.Update<double>("dt_last", tm.dt);
     globals.Update<double>("time", tm.time);
+    Timeline::SetStep(tm.ncycle);
 }
 
 void KHARMA::PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
@@ -233,6 +245,19 @@ void KHARMA::FixParameters(ParameterInput *pin, bool is_parthenon_restart)
         // If the simulation domain extends inside the EH, we change some boundary options
         pin->SetBoolean("coordinates", "domain_intersects_eh", pin->GetReal("coordinates", "r_in") < tmp_coords.get_horizon());
 
+        // Optionally skip the expensive physics in zones deep inside the EH, see Globals "reduced_work_r".
+        // The cutoff must sit a full stencil inside the horizon.  Reconstruction still carries any difference
+        // outward by up to a stencil width per sub-step, so a wider margin keeps the exterior identical for longer
+        if (pin->DoesParameterExist("coordinates", "reduced_work_r")) {
+            const GReal r_reduced = pin->GetReal("coordinates", "reduced_work_r");
+            const GReal x1min = pin->GetReal("parthenon/mesh", "x1min");
+            const GReal dx1 = (pin->GetReal("parthenon/mesh", "x1max") - x1min) / pin->GetInteger("parthenon/mesh", "nx1");
+            if (tmp_coords.r_to_native(tmp_coords.get_horizon()) - tmp_coords.r_to_native(r_reduced) < Globals::nghost * dx1) {
+                throw std::invalid_argument("coordinates/reduced_work_r must be at least "+std::to_string(Globals::nghost)
+                                            +" zones inside the event horizon!");
+            }
+        }
+
         // Spherical systems will also want KHARMA's spherical boundary conditions.
         // Note boundaries are now exclusively set by KBoundaries package
         pin->GetOrAddString("boundaries", "inner_x1", "outflow");
@@ -245,6 +270,9 @@ void KHARMA::FixParameters(ParameterInput *pin, bool is_parthenon_restart)
         // This will never happen in Minkowski, but sometimes is checked later
         pin->SetReal("coordinates", "r_in", 0.);
         pin->SetBoolean("coordinates", "domain_intersects_eh", false);
+        if (pin->DoesParameterExist("coordinates", "reduced_work_r")) {
+            throw std::invalid_argument("coordinates/reduced_work_r is only supported for black hole spacetimes!");
+        }
         // We can set reasonable default boundary conditions for Cartesian sims,
         // but not default domain bounds
         pin->GetOrAddString("boundaries", "inner_x1", "periodic");
@@ -312,6 +340,14 @@ void KHARMA::FixParameters(ParameterInput *pin, bool is_parthenon_restart)
         }
     }
 
+    // Optionally choose meshblock sizes to suit spherical grids.
+    // Restarts must keep the block layout they were written with
+    if (!is_parthenon_restart)
+        KHARMA::SetBlockPlacement(pin);
+
+    // Optionally restrict file writes to a few ranks per node
+    KHARMA::SetIOAggregation(pin);
+
     EndFlag();
 }
 
@@ -447,6 +483,18 @@ Packages_t KHARMA::ProcessPackages(std::unique_ptr<ParameterInput> &pin)
         KHARMA::AddPackage(packages, Implicit::Initialize, pin.get());
     }
 
+    // Region-restricted dumps, which write whatever fields exist when they're called
+    if (pin->DoesBlockExist("region_output0")) {
+        KHARMA::AddPackage(packages, RegionOutput::Initialize, pin.get());
+    }
+    // Likewise in-situ power spectra
+    if (pin->DoesBlockExist("spectra")) {
+        KHARMA::AddPackage(packages, Spectra::Initialize, pin.get());
+    }
+
+    // Finally, allocate any transient fields declared above, sharing storage where possible
+    KHARMA::AddPackage(packages, Transients::Initialize, pin.get());
+
 #if DEBUG
     // Carry the ParameterInput with us, for generating outputs whenever we want
     packages->Get("Globals")->AllParams().Add("pin", pin.get());
@@ -36,6 +36,9 @@
 #include "decs.hpp"
 #include "types.hpp"
 
+#include <iomanip>
+#include <iostream>
+
 /**
  * General preferences for KHARMA.  Anything semi-driver-independent, like loading packages, etc.
  */
@@ -83,6 +86,48 @@ void FixParameters(ParameterInput *pin, bool is_parthenon_restart);
  */
 Packages_t ProcessPackages(std::unique_ptr<ParameterInput>& pin);
 
+/**
+ * Wall-clock timer for the phases of startup (mesh construction, problem init, B field seeding, etc.).
+ * Startup on big meshes can take a while, and it's useful to know where that time goes.
+ * Each call to Start() ends any previous phase.  Times are from rank 0 only.
+ */
+class StartupTimer {
+    public:
+        void Start(const std::string& phase)
+        {
+            End();
+            current = phase;
+            timer.reset();
+        }
+        void End()
+        {
+            if (!current.empty()) {
+                phases.emplace_back(current, timer.seconds());
+                current = "";
+            }
+        }
+        void Print(const std::string& title)
+        {
+            End();
+            if (MPIRank0() && phases.size() > 0) {
+                double total = 0.;
+                std::cout << title << " timing:" << std::endl;
+                for (auto &phase : phases) {
+                    std::cout << "  " << std::left << std::setw(28) << phase.first
+                              << std::right << std::fixed << std::setprecision(3) << phase.second << "s" << std::endl;
+                    total += phase.second;
+                }
+                std::cout << "  " << std::left << std::setw(28) << "total"
+                          << std::right << std::fixed << std::setprecision(3) << total << "s" << std::endl;
+                std::cout << std::defaultfloat << std::endl;
+            }
+        }
+    private:
+        Kokkos::Timer timer;
+        std::string current = "";
+        std::vector<std::pair<std::string, double>> phases;
+};
+
 // TODO(BSP) not sure where to put these
 
 /**
@@ -97,8 +142,9 @@ inline bool FieldIsOutput(ParameterInput *pin, std::string name)
 {
     InputBlock *pib = pin->pfirst_block;
     while (pib != nullptr) {
-        // For every output block with a 'variables' entry...
-        if (pib->block_name.find("parthenon/output") != std::string::npos &&
+        // For every output block (including region outputs) with a 'variables' entry...
+        if ((pib->block_name.find("parthenon/output") != std::string::npos ||
+             pib->block_name.find("region_output") == 0) &&
             pin->DoesParameterExist(pib->block_name, "variables")) {
             std::string allvars = pin->GetString(pib->block_name, "variables");
             if (allvars.find(name) != std::string::npos) {
@@ -35,21 +35,111 @@
 
 #include "types.hpp"
 
+namespace {
+
+// The current plan, and the Mesh it was built for
+Mesh *plan_mesh = nullptr;
+Packages::CallbackPlan plan;
+
+template<typename F>
+void AddToPlan(std::vector<Packages::PlannedCallback<F>>& list, const F& callback, const std::string& label)
+{
+    if (callback != nullptr) list.push_back(Packages::PlannedCallback<F>{callback, label});
+}
+
+} // namespace
+
 // TODO clearly this needs a better concept of ordering.
 // probably this means something that returns an ordered list of packages
 // for the given operation, based on... declared dependencies?
-// it could also use full meshification & return codes
+// For now the special cases are all here, applied once when building the plan
+void Packages::BuildCallbackPlan(Mesh *pmesh)
+{
+    Flag("BuildCallbackPlan");
+    auto kpackages = pmesh->packages.AllPackagesOfType<KHARMAPackage>();
+    CallbackPlan new_plan;
+
+    for (auto &kpackage : kpackages) {
+        const std::string& name = kpackage.first;
+        const auto& pkg = kpackage.second;
+        AddToPlan(new_plan.FixFlux, pkg->FixFlux, "FixFlux_"+name);
+        AddToPlan(new_plan.BlockApplyPrimSource, pkg->BlockApplyPrimSource, "BlockApplyPrimSource_"+name);
+        AddToPlan(new_plan.UserWorkBeforeOutput, pkg->BlockUserWorkBeforeOutput, "UserWorkBeforeOutput_"+name);
+        AddToPlan(new_plan.PreStepWork, pkg->PreStepWork, "PreStepWork_"+name);
+        AddToPlan(new_plan.PostStepWork, pkg->PostStepWork, "PostStepWork_"+name);
+        AddToPlan(new_plan.PostExecute, pkg->PostExecute, "PostExecute_"+name);
+    }
+
+    // Apply UtoP from B_CT first, as this fills cons.B at cell centers
+    // Then GRMHD, as some packages require GRMHD prims in place for U->P
+    for (const std::string first : {"B_CT", "Inverter"}) {
+        if (kpackages.count(first))
+            AddToPlan(new_plan.BlockUtoP, kpackages.at(first)->BlockUtoP, "BlockUtoP_"+first);
+    }
+    for (auto &kpackage : kpackages) {
+        if (kpackage.first != "B_CT" && kpackage.first != "Inverter")
+            AddToPlan(new_plan.BlockUtoP, kpackage.second->BlockUtoP, "BlockUtoP_"+kpackage.first);
+    }
+
+    // Boundary UtoP similarly does GRMHD first
+    if (kpackages.count("Inverter"))
+        AddToPlan(new_plan.BoundaryUtoP, kpackages.at("Inverter")->BoundaryUtoP, "BoundaryUtoP_Inverter");
+    for (auto &kpackage : kpackages) {
+        if (kpackage.first != "Inverter")
+            AddToPlan(new_plan.BoundaryUtoP, kpackage.second->BoundaryUtoP, "BoundaryUtoP_"+kpackage.first);
+    }
+
+    // Domain boundaries use each package's PtoU if it has one, otherwise UtoP.
+    // Some downstream UtoP rely on GRMHD prims, some cons, so GRMHD goes first
+    auto add_domain_boundary = [&](const std::string& name, const std::shared_ptr<KHARMAPackage>& pkg) {
+        if (pkg->DomainBoundaryPtoU != nullptr) {
+            AddToPlan(new_plan.BoundaryPtoUElseUtoP, pkg->DomainBoundaryPtoU, "DomainBoundaryPtoU_"+name);
+        } else {
+            AddToPlan(new_plan.BoundaryPtoUElseUtoP, pkg->BoundaryUtoP, "DomainBoundaryUtoP_"+name);
+        }
+    };
+    if (kpackages.count("GRMHD"))
+        add_domain_boundary("GRMHD", kpackages.at("GRMHD"));
+    for (auto &kpackage : kpackages) {
+        if (kpackage.first != "GRMHD")
+            add_domain_boundary(kpackage.first, kpackage.second);
+    }
+
+    // Boundary sources first
+    if (kpackages.count("Boundaries"))
+        AddToPlan(new_plan.AddSource, kpackages.at("Boundaries")->AddSource, "AddSource_Boundaries");
+    for (auto &kpackage : kpackages) {
+        if (kpackage.first != "Boundaries")
+            AddToPlan(new_plan.AddSource, kpackage.second->AddSource, "AddSource_"+kpackage.first);
+    }
+
+    // Apply the version from "Floors" package first, then everything else i.e. block versions
+    // TODO(BSP) allow Mesh versions and fallback
+    if (kpackages.count("Floors"))
+        AddToPlan(new_plan.MeshApplyFloors, kpackages.at("Floors")->MeshApplyFloors, "MeshApplyFloors_Floors");
+    for (auto &kpackage : kpackages) {
+        if (kpackage.first != "Floors")
+            AddToPlan(new_plan.BlockApplyFloors, kpackage.second->BlockApplyFloors, "BlockApplyFloors_"+kpackage.first);
+    }
+
+    plan = std::move(new_plan);
+    plan_mesh = pmesh;
+    EndFlag();
+}
+
+const Packages::CallbackPlan& Packages::GetCallbackPlan(Mesh *pmesh)
+{
+    if (pmesh != plan_mesh) BuildCallbackPlan(pmesh);
+    return plan;
+}
 
 TaskStatus Packages::FixFlux(MeshData<Real> *md)
 {
     Flag("FixFlux");
-    auto kpackages = md->GetMeshPointer()->packages.AllPackagesOfType<KHARMAPackage>();
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->FixFlux != nullptr) {
-            Flag("FixFlux_"+kpackage.first);
-            kpackage.second->FixFlux(md);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(md->GetMeshPointer()).FixFlux) {
+        Flag(cb.label);
+        cb.callback(md);
+        EndFlag();
     }
     EndFlag();
     return TaskStatus::complete;
@@ -58,32 +148,10 @@ TaskStatus Packages::FixFlux(MeshData<Real> *md)
 TaskStatus Packages::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
 {
     Flag("BlockUtoP");
-    // Apply UtoP from B_CT first, as this fills cons.B at cell centers
-    auto pmb = rc->GetBlockPointer();
-    auto kpackages = rc->GetBlockPointer()->packages.AllPackagesOfType<KHARMAPackage>();
-    if (kpackages.count("B_CT")) {
-        KHARMAPackage *pkpackage = pmb->packages.Get<KHARMAPackage>("B_CT");
-        if (pkpackage->BlockUtoP != nullptr) {
-            Flag("BlockUtoP_B_CT");
-            pkpackage->BlockUtoP(rc, domain, coarse);
-            EndFlag();
-        }
-    }
-    // Then GRMHD, as some packages require GRMHD prims in place for U->P
-    if (kpackages.count("Inverter")) {
-        KHARMAPackage *pkpackage = pmb->packages.Get<KHARMAPackage>("Inverter");
-        if (pkpackage->BlockUtoP != nullptr) {
-            Flag("BlockUtoP_Inverter");
-            pkpackage->BlockUtoP(rc, domain, coarse);
-            EndFlag();
-        }
-    }
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->BlockUtoP != nullptr && kpackage.first != "B_CT" && kpackage.first != "Inverter") {
-            Flag("BlockUtoP_"+kpackage.first);
-            kpackage.second->BlockUtoP(rc, domain, coarse);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(rc->GetBlockPointer()->pmy_mesh).BlockUtoP) {
+        Flag(cb.label);
+        cb.callback(rc, domain, coarse);
+        EndFlag();
     }
     EndFlag();
     return TaskStatus::complete;
@@ -101,22 +169,10 @@ TaskStatus Packages::MeshUtoP(MeshData<Real> *md, IndexDomain domain, bool coars
 TaskStatus Packages::BoundaryUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
 {
     Flag("BoundaryUtoP");
-    auto pmb = rc->GetBlockPointer();
-    auto kpackages = rc->GetBlockPointer()->packages.AllPackagesOfType<KHARMAPackage>();
-    if (kpackages.count("Inverter")) {
-        KHARMAPackage *pkpackage = pmb->packages.Get<KHARMAPackage>("Inverter");
-        if (pkpackage->BoundaryUtoP != nullptr) {
-            Flag("BoundaryUtoP_Inverter");
-            pkpackage->BoundaryUtoP(rc, domain, coarse);
-            EndFlag();
-        }
-    }
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->BoundaryUtoP != nullptr && kpackage.first != "Inverter") {
-            Flag("BoundaryUtoP_"+kpackage.first);
-            kpackage.second->BoundaryUtoP(rc, domain, coarse);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(rc->GetBlockPointer()->pmy_mesh).BoundaryUtoP) {
+        Flag(cb.label);
+        cb.callback(rc, domain, coarse);
+        EndFlag();
     }
     EndFlag();
     return TaskStatus::complete;
@@ -125,31 +181,10 @@ TaskStatus Packages::BoundaryUtoP(MeshBlockData<Real> *rc, IndexDomain domain, b
 TaskStatus Packages::BoundaryPtoUElseUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
 {
     Flag("DomainBoundaryLockstep");
-    auto pmb = rc->GetBlockPointer();
-    auto kpackages = rc->GetBlockPointer()->packages.AllPackagesOfType<KHARMAPackage>();
-    // Some downstream UtoP rely on GRMHD prims, some cons
-    if (kpackages.count("GRMHD")) {
-        KHARMAPackage *pkpackage = pmb->packages.Get<KHARMAPackage>("GRMHD");
-        if (pkpackage->DomainBoundaryPtoU != nullptr) {
-            Flag("DomainBoundaryPtoU_GRMHD");
-            pkpackage->DomainBoundaryPtoU(rc, domain, coarse);
-            EndFlag();
-        } else if (pkpackage->BoundaryUtoP != nullptr) { // This won't be called
-            Flag("DomainBoundaryUtoP_GRMHD");
-            pkpackage->BoundaryUtoP(rc, domain, coarse);
-            EndFlag();
-        }
-    }
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->DomainBoundaryPtoU != nullptr && kpackage.first != "GRMHD") {
-            Flag("DomainBoundaryPtoU_"+kpackage.first);
-            kpackage.second->DomainBoundaryPtoU(rc, domain, coarse);
-            EndFlag();
-        } else if (kpackage.second->BoundaryUtoP != nullptr && kpackage.first != "GRMHD") {
-            Flag("DomainBoundaryUtoP_"+kpackage.first);
-            kpackage.second->BoundaryUtoP(rc, domain, coarse);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(rc->GetBlockPointer()->pmy_mesh).BoundaryPtoUElseUtoP) {
+        Flag(cb.label);
+        cb.callback(rc, domain, coarse);
+        EndFlag();
     }
     EndFlag();
     return TaskStatus::complete;
@@ -158,22 +193,10 @@ TaskStatus Packages::BoundaryPtoUElseUtoP(MeshBlockData<Real> *rc, IndexDomain d
 TaskStatus Packages::AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexDomain domain)
 {
     Flag("AddSource");
-    auto pmesh = md->GetMeshPointer();
-    auto kpackages = pmesh->packages.AllPackagesOfType<KHARMAPackage>();
-    if (kpackages.count("Boundaries")) {
-        KHARMAPackage *pkpackage = pmesh->packages.Get<KHARMAPackage>("Boundaries");
-        if (pkpackage->AddSource != nullptr) {
-            Flag("AddSource_Boundaries");
-            pkpackage->AddSource(md, mdudt, domain);
-            EndFlag();
-        }
-    }
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->AddSource != nullptr && kpackage.first != "Boundaries") {
-            Flag("AddSource_"+kpackage.first);
-            kpackage.second->AddSource(md, mdudt, domain);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(md->GetMeshPointer()).AddSource) {
+        Flag(cb.label);
+        cb.callback(md, mdudt, domain);
+        EndFlag();
     }
     EndFlag();
     return TaskStatus::complete;
@@ -182,13 +205,13 @@ TaskStatus Packages::AddSource(MeshData<Real> *md, MeshData<Real> *mdudt, IndexD
 TaskStatus Packages::MeshApplyPrimSource(MeshData<Real> *md)
 {
     Flag("MeshApplyPrimSource");
+    const auto& sources = GetCallbackPlan(md->GetMeshPointer()).BlockApplyPrimSource;
     for (int i=0; i < md->NumBlocks(); ++i) {
         auto rc = md->GetBlockData(i).get();
-        auto kpackages = rc->GetBlockPointer()->packages.AllPackagesOfType<KHARMAPackage>();
-        for (auto kpackage : kpackages) {
-            if (kpackage.second->BlockApplyPrimSource != nullptr) {
-                kpackage.second->BlockApplyPrimSource(rc);
-            }
+        for (auto &cb : sources) {
+            Flag(cb.label);
+            cb.callback(rc);
+            EndFlag();
         }
     }
     EndFlag();
@@ -198,32 +221,18 @@ TaskStatus Packages::MeshApplyPrimSource(MeshData<Real> *md)
 TaskStatus Packages::MeshApplyFloors(MeshData<Real> *md, IndexDomain domain)
 {
     Flag("MeshApplyFloors");
-
-    // Apply the version from "Floors" package first
-    auto pmesh = md->GetMeshPointer();
-    auto pkgs = pmesh->packages.AllPackages();
-    if (pkgs.count("Floors")) {
-        KHARMAPackage *pkpackage = pmesh->packages.Get<KHARMAPackage>("Floors");
-        if (pkpackage->MeshApplyFloors != nullptr) {
-            Flag("MeshApplyFloors_Floors");
-            pkpackage->MeshApplyFloors(md, domain);
-            EndFlag();
-        }
+    const auto& mesh_plan = GetCallbackPlan(md->GetMeshPointer());
+    for (auto &cb : mesh_plan.MeshApplyFloors) {
+        Flag(cb.label);
+        cb.callback(md, domain);
+        EndFlag();
     }
-    // Then everything else i.e. block versions
-    // TODO(BSP) allow Mesh versions and fallback
     for (int i=0; i < md->NumBlocks(); ++i) {
         auto mbd = md->GetBlockData(i).get();
-        auto pmb = mbd->GetBlockPointer();
-        auto kpackages = pmb->packages.AllPackagesOfType<KHARMAPackage>();
-        for (auto kpackage : kpackages) {
-            if (kpackage.first != "Floors") {
-                if (kpackage.second->BlockApplyFloors != nullptr) {
-                    Flag("BlockApplyFloors_"+kpackage.first);
-                    kpackage.second->BlockApplyFloors(mbd, domain);
-                    EndFlag();
-                }
-            }
+        for (auto &cb : mesh_plan.BlockApplyFloors) {
+            Flag(cb.label);
+            cb.callback(mbd, domain);
+            EndFlag();
         }
     }
     EndFlag();
@@ -235,13 +244,10 @@ TaskStatus Packages::MeshApplyFloors(MeshData<Real> *md, IndexDomain domain)
 void Packages::UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin)
 {
     Flag("UserWorkBeforeOutput");
-    auto kpackages = pmb->packages.AllPackagesOfType<KHARMAPackage>();
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->BlockUserWorkBeforeOutput != nullptr) {
-            Flag("UserWorkBeforeOutput_"+kpackage.first);
-            kpackage.second->BlockUserWorkBeforeOutput(pmb, pin);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(pmb->pmy_mesh).UserWorkBeforeOutput) {
+        Flag(cb.label);
+        cb.callback(pmb, pin);
+        EndFlag();
     }
     EndFlag();
 }
@@ -249,13 +255,10 @@ void Packages::UserWorkBeforeOutput(MeshBlock *pmb, ParameterInput *pin)
 void Packages::PreStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
 {
     Flag("PreStepWork");
-    auto kpackages = pmesh->packages.AllPackagesOfType<KHARMAPackage>();
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->PreStepWork != nullptr) {
-            Flag("PreStepWork_"+kpackage.first);
-            kpackage.second->PreStepWork(pmesh, pin, tm);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(pmesh).PreStepWork) {
+        Flag(cb.label);
+        cb.callback(pmesh, pin, tm);
+        EndFlag();
     }
     EndFlag();
 }
@@ -263,13 +266,10 @@ void Packages::PreStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
 void Packages::PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
 {
     Flag("PostStepWork");
-    auto kpackages = pmesh->packages.AllPackagesOfType<KHARMAPackage>();
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->PostStepWork != nullptr) {
-            Flag("PostStepWork_"+kpackage.first);
-            kpackage.second->PostStepWork(pmesh, pin, tm);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(pmesh).PostStepWork) {
+        Flag(cb.label);
+        cb.callback(pmesh, pin, tm);
+        EndFlag();
     }
     EndFlag();
 }
@@ -295,13 +295,10 @@ void Packages::PostStepDiagnostics(Mesh *pmesh, ParameterInput *pin, const SimTi
 void Packages::PostExecute(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
 {
     Flag("KHARMAPostExecute");
-    auto kpackages = pmesh->packages.AllPackagesOfType<KHARMAPackage>();
-    for (auto kpackage : kpackages) {
-        if (kpackage.second->PostExecute != nullptr) {
-            Flag("PostExecute_"+kpackage.first);
-            kpackage.second->PostExecute(pmesh, pin, tm);
-            EndFlag();
-        }
+    for (auto &cb : GetCallbackPlan(pmesh).PostExecute) {
+        Flag(cb.label);
+        cb.callback(pmesh, pin, tm);
+        EndFlag();
     }
     EndFlag();
 }
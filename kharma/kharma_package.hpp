@@ -115,6 +115,47 @@ class KHARMAPackage : public StateDescriptor {
  */
 namespace Packages {
 
+/**
+ * A callback resolved from one package, with its profiling label
+ */
+template<typename F>
+struct PlannedCallback {
+    F callback;
+    std::string label;
+};
+
+/**
+ * Each hook's non-null callbacks over all KHARMAPackages, in the order they must be run.
+ * Built once per Mesh, rather than searching the package list and building label strings
+ * on each call, for each block.  The plan depends only on the loaded packages, which
+ * are fixed after initialization (and unchanged by remeshing).
+ */
+struct CallbackPlan {
+    std::vector<PlannedCallback<std::function<void(MeshData<Real>*)>>> FixFlux;
+    std::vector<PlannedCallback<std::function<void(MeshBlockData<Real>*, IndexDomain, bool)>>> BlockUtoP;
+    std::vector<PlannedCallback<std::function<void(MeshBlockData<Real>*, IndexDomain, bool)>>> BoundaryUtoP;
+    std::vector<PlannedCallback<std::function<void(MeshBlockData<Real>*, IndexDomain, bool)>>> BoundaryPtoUElseUtoP;
+    std::vector<PlannedCallback<std::function<void(MeshData<Real>*, MeshData<Real>*, IndexDomain)>>> AddSource;
+    std::vector<PlannedCallback<std::function<void(MeshBlockData<Real>*)>>> BlockApplyPrimSource;
+    std::vector<PlannedCallback<std::function<void(MeshData<Real>*, IndexDomain)>>> MeshApplyFloors;
+    std::vector<PlannedCallback<std::function<void(MeshBlockData<Real>*, IndexDomain)>>> BlockApplyFloors;
+    std::vector<PlannedCallback<std::function<void(MeshBlock*, ParameterInput*)>>> UserWorkBeforeOutput;
+    std::vector<PlannedCallback<std::function<void(Mesh*, ParameterInput*, const SimTime&)>>> PreStepWork;
+    std::vector<PlannedCallback<std::function<void(Mesh*, ParameterInput*, const SimTime&)>>> PostStepWork;
+    std::vector<PlannedCallback<std::function<void(Mesh*, ParameterInput*, const SimTime&)>>> PostExecute;
+};
+
+/**
+ * (Re)build the callback plan from the packages of 'pmesh'.
+ * Called automatically the first time a plan is needed for a given Mesh.
+ */
+void BuildCallbackPlan(Mesh *pmesh);
+
+/**
+ * Get the callback plan for 'pmesh', building it if necessary
+ */
+const CallbackPlan& GetCallbackPlan(Mesh *pmesh);
+
 /**
  * Any "fixes" to the fluxes through zone faces calculated by GetFlux.
  * These are all package-defined, with boundary fluxes and magnetic field transport
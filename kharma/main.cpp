@@ -36,10 +36,16 @@
 #include "decs.hpp"
 
 #include "boundaries.hpp"
+#include "halo_exchange.hpp"
+#include "io_aggregation.hpp"
 #include "kharma_driver.hpp"
 #include "kharma.hpp"
 #include "post_initialize.hpp"
 #include "problem.hpp"
+#include "reblock.hpp"
+#include "roofline.hpp"
+#include "tiling.hpp"
+#include "timeline.hpp"
 #include "emhd/conducting_atmosphere.hpp"
 #include "version.hpp"
 
@@ -135,6 +141,9 @@ int main(int argc, char *argv[])
         std::cout << std::endl;
     }
 
+    // Time the phases of startup, which can be long for big meshes
+    KHARMA::StartupTimer startup_timer;
+
     // Check the Parthenon init return code, initialize packages/mesh
     Flag("InitPackagesAndMesh");
     if (manager_status == ParthenonStatus::complete) {
@@ -148,9 +157,13 @@ int main(int argc, char *argv[])
     auto pin = pman.pinput.get(); // All parameters in the input file or command line
     // Modify input parameters as we need. Needs to know if Parthenon set parameters
     // from our restart file, or whether we need to read them from a file here
+    startup_timer.Start("FixParameters");
     KHARMA::FixParameters(pin, pman.IsRestart());
     // InitPackagesEtc calls ProcessPackages, then constructs the Mesh
+    // This includes geometry caches and the per-block ProblemGenerator
+    startup_timer.Start("InitPackagesAndMesh");
     pman.ParthenonInitPackagesAndMesh();
+    startup_timer.End();
     // Now pull out the mesh and app_input as well for below
     auto pmesh = pman.pmesh.get(); // The mesh, with list of blocks & locations, size, etc
     auto papp = pman.app_input.get(); // The list of callback functions specified above
@@ -211,8 +224,13 @@ int main(int argc, char *argv[])
         }
     }
 
+    // Optionally exchange ghost zones with persistent requests, see halo_exchange.hpp
+    HaloExchange::Initialize(pin, pmesh);
+
     Flag("PostInitialize");
+    startup_timer.Start("PostInitialize");
     KHARMA::PostInitialize(pin, pmesh, is_restart);
+    startup_timer.End();
     EndFlag();
 
     // TODO output parsed parameters *here*, now we have everything including any problem configs for B field
@@ -229,7 +247,19 @@ int main(int argc, char *argv[])
 
         // We now have just one driver package, with different TaskLists for different modes
         //MPIBarrier();
+        startup_timer.Start("DriverInit");
         KHARMADriver driver(pin, papp, pmesh);
+        startup_timer.Print("Startup");
+
+        // Optionally run stencil kernels over cache-sized tiles on CPU, see tiling.hpp
+        Tiling::Initialize(pin);
+        // Optionally time & model every kernel from here on, see roofline.hpp
+        Roofline::Initialize(pin);
+        // Optionally record a timeline of some steps, see timeline.hpp
+        Timeline::Initialize(pin);
+
+        // Optionally stop partway to re-cut the mesh into new blocks, see reblock.hpp
+        Reblock::Initialize(pin);
 
         // Then execute the driver. This is a Parthenon function inherited by our KHARMADriver object,
         // which will call MakeTaskCollection, then execute the tasks on the mesh for each portion
@@ -238,8 +268,25 @@ int main(int argc, char *argv[])
         //MPIBarrier();
         auto driver_status = driver.Execute();
         EndFlag();
+
+        // Each re-block replaces the mesh, so it needs a fresh driver to carry on
+        while (Reblock::Pending()) {
+            pmesh = Reblock::Rebuild(pman);
+            KHARMADriver next_driver(pin, papp, pmesh);
+            Flag("driver.Execute");
+            driver_status = next_driver.Execute();
+            EndFlag();
+        }
+
+        Roofline::Print();
+        Timeline::Write();
     }
 
+    // Clean up any MPI-IO hints we set for the run
+    KHARMA::FinishIOAggregation();
+    // Free halo exchange buffers & requests while Kokkos and MPI are still up
+    HaloExchange::Finalize();
+
     // Parthenon cleanup includes Kokkos, MPI
     Flag("ParthenonFinalize");
     pman.ParthenonFinalize();
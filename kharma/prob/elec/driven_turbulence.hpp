@@ -35,6 +35,7 @@
 
 #include "decs.hpp"
 #include "gaussian.hpp"
+#include "transients.hpp"
 #include "types.hpp"
 
 #include <parthenon/parthenon.hpp>
@@ -105,7 +106,7 @@ void ApplyDrivingTurbulence(MeshBlockData<Real> *rc)
     GridScalar rho = rc->Get("prims.rho").data;
     GridVector uvec = rc->Get("prims.uvec").data;
     GridVector B_P = rc->Get("prims.B").data;
-    GridVector grf_normalized = rc->Get("grf_normalized").data;
+    GridVector grf_normalized = rc->Get(Transients::Name("grf_normalized")).data;
     const Real t = pmb->packages.Get("Globals")->Param<Real>("time");
     Real counter = pmb->packages.Get("GRMHD")->Param<Real>("counter");
     const Real dt_kick=  pmb->packages.Get("GRMHD")->Param<Real>("dt_kick");
@@ -117,7 +118,7 @@ void ApplyDrivingTurbulence(MeshBlockData<Real> *rc)
         const Real lx1=  pmb->packages.Get("GRMHD")->Param<Real>("lx1");
         const Real lx2=  pmb->packages.Get("GRMHD")->Param<Real>("lx2");
         const Real edot= pmb->packages.Get("GRMHD")->Param<Real>("drive_edot");
-        GridScalar alfven_speed = rc->Get("alfven_speed").data;
+        GridScalar alfven_speed = rc->Get(Transients::Name("alfven_speed")).data;
         
         int Nx1 = pmb->cellbounds.ncellsi(IndexDomain::interior);
         int Nx2 = pmb->cellbounds.ncellsj(IndexDomain::interior);
@@ -68,6 +68,65 @@ TaskStatus InitializeFMTorus(std::shared_ptr<MeshBlockData<Real>>& rc, Parameter
     // Fishbone-Moncrief parameters
     Real l = lfish_calc(a, rmax);
 
+    // Find rho_max "analytically" by looking over the whole mesh domain for the maximum in the midplane
+    // Done device-side for speed (for large 2D meshes this may get bad) but may work fine in HostSpace
+    // Note this covers the full domain on each rank: it doesn't need a grid so it's not a memory problem,
+    // and an MPI synch as is done for beta_min would be a headache
+    GReal x1min = pmb->pmy_mesh->mesh_size.xmin(X1DIR); // TODO probably could get domain from GRCoords
+    GReal x1max = pmb->pmy_mesh->mesh_size.xmax(X1DIR);
+    // Add back 2D if torus solution may not be largest in midplane (before tilt ofc)
+    //GReal x2min = pmb->pmy_mesh->mesh_size.x2min;
+    //GReal x2max = pmb->pmy_mesh->mesh_size.x2max;
+    GReal dx = 0.001;
+    int nx1 = (x1max - x1min) / dx;
+    //int nx2 = (x2max - x2min) / dx;
+
+    // If we print diagnostics, do so only from block 0 as the others do exactly the same thing
+    // Since this is initialization, we are guaranteed to have a block 0
+    if (pmb->gid == 0 && pmb->packages.Get("Globals")->Param<int>("verbose") > 0) {
+        std::cout << "Calculating maximum density:" << std::endl;
+        std::cout << "a = " << a << std::endl;
+        std::cout << "dx = " << dx << std::endl;
+        std::cout << "x1min->x1max: " << x1min << " " << x1max << std::endl;
+        std::cout << "nx1 = " << nx1 << std::endl;
+        //cout << "x2min->x2max: " << x2min << " " << x2max << std::endl;
+        //cout << "nx2 = " << nx2 << std::endl;
+    }
+
+    // Every block finds the same maximum, so only the first block initialized on this rank
+    // actually computes it.  The rest read the value back from the GRMHD package.
+    auto& grmhd_params = pmb->packages.Get("GRMHD")->AllParams();
+    Real rho_max = 0;
+    if (grmhd_params.hasKey("rho_norm")) {
+        rho_max = grmhd_params.Get<Real>("rho_norm");
+    } else {
+        Kokkos::Max<Real> max_reducer(rho_max);
+        pmb->par_reduce("fm_torus_maxrho", 0, nx1,
+            KOKKOS_LAMBDA (const int &i, parthenon::Real &local_result) {
+                GReal x1 = x1min + i*dx;
+                //GReal x2 = x2min + j*dx;
+                GReal Xnative[GR_DIM] = {0,x1,0,0};
+                GReal Xembed[GR_DIM];
+                G.coords.coord_to_embed(Xnative, Xembed);
+                const GReal r = Xembed[1];
+                // Regardless of native coordinate shenanigans,
+                // set th=pi/2 since the midplane is densest in the solution
+                const GReal rho = fm_torus_rho(a, rin, rmax, gam, kappa, r, M_PI/2.);
+                // TODO umax for printing/recording?
+
+                // Record max
+                if (rho > local_result) local_result = rho;
+            }
+        , max_reducer);
+
+        // Record normalization factor
+        grmhd_params.Add("rho_norm", rho_max);
+    }
+    // Print it
+    if (pmb->gid == 0 && pmb->packages.Get("Globals")->Param<int>("verbose") > 0) {
+        std::cout << "Initial maximum density is " << rho_max << std::endl;
+    }
+
     pmb->par_for("fm_torus_init", ks, ke, js, je, is, ie,
         KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
             GReal Xnative[GR_DIM], Xembed[GR_DIM], Xmidplane[GR_DIM];
@@ -118,8 +177,9 @@ TaskStatus InitializeFMTorus(std::shared_ptr<MeshBlockData<Real>>& rc, Parameter
                 G.gcon(Loci::center, j, i, gcon);
                 fourvel_to_prim(gcon, ucon_native, u_prim);
 
-                rho(k, j, i) = rho_l;
-                u(k, j, i) = u_l;
+                // Normalize so that the maximum density is 1
+                rho(k, j, i) = rho_l / rho_max;
+                u(k, j, i) = u_l / rho_max;
                 uvec(0, k, j, i) = u_prim[0];
                 uvec(1, k, j, i) = u_prim[1];
                 uvec(2, k, j, i) = u_prim[2];
@@ -127,66 +187,6 @@ TaskStatus InitializeFMTorus(std::shared_ptr<MeshBlockData<Real>>& rc, Parameter
         }
     );
 
-    // Find rho_max "analytically" by looking over the whole mesh domain for the maximum in the midplane
-    // Done device-side for speed (for large 2D meshes this may get bad) but may work fine in HostSpace
-    // Note this covers the full domain on each rank: it doesn't need a grid so it's not a memory problem,
-    // and an MPI synch as is done for beta_min would be a headache
-    GReal x1min = pmb->pmy_mesh->mesh_size.xmin(X1DIR); // TODO probably could get domain from GRCoords
-    GReal x1max = pmb->pmy_mesh->mesh_size.xmax(X1DIR);
-    // Add back 2D if torus solution may not be largest in midplane (before tilt ofc)
-    //GReal x2min = pmb->pmy_mesh->mesh_size.x2min;
-    //GReal x2max = pmb->pmy_mesh->mesh_size.x2max;
-    GReal dx = 0.001;
-    int nx1 = (x1max - x1min) / dx;
-    //int nx2 = (x2max - x2min) / dx;
-
-    // If we print diagnostics, do so only from block 0 as the others do exactly the same thing
-    // Since this is initialization, we are guaranteed to have a block 0
-    if (pmb->gid == 0 && pmb->packages.Get("Globals")->Param<int>("verbose") > 0) {
-        std::cout << "Calculating maximum density:" << std::endl;
-        std::cout << "a = " << a << std::endl;
-        std::cout << "dx = " << dx << std::endl;
-        std::cout << "x1min->x1max: " << x1min << " " << x1max << std::endl;
-        std::cout << "nx1 = " << nx1 << std::endl;
-        //cout << "x2min->x2max: " << x2min << " " << x2max << std::endl;
-        //cout << "nx2 = " << nx2 << std::endl;
-    }
-
-    // TODO split this out
-    Real rho_max = 0;
-    Kokkos::Max<Real> max_reducer(rho_max);
-    pmb->par_reduce("fm_torus_maxrho", 0, nx1,
-        KOKKOS_LAMBDA (const int &i, parthenon::Real &local_result) {
-            GReal x1 = x1min + i*dx;
-            //GReal x2 = x2min + j*dx;
-            GReal Xnative[GR_DIM] = {0,x1,0,0};
-            GReal Xembed[GR_DIM];
-            G.coords.coord_to_embed(Xnative, Xembed);
-            const GReal r = Xembed[1];
-            // Regardless of native coordinate shenanigans,
-            // set th=pi/2 since the midplane is densest in the solution
-            const GReal rho = fm_torus_rho(a, rin, rmax, gam, kappa, r, M_PI/2.);
-            // TODO umax for printing/recording?
-
-            // Record max
-            if (rho > local_result) local_result = rho;
-        }
-    , max_reducer);
-
-    // Record and print normalization factor
-    if(! (pmb->packages.Get("GRMHD")->AllParams().hasKey("rho_norm")))
-        pmb->packages.Get("GRMHD")->AllParams().Add("rho_norm", rho_max);
-    if (pmb->gid == 0 && pmb->packages.Get("Globals")->Param<int>("verbose") > 0) {
-        std::cout << "Initial maximum density is " << rho_max << std::endl;
-    }
-
-    pmb->par_for("fm_torus_normalize", ks, ke, js, je, is, ie,
-        KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
-            rho(k, j, i) /= rho_max;
-            u(k, j, i) /= rho_max;
-        }
-    );
-
     // Apply floors to initialize the rest of the domain (regardless whether we'll use them later)
     // Since the conserved vars U are not initialized, this is effectively done in *fluid frame*,
     // even if NOF frame is chosen (iharm3d does the same iiuc)
@@ -44,6 +44,7 @@
 #include "emhd.hpp"
 #include "floors.hpp"
 #include "flux.hpp"
+#include "fourth_order.hpp"
 #include "gr_coordinates.hpp"
 #include "grmhd.hpp"
 #include "kharma.hpp"
@@ -71,6 +72,10 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
     auto& pkgs = pmesh->packages.AllPackages();
 
     auto prob_name = pin->GetString("parthenon/job", "problem_id");
+    const bool is_torus = prob_name == "torus";
+
+    // Record how long each of the below takes
+    StartupTimer timer;
 
     // Magnetic field operations
     if (pin->GetString("b_field", "solver") != "none") {
@@ -78,16 +83,19 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
         if (pin->GetOrAddString("b_field", "type", "none") != "none" && !is_restart) {
             // B field init is not stencil-1, needs boundaries sync'd.
             // FreezeDirichlet ensures any Dirichlet conditions aren't overwritten by zeros
+            // Torus fields are seeded from the analytic density, so they need no sync
+            timer.Start("SeedSync");
             KBoundaries::FreezeDirichlet(md);
-            KHARMADriver::SyncAllBounds(md);
+            if (!is_torus) KHARMADriver::SyncAllBounds(md);
 
             // Then init B field over the mesh...
+            timer.Start("SeedBField");
             SeedBField(md.get(), pin);
 
             // If we're doing a torus problem or explicitly ask for it,
             // normalize the magnetic field according to the max density
-            bool is_torus = prob_name == "torus";
             if (pin->GetOrAddBoolean("b_field", "norm", is_torus)) {
+                timer.Start("NormalizeBField");
                 NormalizeBField(md.get(), pin);
             }
         }
@@ -96,6 +104,7 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
     // Add any hotspots *after* we've seeded fields,
     // since seeding may be based on density
     if (pin->GetOrAddBoolean("blob", "add_blob", false)) {
+        timer.Start("InsertBlob");
         for (auto &pmb : pmesh->block_list) {
             auto rc = pmb->meshblock_data.Get();
             // This inserts only in vicinity of some global r,th,phi
@@ -105,6 +114,7 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
 
     // Any extra cleanup & init especially when restarting
     if (is_restart) {
+        timer.Start("RestartFixes");
         // Parthenon restores all parameters (global vars) when restarting,
         // but KHARMA needs a few (currently one) reset instead
         KHARMA::ResetGlobals(pin, pmesh);
@@ -134,26 +144,25 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
         }
     }
 
-    if (pin->GetString("b_field", "solver") != "none") {
-        // Regardless of how we initialized, if evolving a field we should print max(divB)
-        // divB is not stencil-1, and we may or may not have initialized or read it
-        // Either way, we still need another sync, so it works out
+    // Regardless of how we initialized, if evolving a field we should print max(divB).
+    // divB is not stencil-1, so it needs a sync first.  If nothing below modifies the state
+    // between here and the final sync, we just print divB after that sync rather than
+    // adding another one here.
+    const bool print_divb = pin->GetString("b_field", "solver") != "none";
+    const bool reinit_electrons = pkgs.count("Electrons") && pin->GetOrAddBoolean("electrons", "reinitialize", false);
+    const bool merge_syncs = !pkgs.count("B_Cleanup") && !reinit_electrons;
+    if (print_divb && !merge_syncs) {
+        timer.Start("DivBSync");
         KBoundaries::FreezeDirichlet(md);
         KHARMADriver::SyncAllBounds(md);
-
-        if (pkgs.count("B_FluxCT")) {
-            B_FluxCT::PrintGlobalMaxDivB(md.get());
-        } else if (pkgs.count("B_CT")) {
-            B_CT::PrintGlobalMaxDivB(md.get());
-        } else if (pkgs.count("B_CD")) {
-            //B_CD::PrintGlobalMaxDivB(md.get());
-        }
+        PrintGlobalMaxDivB(md.get());
     }
 
     // Clean the B field, generally for resizing/restarting
     // We call this function any time the package is loaded:
     // if we decided to load it in kharma.cpp, we need to clean.
     if (pkgs.count("B_Cleanup")) {
+        timer.Start("B_Cleanup");
         if (pin->GetOrAddBoolean("b_cleanup", "output_before_cleanup", false)) {
             auto tm = SimTime(0., 0., 0, 0, 0, 0, 0.);
             auto pouts = std::make_unique<Outputs>(pmesh, pin, &tm);
@@ -173,7 +182,8 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
 
     // The e- initialization is called during problem initialization, but we want an option
     // to force it -- for example, if restarting an ideal GRMHD run, 
-    if (pkgs.count("Electrons") && pin->GetOrAddBoolean("electrons", "reinitialize", false)) {
+    if (reinit_electrons) {
+        timer.Start("ReinitElectrons");
         std::cout << "Reinitializing electron temperatures!" << std::endl;
         Electrons::MeshInitElectrons(md.get(), pin);
         // We probably don't want to do this again next time we restart
@@ -183,11 +193,36 @@ void KHARMA::PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart)
     // If PtoU was called before the B field was initialized or corrected,
     // the total energy might be wrong.  Now that we have the field,
     // wipe away any temporary "totals" which may have omitted it
+    timer.Start("PtoU");
     Flux::MeshPtoU(md.get(), IndexDomain::entire);
+    // Problems initialize point values.  The fourth-order scheme evolves cell averages
+    if (!is_restart && pmesh->packages.Get("Flux")->Param<bool>("fourth_order"))
+        Flux::ConsToAverage(md.get());
 
     // Finally, synchronize boundary values.
     // Freeze any Dirichlet physical boundaries as they are now, after cleanup/sync/etc.
+    timer.Start("FinalSync");
     KBoundaries::FreezeDirichlet(md);
     // This is the first sync if there is no B field
     KHARMADriver::SyncAllBounds(md);
+
+    if (print_divb && merge_syncs) {
+        PrintGlobalMaxDivB(md.get());
+    }
+
+    if (pmesh->packages.Get("Globals")->Param<int>("verbose") > 0) {
+        timer.Print("PostInitialize");
+    }
+}
+
+void KHARMA::PrintGlobalMaxDivB(MeshData<Real> *md)
+{
+    auto& pkgs = md->GetMeshPointer()->packages.AllPackages();
+    if (pkgs.count("B_FluxCT")) {
+        B_FluxCT::PrintGlobalMaxDivB(md);
+    } else if (pkgs.count("B_CT")) {
+        B_CT::PrintGlobalMaxDivB(md);
+    } else if (pkgs.count("B_CD")) {
+        //B_CD::PrintGlobalMaxDivB(md);
+    }
 }
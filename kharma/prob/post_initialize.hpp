@@ -59,4 +59,10 @@ void SeedAndNormalizeB(ParameterInput *pin, std::shared_ptr<MeshData<Real>> md);
  */
 void PostInitialize(ParameterInput *pin, Mesh *pmesh, bool is_restart);
 
+/**
+ * Print the maximum divB over the whole mesh, according to whichever field transport is loaded.
+ * Requires ghost zones to be sync'd.
+ */
+void PrintGlobalMaxDivB(MeshData<Real> *md);
+
 }
@@ -478,10 +478,12 @@ TaskStatus NormalizeBField(MeshData<Real> *md, ParameterInput *pin)
     Real beta_calc_legacy = pin->GetOrAddBoolean("b_field", "legacy_norm", true);
 
     // Calculate current beta_min value
-    Real bsq_max, p_max, beta_min;
+    // The legacy version needs two maxima, which we reduce together in one MPI call
+    Real bsq_max = 0., p_max = 0., beta_min;
     if (beta_calc_legacy) {
-        bsq_max = MPIReduce_once(MaxBsq(md), MPI_MAX);
-        p_max = MPIReduce_once(MaxPressure(md), MPI_MAX);
+        std::vector<Real> maxes = MPIReduce_once(std::vector<Real>{MaxBsq(md), MaxPressure(md)}, MPI_MAX);
+        bsq_max = maxes[0];
+        p_max = maxes[1];
         beta_min = p_max / (0.5 * bsq_max);
     } else {
         beta_min = MPIReduce_once(MinBeta(md), MPI_MIN);
@@ -507,22 +509,29 @@ TaskStatus NormalizeBField(MeshData<Real> *md, ParameterInput *pin)
         }
     } // else yell?
 
-    // Measure again to check
-    if (verbose > 0) {
-        Real bsq_max, p_max, beta_min;
-        if (beta_calc_legacy) {
-            bsq_max = MPIReduce_once(MaxBsq(md), MPI_MAX);
-            p_max = MPIReduce_once(MaxPressure(md), MPI_MAX);
-            beta_min = p_max / (0.5 * bsq_max);
-        } else {
-            beta_min = MPIReduce_once(MinBeta(md), MPI_MIN);
+    // Print the new values.  B^2 scales exactly as norm^2, so we only
+    // re-measure over the whole mesh if we're asked to check things
+    const int extra_checks = pmesh->packages.Get("Globals")->Param<int>("extra_checks");
+    if (verbose > 0 && beta_min > 0) {
+        Real bsq_max_post = bsq_max * norm * norm;
+        Real p_max_post = p_max;
+        Real beta_min_post = beta_min / (norm * norm);
+        if (extra_checks > 0) {
+            if (beta_calc_legacy) {
+                std::vector<Real> maxes = MPIReduce_once(std::vector<Real>{MaxBsq(md), MaxPressure(md)}, MPI_MAX);
+                bsq_max_post = maxes[0];
+                p_max_post = maxes[1];
+                beta_min_post = p_max_post / (0.5 * bsq_max_post);
+            } else {
+                beta_min_post = MPIReduce_once(MinBeta(md), MPI_MIN);
+            }
         }
         if (MPIRank0()) {
             if (beta_calc_legacy) {
-                std::cout << "B^2 max post-norm: " << bsq_max << std::endl;
-                std::cout << "Pressure max post-norm: " << p_max << std::endl;
+                std::cout << "B^2 max post-norm: " << bsq_max_post << std::endl;
+                std::cout << "Pressure max post-norm: " << p_max_post << std::endl;
             }
-            std::cout << "Beta min post-norm: " << beta_min << std::endl;
+            std::cout << "Beta min post-norm: " << beta_min_post << std::endl;
         }
     }
 
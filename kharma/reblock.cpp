@@ -0,0 +1,421 @@
+/*
+ *  File: reblock.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "reblock.hpp"
+
+#include "domain.hpp"
+#include "halo_exchange.hpp"
+#include "kharma.hpp"
+#include "kharma_package.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using Reblock::Extent;
+
+namespace {
+
+int at_step = -1;
+std::string trigger_file;
+int check_every = 10;
+// New block sizes, 0 to keep the current size
+int new_nx[3] = {0, 0, 0};
+bool pending = false;
+
+// Inclusive range of global zone (or face) indices in X1-X3
+struct Box {
+    int lo[3], hi[3];
+    size_t Size() const
+    {
+        size_t size = 1;
+        for (int d = 0; d < 3; ++d) size *= (hi[d] >= lo[d]) ? hi[d] - lo[d] + 1 : 0;
+        return size;
+    }
+};
+
+Box Intersect(const Box& a, const Box& b)
+{
+    Box out;
+    for (int d = 0; d < 3; ++d) {
+        out.lo[d] = m::max(a.lo[d], b.lo[d]);
+        out.hi[d] = m::min(a.hi[d], b.hi[d]);
+    }
+    return out;
+}
+
+// How the Restart fields of any block are laid out in a flat buffer
+struct Layout {
+    int ntot[3];      // Mesh size in zones
+    int ncell, nface; // Cell-centered components & face fields
+
+    // Components are all cell fields, then each face field on X1, X2, X3 faces.
+    // Returns 0 for cells or 1-3 for faces
+    int Element(int c) const { return (c < ncell) ? 0 : 1 + (c - ncell) / nface; }
+    int NComponents() const { return ncell + 3 * nface; }
+
+    // Indices of element 'el' which block 'b' holds.  A face between two blocks is held by both,
+    // but owned (sent) only by the block above it, or at the top of the mesh by the block below
+    Box Elements(const Extent& b, int el, bool owned) const
+    {
+        Box box;
+        for (int d = 0; d < 3; ++d) {
+            box.lo[d] = b.off[d];
+            box.hi[d] = b.off[d] + b.n[d] - 1;
+            if (el == d + 1 && ntot[d] > 1 && (!owned || b.off[d] + b.n[d] == ntot[d]))
+                box.hi[d]++;
+        }
+        return box;
+    }
+
+    // Start of each component in a block's buffer, followed by the total size
+    std::vector<size_t> Offsets(const Extent& b) const
+    {
+        std::vector<size_t> offsets(1, 0);
+        for (int c = 0; c < NComponents(); ++c)
+            offsets.push_back(offsets.back() + Elements(b, Element(c), false).Size());
+        return offsets;
+    }
+};
+
+void CountFields(MeshBlock *pmb, Layout& lay)
+{
+    auto rc = pmb->meshblock_data.Get();
+    lay.ncell = rc->PackVariables(std::vector<MetadataFlag>{Metadata::Restart, Metadata::Cell}).GetDim(4);
+    lay.nface = rc->PackVariables(std::vector<MetadataFlag>{Metadata::Restart, Metadata::Face}).GetDim(4);
+}
+
+/**
+ * Copy all Restart fields of a block's interior into a host buffer, or back
+ */
+void CopyBlock(MeshBlock *pmb, const Extent& ext, const Layout& lay, std::vector<Real>& host, const bool to_buffer)
+{
+    auto rc = pmb->meshblock_data.Get();
+    auto C = rc->PackVariables(std::vector<MetadataFlag>{Metadata::Restart, Metadata::Cell});
+    auto F = rc->PackVariables(std::vector<MetadataFlag>{Metadata::Restart, Metadata::Face});
+    const IndexRange3 b = KDomain::GetRange(rc, IndexDomain::interior);
+    const auto offsets = lay.Offsets(ext);
+
+    ParArray1D<Real> buf("reblock_buf", offsets.back());
+    auto buf_host = Kokkos::create_mirror_view(buf);
+    if (!to_buffer) {
+        for (size_t n = 0; n < offsets.back(); ++n) buf_host(n) = host[n];
+        Kokkos::deep_copy(buf, buf_host);
+    }
+
+    for (int c = 0; c < lay.NComponents(); ++c) {
+        const int el = lay.Element(c);
+        const Box box = lay.Elements(ext, el, false);
+        const int n1 = box.hi[0] - box.lo[0] + 1, n2 = box.hi[1] - box.lo[1] + 1;
+        const int is = b.is, js = b.js, ks = b.ks;
+        const int ie = is + n1 - 1, je = js + n2 - 1, ke = ks + box.hi[2] - box.lo[2];
+        const size_t start = offsets[c];
+        if (el == 0) {
+            pmb->par_for("reblock_copy_cell", ks, ke, js, je, is, ie,
+                KOKKOS_LAMBDA (const int& k, const int& j, const int& i) {
+                    const size_t idx = start + ((size_t) (k - ks) * n2 + (j - js)) * n1 + (i - is);
+                    if (to_buffer) buf(idx) = C(c, k, j, i);
+                    else C(c, k, j, i) = buf(idx);
+                }
+            );
+        } else {
+            const TopologicalElement te = (el == 1) ? F1 : ((el == 2) ? F2 : F3);
+            const int l = (c - lay.ncell) % lay.nface;
+            pmb->par_for("reblock_copy_face", ks, ke, js, je, is, ie,
+                KOKKOS_LAMBDA (const int& k, const int& j, const int& i) {
+                    const size_t idx = start + ((size_t) (k - ks) * n2 + (j - js)) * n1 + (i - is);
+                    if (to_buffer) buf(idx) = F(te, l, k, j, i);
+                    else F(te, l, k, j, i) = buf(idx);
+                }
+            );
+        }
+    }
+
+    if (to_buffer) {
+        Kokkos::deep_copy(buf_host, buf);
+        host.assign(buf_host.data(), buf_host.data() + offsets.back());
+    }
+}
+
+/**
+ * Copy the elements in 'sub' between a block's buffer (of elements in 'full') and the end of a message,
+ * or from position 'pos' of a message back into the block
+ */
+void CopySub(const Box& full, const Box& sub, Real *block, std::vector<Real>& msg, size_t& pos, const bool to_msg)
+{
+    if (sub.Size() == 0) return;
+    const size_t n1 = full.hi[0] - full.lo[0] + 1, n2 = full.hi[1] - full.lo[1] + 1;
+    for (int k = sub.lo[2]; k <= sub.hi[2]; ++k)
+        for (int j = sub.lo[1]; j <= sub.hi[1]; ++j)
+            for (int i = sub.lo[0]; i <= sub.hi[0]; ++i) {
+                Real &val = block[((k - full.lo[2]) * n2 + (j - full.lo[1])) * n1 + (i - full.lo[0])];
+                if (to_msg) msg.push_back(val);
+                else val = msg[pos++];
+            }
+}
+
+/**
+ * Send each new block exactly the elements it needs, from whichever old blocks own them.
+ * Both sides walk old blocks in the outer loop and new blocks in the inner one, so the messages
+ * need no headers: the receiver knows every extent and can work out what comes next
+ */
+void Exchange(const Layout& lay, const std::vector<Extent>& old_all, std::vector<std::vector<Real>>& old_data,
+              const std::vector<Extent>& new_all, std::vector<std::vector<Real>>& new_data)
+{
+    const int nranks = MPINumRanks(), me = MPIRank();
+
+    std::vector<std::vector<Real>> send(nranks);
+    size_t unused = 0;
+    int nb_old = 0;
+    for (const auto& ob : old_all) {
+        if (ob.rank != me) continue;
+        const auto offsets = lay.Offsets(ob);
+        Real *block = old_data[nb_old++].data();
+        for (const auto& nb : new_all) {
+            for (int c = 0; c < lay.NComponents(); ++c) {
+                const int el = lay.Element(c);
+                const Box sub = Intersect(lay.Elements(ob, el, true), lay.Elements(nb, el, false));
+                CopySub(lay.Elements(ob, el, false), sub, block + offsets[c], send[nb.rank], unused, true);
+            }
+        }
+    }
+
+    std::vector<Real> recv;
+    std::vector<size_t> recv_start(nranks, 0);
+#if ENABLE_MPI
+    std::vector<int> send_counts(nranks), send_displs(nranks), recv_counts(nranks), recv_displs(nranks);
+    std::vector<Real> send_all;
+    for (int r = 0; r < nranks; ++r) {
+        if (send[r].size() > std::numeric_limits<int>::max())
+            throw std::runtime_error("Re-blocking message too large, use more ranks!");
+        send_counts[r] = send[r].size();
+        send_displs[r] = send_all.size();
+        send_all.insert(send_all.end(), send[r].begin(), send[r].end());
+        send[r].clear();
+    }
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    size_t total = 0;
+    for (int r = 0; r < nranks; ++r) {
+        recv_displs[r] = recv_start[r] = total;
+        total += recv_counts[r];
+    }
+    if (total > std::numeric_limits<int>::max())
+        throw std::runtime_error("Re-blocking message too large, use more ranks!");
+    recv.resize(total);
+    MPI_Alltoallv(send_all.data(), send_counts.data(), send_displs.data(), MPI_PARTHENON_REAL,
+                  recv.data(), recv_counts.data(), recv_displs.data(), MPI_PARTHENON_REAL, MPI_COMM_WORLD);
+#else
+    recv.swap(send[0]);
+#endif
+
+    for (int r = 0; r < nranks; ++r) {
+        size_t pos = recv_start[r];
+        for (const auto& ob : old_all) {
+            if (ob.rank != r) continue;
+            int nb_new = 0;
+            for (const auto& nb : new_all) {
+                if (nb.rank != me) continue;
+                const auto offsets = lay.Offsets(nb);
+                Real *block = new_data[nb_new++].data();
+                for (int c = 0; c < lay.NComponents(); ++c) {
+                    const int el = lay.Element(c);
+                    const Box full = lay.Elements(nb, el, false);
+                    const Box sub = Intersect(lay.Elements(ob, el, true), full);
+                    CopySub(full, sub, block + offsets[c], recv, pos, false);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+Reblock::Extent Reblock::GetExtent(MeshBlock *pmb, Mesh *pmesh)
+{
+    Extent ext;
+    ext.rank = MPIRank();
+    ext.gid = pmb->gid;
+    for (int d = 0; d < 3; ++d) {
+        const auto dir = static_cast<CoordinateDirection>(d + 1);
+        const Real dx = (pmesh->mesh_size.xmax(dir) - pmesh->mesh_size.xmin(dir)) / pmesh->mesh_size.nx(dir);
+        ext.off[d] = std::lround((pmb->block_size.xmin(dir) - pmesh->mesh_size.xmin(dir)) / dx);
+        ext.n[d] = pmb->block_size.nx(dir);
+    }
+    return ext;
+}
+
+std::vector<Reblock::Extent> Reblock::AllExtents(const std::vector<Extent>& mine)
+{
+#if ENABLE_MPI
+    constexpr int nint = sizeof(Extent) / sizeof(int);
+    int my_count = mine.size() * nint;
+    std::vector<int> counts(MPINumRanks()), displs(MPINumRanks(), 0);
+    MPI_Allgather(&my_count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    int total = 0;
+    for (int r = 0; r < MPINumRanks(); ++r) {
+        displs[r] = total;
+        total += counts[r];
+    }
+    std::vector<Extent> all(total / nint);
+    MPI_Allgatherv(mine.data(), my_count, MPI_INT, all.data(), counts.data(), displs.data(),
+                   MPI_INT, MPI_COMM_WORLD);
+    return all;
+#else
+    return mine;
+#endif
+}
+
+void Reblock::Initialize(ParameterInput *pin)
+{
+    at_step = pin->GetOrAddInteger("reblock", "at_step", -1);
+    trigger_file = pin->GetOrAddString("reblock", "trigger_file", "");
+    check_every = m::max(pin->GetOrAddInteger("reblock", "check_every", 10), 1);
+    new_nx[0] = pin->GetOrAddInteger("reblock", "nx1", 0);
+    new_nx[1] = pin->GetOrAddInteger("reblock", "nx2", 0);
+    new_nx[2] = pin->GetOrAddInteger("reblock", "nx3", 0);
+    // Runs started from iharm3d files rebuild conserved variables from primitives when "restarting",
+    // which we don't want to repeat mid-run
+    if ((at_step > 0 || !trigger_file.empty()) &&
+        pin->GetString("parthenon/job", "problem_id") == "resize_restart") {
+        if (MPIRank0()) std::cerr << "WARNING: re-blocking disabled for runs started with resize_restart" << std::endl;
+        at_step = -1;
+        trigger_file = "";
+    }
+}
+
+bool Reblock::CheckTrigger(int ncycle)
+{
+    if (pending) return true;
+
+    if (at_step > 0 && ncycle + 1 == at_step) {
+        pending = true;
+    } else if (!trigger_file.empty() && ncycle % check_every == 0) {
+        // Only rank 0 looks, so every rank agrees on when to stop
+        int msg[4] = {0, new_nx[0], new_nx[1], new_nx[2]};
+        if (MPIRank0()) {
+            std::ifstream trigger(trigger_file);
+            if (trigger.good()) {
+                msg[0] = 1;
+                int nx;
+                for (int d = 0; d < 3 && (trigger >> nx); ++d) msg[d + 1] = nx;
+                trigger.close();
+                std::remove(trigger_file.c_str());
+            }
+        }
+#if ENABLE_MPI
+        MPI_Bcast(msg, 4, MPI_INT, 0, MPI_COMM_WORLD);
+#endif
+        pending = msg[0];
+        for (int d = 0; d < 3; ++d) new_nx[d] = msg[d + 1];
+    }
+
+    if (pending && MPIRank0())
+        std::cout << "Re-blocking after step " << ncycle << std::endl;
+    return pending;
+}
+
+bool Reblock::Pending() { return pending; }
+
+Mesh *Reblock::Rebuild(ParthenonManager &pman)
+{
+    Flag("Reblock::Rebuild");
+    auto pin = pman.pinput.get();
+    auto papp = pman.app_input.get();
+    Mesh *pmesh = pman.pmesh.get();
+    if (pmesh->multilevel)
+        throw std::runtime_error("Refined meshes cannot be re-blocked in-process!");
+
+    // Copy everything off the old blocks
+    Layout lay;
+    for (int d = 0; d < 3; ++d)
+        lay.ntot[d] = pmesh->mesh_size.nx(static_cast<CoordinateDirection>(d + 1));
+    CountFields(pmesh->block_list[0].get(), lay);
+    std::vector<Extent> old_mine;
+    std::vector<std::vector<Real>> old_data;
+    for (auto &pmb : pmesh->block_list) {
+        old_mine.push_back(GetExtent(pmb.get(), pmesh));
+        old_data.emplace_back();
+        CopyBlock(pmb.get(), old_mine.back(), lay, old_data.back(), true);
+    }
+    const auto old_all = AllExtents(old_mine);
+
+    for (int d = 0; d < 3; ++d)
+        if (new_nx[d] > 0) pin->SetInteger("parthenon/meshblock", "nx" + std::to_string(d + 1), new_nx[d]);
+
+    // Drop the old mesh before building the new one, so we only ever hold one copy of the
+    // grid & geometry, plus the state in host memory.  Then rebuild exactly as when restarting,
+    // except for the problem generator: we fill in the state ourselves
+    HaloExchange::Finalize();
+    pman.pmesh.reset();
+    Packages_t packages = KHARMA::ProcessPackages(pman.pinput);
+    pman.pmesh = std::make_unique<Mesh>(pin, papp, packages);
+    pmesh = pman.pmesh.get();
+    // The new Mesh may well land at the old one's address
+    Packages::BuildCallbackPlan(pmesh);
+    pmesh->Initialize(false, pin, papp);
+
+    Layout new_lay = lay;
+    CountFields(pmesh->block_list[0].get(), new_lay);
+    if (new_lay.ncell != lay.ncell || new_lay.nface != lay.nface)
+        throw std::runtime_error("Re-blocked mesh has different fields than the original!");
+
+    std::vector<Extent> new_mine;
+    std::vector<std::vector<Real>> new_data;
+    for (auto &pmb : pmesh->block_list) {
+        new_mine.push_back(GetExtent(pmb.get(), pmesh));
+        new_data.emplace_back(lay.Offsets(new_mine.back()).back());
+    }
+    Exchange(lay, old_all, old_data, AllExtents(new_mine), new_data);
+    old_data.clear();
+    for (int b = 0; b < pmesh->block_list.size(); ++b)
+        CopyBlock(pmesh->block_list[b].get(), new_mine[b], lay, new_data[b], false);
+    new_data.clear();
+
+    // Derived variables, ghost zones, Dirichlet boundaries
+    HaloExchange::Initialize(pin, pmesh);
+    KHARMA::PostInitialize(pin, pmesh, true);
+
+    pending = false;
+    if (MPIRank0()) {
+        std::cout << "Re-blocked into " << pmesh->nbtotal << " meshblocks of "
+                  << pin->GetInteger("parthenon/meshblock", "nx1") << "x"
+                  << pin->GetInteger("parthenon/meshblock", "nx2") << "x"
+                  << pin->GetInteger("parthenon/meshblock", "nx3") << std::endl;
+    }
+    EndFlag();
+    return pmesh;
+}
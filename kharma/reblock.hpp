@@ -0,0 +1,105 @@
+/*
+ *  File: reblock.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+
+#include <parthenon/parthenon.hpp>
+
+#include <vector>
+
+/**
+ * In-process re-blocking: redistribute a running simulation onto new meshblock sizes,
+ * moving the data over MPI instead of writing and re-reading a restart file.
+ *
+ * A re-block is requested either at a fixed step (reblock/at_step), or by creating the file
+ * reblock/trigger_file while running, which is checked every reblock/check_every steps.
+ * New block sizes are read from the trigger file if it contains them ("nx1 nx2 nx3"),
+ * otherwise from reblock/nx1-3.  The trigger file is removed once it's been seen.
+ *
+ * When requested, the current driver finishes its step and stops.  The state (all fields flagged Restart)
+ * is copied off the blocks, the Mesh is rebuilt with the new block sizes (re-balanced over the same ranks),
+ * each new block receives exactly the zones it covers from whichever ranks held them, and
+ * the usual post-restart initialization runs before a new driver carries on from the same step.
+ * Outputs marked "final" are also written when stopping, and simply overwritten at the real end.
+ *
+ * The physical grid never changes: this only re-cuts it.  Changing the resolution needs interpolation,
+ * which is still done by restarting from a file with problem_id=resize_restart.
+ * Statically or adaptively refined meshes are not supported.
+ */
+namespace Reblock {
+
+/**
+ * Where a block sits in the global grid: index of its first interior zone, and its size in zones.
+ * Just ints, so lists of these can be gathered with MPI_INT.  Also used to find neighbors by HaloExchange
+ */
+struct Extent {
+    int rank, gid;
+    int off[3], n[3];
+};
+
+/**
+ * Extent of a block on this rank
+ */
+Extent GetExtent(MeshBlock *pmb, Mesh *pmesh);
+
+/**
+ * Gather the extents of all blocks on all ranks, in order of rank and then of each rank's list.  Collective
+ */
+std::vector<Extent> AllExtents(const std::vector<Extent>& mine);
+
+/**
+ * Read options.  Call once, before the first driver is executed
+ */
+void Initialize(ParameterInput *pin);
+
+/**
+ * Check whether to re-block after the step starting at 'ncycle'.  Collective over all ranks.
+ * Returns true (on all ranks) if the driver should stop after this step
+ */
+bool CheckTrigger(int ncycle);
+
+/**
+ * Whether a re-block was triggered and hasn't happened yet
+ */
+bool Pending();
+
+/**
+ * Re-block the mesh held by 'pman', replacing it.  Collective.
+ * The old mesh, and anything holding pointers into it (e.g. its driver), must not be used afterward.
+ * Returns the new mesh.
+ */
+Mesh *Rebuild(ParthenonManager &pman);
+
+}
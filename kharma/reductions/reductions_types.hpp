@@ -113,4 +113,45 @@ struct ArraySum {
   KOKKOS_INLINE_FUNCTION
   bool references_scalar() const { return true; }
 };
+
+// Reduce an array whose first element is a maximum and whose other elements are sums,
+// e.g. the max of some non-negative quantity along with the sum & count needed for its RMS.
+// Initialized to zero, so only for non-negative maxima
+template <class T, class Space, int N>
+struct ArrayMaxSum {
+ public:
+  // Required
+  typedef ArrayMaxSum reducer;
+  typedef array_type<T, N> value_type;
+  typedef Kokkos::View<value_type*, Space, Kokkos::MemoryUnmanaged>
+      result_view_type;
+
+ private:
+  value_type& value;
+
+ public:
+  KOKKOS_INLINE_FUNCTION
+  ArrayMaxSum(value_type& value_) : value(value_) {}
+
+  // Required
+  KOKKOS_INLINE_FUNCTION
+  void join(value_type& dest, const value_type& src) const {
+    if (src.my_array[0] > dest.my_array[0]) dest.my_array[0] = src.my_array[0];
+    for (int i = 1; i < N; i++) {
+      dest.my_array[i] += src.my_array[i];
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type& val) const { val.init(); }
+
+  KOKKOS_INLINE_FUNCTION
+  value_type& reference() const { return value; }
+
+  KOKKOS_INLINE_FUNCTION
+  result_view_type view() const { return result_view_type(&value, 1); }
+
+  KOKKOS_INLINE_FUNCTION
+  bool references_scalar() const { return true; }
+};
 }
\ No newline at end of file
@@ -0,0 +1,428 @@
+/*
+ *  File: region_output.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "region_output.hpp"
+
+#include "domain.hpp"
+#include "kharma.hpp"
+#include "kharma_package.hpp"
+
+#include <hdf5.h>
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct Stream {
+    std::string block, prefix, region;
+    std::vector<std::string> variables;
+    Real dt;
+    // Limits in whichever coordinates 'region' names
+    GReal lo[3], hi[3];
+    bool single_precision;
+};
+
+std::vector<Stream> streams;
+
+// Points per direction tested against non-native regions
+constexpr int NSAMPLE = 9;
+
+bool InRange(const GReal x, const GReal lo, const GReal hi) { return x >= lo && x <= hi; }
+
+bool BlockInRegion(MeshBlock *pmb, const Stream& s)
+{
+    GReal xmin[3], xmax[3];
+    for (int d = 0; d < 3; ++d) {
+        const auto dir = static_cast<CoordinateDirection>(d + 1);
+        xmin[d] = pmb->block_size.xmin(dir);
+        xmax[d] = pmb->block_size.xmax(dir);
+    }
+    if (s.region == "native") {
+        bool overlap = true;
+        for (int d = 0; d < 3; ++d) overlap = overlap && xmin[d] <= s.hi[d] && xmax[d] >= s.lo[d];
+        return overlap;
+    }
+
+    const auto& emb = pmb->coords.coords;
+    const int n3 = (pmb->block_size.nx(X3DIR) > 1) ? NSAMPLE : 1;
+    const int n2 = (pmb->block_size.nx(X2DIR) > 1) ? NSAMPLE : 1;
+    for (int c = 0; c < n3; ++c) {
+        for (int b = 0; b < n2; ++b) {
+            for (int a = 0; a < NSAMPLE; ++a) {
+                GReal X[GR_DIM] = {0.,
+                    xmin[0] + (xmax[0] - xmin[0]) * a / (NSAMPLE - 1),
+                    (n2 > 1) ? xmin[1] + (xmax[1] - xmin[1]) * b / (n2 - 1) : (xmin[1] + xmax[1]) / 2,
+                    (n3 > 1) ? xmin[2] + (xmax[2] - xmin[2]) * c / (n3 - 1) : (xmin[2] + xmax[2]) / 2};
+                const bool inside = (s.region == "spherical") ?
+                    InRange(emb.r_of(X), s.lo[0], s.hi[0]) && InRange(emb.th_of(X), s.lo[1], s.hi[1]) &&
+                    InRange(emb.phi_of(X), s.lo[2], s.hi[2]) :
+                    InRange(emb.x_of(X), s.lo[0], s.hi[0]) && InRange(emb.y_of(X), s.lo[1], s.hi[1]) &&
+                    InRange(emb.z_of(X), s.lo[2], s.hi[2]);
+                if (inside) return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool VariableSelected(const std::string& label, const std::vector<std::string>& variables)
+{
+    for (const auto &var : variables)
+        if (label == var || label.rfind(var + ".", 0) == 0) return true;
+    return false;
+}
+
+template<typename T> hid_t H5Type();
+template<> hid_t H5Type<int>() { return H5T_NATIVE_INT; }
+template<> hid_t H5Type<int64_t>() { return H5T_NATIVE_INT64; }
+template<> hid_t H5Type<float>() { return H5T_NATIVE_FLOAT; }
+template<> hid_t H5Type<double>() { return H5T_NATIVE_DOUBLE; }
+
+template<typename T>
+void WriteAttribute(hid_t loc, const std::string& name, const std::vector<T>& vals)
+{
+    const hsize_t n = vals.size();
+    hid_t space = H5Screate_simple(1, &n, nullptr);
+    hid_t attr = H5Acreate2(loc, name.c_str(), H5Type<T>(), space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, H5Type<T>(), vals.data());
+    H5Aclose(attr);
+    H5Sclose(space);
+}
+
+// Strings go in fixed-length arrays, padded to the longest
+void WriteAttribute(hid_t loc, const std::string& name, const std::vector<std::string>& vals, const bool scalar=false)
+{
+    size_t len = 1;
+    for (const auto &val : vals) len = m::max(len, val.size() + 1);
+    std::vector<char> buf(len * vals.size(), '\0');
+    for (size_t n = 0; n < vals.size(); ++n) vals[n].copy(&buf[n * len], vals[n].size());
+
+    hid_t type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(type, len);
+    const hsize_t n = vals.size();
+    hid_t space = (scalar) ? H5Screate(H5S_SCALAR) : H5Screate_simple(1, &n, nullptr);
+    hid_t attr = H5Acreate2(loc, name.c_str(), type, space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, type, buf.data());
+    H5Aclose(attr);
+    H5Sclose(space);
+    H5Tclose(type);
+}
+
+/**
+ * Write a dataset of shape [nb_total, dims...], of which this rank holds 'nb' blocks starting at 'offset'.
+ * Collective: every rank calls this, even with no blocks
+ */
+template<typename T>
+void WriteBlocks(hid_t file, const std::string& name, const std::vector<hsize_t>& dims,
+                 const hsize_t nb_total, const hsize_t offset, const hsize_t nb, const std::vector<T>& data)
+{
+    std::vector<hsize_t> fdims{nb_total}, start{offset}, count{nb};
+    for (const auto &dim : dims) {
+        fdims.push_back(dim);
+        start.push_back(0);
+        count.push_back(dim);
+    }
+    hid_t filespace = H5Screate_simple(fdims.size(), fdims.data(), nullptr);
+    hid_t memspace = H5Screate_simple(count.size(), count.data(), nullptr);
+    if (nb > 0) {
+        H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+    } else {
+        H5Sselect_none(filespace);
+        H5Sselect_none(memspace);
+    }
+    hid_t dset = H5Dcreate2(file, name.c_str(), H5Type<T>(), filespace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+#if ENABLE_MPI
+    H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+#endif
+    if (H5Dwrite(dset, H5Type<T>(), memspace, filespace, dxpl, data.data()) < 0)
+        throw std::runtime_error("Could not write region output dataset " + name);
+    H5Pclose(dxpl);
+    H5Dclose(dset);
+    H5Sclose(memspace);
+    H5Sclose(filespace);
+}
+
+/**
+ * Append the interior of the named cell-centered field on a block to 'out', ordered (component, k, j, i)
+ */
+template<typename T>
+void AppendInterior(MeshBlock *pmb, const std::string& name, std::vector<T>& out)
+{
+    auto rc = pmb->meshblock_data.Get();
+    auto q = rc->PackVariables(std::vector<std::string>{name});
+    const IndexRange3 b = KDomain::GetRange(rc, IndexDomain::interior);
+    const int nvar = q.GetDim(4);
+    const int n1 = b.ie - b.is + 1, n2 = b.je - b.js + 1, n3 = b.ke - b.ks + 1;
+
+    ParArray1D<Real> buf("region_output_buf", nvar * n3 * n2 * n1);
+    pmb->par_for("region_output_copy", 0, nvar - 1, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int& v, const int& k, const int& j, const int& i) {
+            buf((((size_t) v * n3 + (k - b.ks)) * n2 + (j - b.js)) * n1 + (i - b.is)) = q(v, k, j, i);
+        }
+    );
+    auto buf_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), buf);
+    for (size_t n = 0; n < buf_host.extent(0); ++n) out.push_back(static_cast<T>(buf_host(n)));
+}
+
+} // namespace
+
+std::shared_ptr<KHARMAPackage> RegionOutput::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
+{
+    auto pkg = std::make_shared<KHARMAPackage>("RegionOutput");
+
+    const std::string problem_id = pin->GetString("parthenon/job", "problem_id");
+    streams.clear();
+    for (int n = 0; pin->DoesBlockExist("region_output" + std::to_string(n)); ++n) {
+        Stream s;
+        s.block = "region_output" + std::to_string(n);
+        s.dt = pin->GetReal(s.block, "dt");
+        if (s.dt <= 0.) throw std::invalid_argument("Region output "+s.block+" must have dt > 0!");
+        s.prefix = pin->GetOrAddString(s.block, "file_prefix", problem_id + ".region" + std::to_string(n));
+        std::stringstream vars(pin->GetOrAddString(s.block, "variables", "prims"));
+        std::string var;
+        while (std::getline(vars, var, ',')) {
+            var.erase(0, var.find_first_not_of(" "));
+            var.erase(var.find_last_not_of(" ") + 1);
+            if (!var.empty()) s.variables.push_back(var);
+        }
+        s.single_precision = pin->GetOrAddBoolean(s.block, "single_precision_output", true);
+
+        s.region = pin->GetOrAddString(s.block, "region", "spherical");
+        std::vector<std::string> limits;
+        if (s.region == "spherical") {
+            limits = {"r", "th", "phi"};
+        } else if (s.region == "cartesian") {
+            limits = {"x", "y", "z"};
+        } else if (s.region == "native") {
+            limits = {"X1", "X2", "X3"};
+        } else {
+            throw std::invalid_argument("Unknown region type "+s.region+" for "+s.block+"!");
+        }
+        for (int d = 0; d < 3; ++d) {
+            // Native limits are named like the mesh's, e.g. X1min
+            const std::string sep = (s.region == "native") ? "" : "_";
+            s.lo[d] = pin->GetOrAddReal(s.block, limits[d] + sep + "min", -std::numeric_limits<Real>::max());
+            s.hi[d] = pin->GetOrAddReal(s.block, limits[d] + sep + "max", std::numeric_limits<Real>::max());
+        }
+
+        // Kept in the parameters, so restarts pick up where we left off
+        pin->GetOrAddReal(s.block, "next_time", s.dt);
+        pin->GetOrAddInteger(s.block, "file_number", 0);
+        streams.push_back(s);
+    }
+
+    pkg->PostStepWork = RegionOutput::PostStepWork;
+    return pkg;
+}
+
+void RegionOutput::PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
+{
+    // Parthenon advances the time only after this callback, so this is the time of the state we'd write
+    const Real time = tm.time + tm.dt;
+    for (int n = 0; n < streams.size(); ++n) {
+        const Stream &s = streams[n];
+        Real next_time = pin->GetReal(s.block, "next_time");
+        if (time < next_time) continue;
+
+        Flag("RegionOutput");
+        Write(pmesh, pin, n, time, tm.ncycle + 1, tm.dt);
+        // Skip any output times we stepped over, as Parthenon does
+        while (next_time <= time) next_time += s.dt;
+        pin->SetReal(s.block, "next_time", next_time);
+        pin->SetInteger(s.block, "file_number", pin->GetInteger(s.block, "file_number") + 1);
+        EndFlag();
+    }
+}
+
+void RegionOutput::Write(Mesh *pmesh, ParameterInput *pin, int stream, Real time, int ncycle, Real dt)
+{
+    const Stream &s = streams[stream];
+    if (pmesh->multilevel)
+        throw std::runtime_error("Region outputs are only supported on uniform meshes!");
+
+    // Pick out our blocks in the region, and make sure any output-only fields are current
+    std::vector<MeshBlock*> selected;
+    for (auto &pmb : pmesh->block_list) {
+        if (BlockInRegion(pmb.get(), s)) {
+            Packages::UserWorkBeforeOutput(pmb.get(), pin);
+            selected.push_back(pmb.get());
+        }
+    }
+
+    // Our place in the global list of selected blocks
+    const int my_nb = selected.size();
+    std::vector<int> counts(MPINumRanks(), my_nb);
+#if ENABLE_MPI
+    MPI_Allgather(&my_nb, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+#endif
+    int offset = 0, nb_total = 0;
+    for (int r = 0; r < counts.size(); ++r) {
+        if (r < MPIRank()) offset += counts[r];
+        nb_total += counts[r];
+    }
+    if (nb_total == 0) {
+        if (MPIRank0()) std::cerr << "WARNING: No blocks in region of " << s.block << ", not writing!" << std::endl;
+        return;
+    }
+
+    // Fields to write: take names & sizes from our first block, as every block has the same fields
+    auto rc0 = pmesh->block_list[0]->meshblock_data.Get();
+    std::vector<std::string> names;
+    std::vector<int> ncomps;
+    std::vector<std::string> comp_names;
+    for (auto &var : rc0->GetVariableVector()) {
+        if (!var->IsSet(Metadata::Cell) || !VariableSelected(var->label(), s.variables)) continue;
+        names.push_back(var->label());
+        ncomps.push_back(rc0->PackVariables(std::vector<std::string>{var->label()}).GetDim(4));
+        for (int v = 0; v < ncomps.back(); ++v)
+            comp_names.push_back((ncomps.back() > 1) ? var->label() + "_" + std::to_string(v) : var->label());
+    }
+
+    std::ostringstream fname;
+    fname << s.prefix << "." << std::setw(5) << std::setfill('0') << pin->GetInteger(s.block, "file_number") << ".phdf";
+
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+#if ENABLE_MPI
+    H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
+#endif
+    hid_t file = H5Fcreate(fname.str().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    H5Pclose(fapl);
+    if (file < 0) throw std::runtime_error("Could not create region output file " + fname.str());
+
+    // Metadata, following Parthenon's .phdf layout
+    const int nx1 = pmesh->block_list[0]->block_size.nx(X1DIR);
+    const int nx2 = pmesh->block_list[0]->block_size.nx(X2DIR);
+    const int nx3 = pmesh->block_list[0]->block_size.nx(X3DIR);
+    {
+        hid_t info = H5Gcreate2(file, "/Info", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        WriteAttribute(info, "OutputFormatVersion", std::vector<int>{3});
+        WriteAttribute(info, "NCycle", std::vector<int>{ncycle});
+        WriteAttribute(info, "Time", std::vector<double>{time});
+        WriteAttribute(info, "dt", std::vector<double>{dt});
+        WriteAttribute(info, "NumDims", std::vector<int>{pmesh->ndim});
+        WriteAttribute(info, "NumMeshBlocks", std::vector<int>{nb_total});
+        WriteAttribute(info, "MeshBlockSize", std::vector<int>{nx1, nx2, nx3});
+        WriteAttribute(info, "BlocksPerPE", counts);
+        std::vector<double> domain;
+        std::vector<int> root_size;
+        for (int d = 0; d < 3; ++d) {
+            const auto dir = static_cast<CoordinateDirection>(d + 1);
+            domain.insert(domain.end(), {pmesh->mesh_size.xmin(dir), pmesh->mesh_size.xmax(dir), 1.});
+            root_size.push_back(pmesh->mesh_size.nx(dir));
+        }
+        WriteAttribute(info, "RootGridDomain", domain);
+        WriteAttribute(info, "RootGridSize", root_size);
+        WriteAttribute(info, "MaxLevel", std::vector<int>{0});
+        WriteAttribute(info, "Multilevel", std::vector<int>{0});
+        WriteAttribute(info, "Refine", std::vector<int>{0});
+        WriteAttribute(info, "IncludesGhost", std::vector<int>{0});
+        WriteAttribute(info, "NGhost", std::vector<int>{Globals::nghost});
+        WriteAttribute(info, "Coordinates", std::vector<std::string>{pmesh->block_list[0]->coords.Name()}, true);
+        WriteAttribute(info, "OutputDatasetNames", names);
+        WriteAttribute(info, "NumComponents", ncomps);
+        WriteAttribute(info, "ComponentNames", comp_names);
+        std::vector<std::string> bcs;
+        for (const std::string bc : {"ix1_bc", "ox1_bc", "ix2_bc", "ox2_bc", "ix3_bc", "ox3_bc"})
+            bcs.push_back(pin->GetOrAddString("parthenon/mesh", bc, "user"));
+        WriteAttribute(info, "BoundaryConditions", bcs);
+        H5Gclose(info);
+
+        // The whole parameter file, for readers that need the geometry
+        hid_t input = H5Gcreate2(file, "/Input", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        std::ostringstream dump;
+        pin->ParameterDump(dump);
+        WriteAttribute(input, "File", std::vector<std::string>{dump.str()}, true);
+        H5Gclose(input);
+        H5Gclose(H5Gcreate2(file, "/Params", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        H5Gclose(H5Gcreate2(file, "/Blocks", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        H5Gclose(H5Gcreate2(file, "/Locations", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        H5Gclose(H5Gcreate2(file, "/VolumeLocations", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    }
+
+    // Block locations & coordinates
+    {
+        std::vector<int64_t> lx;
+        std::vector<int> levels, loc_info;
+        std::vector<Real> xf[3], xc[3];
+        const int nx[3] = {nx1, nx2, nx3};
+        for (auto *pmb : selected) {
+            for (int d = 0; d < 3; ++d) {
+                const auto dir = static_cast<CoordinateDirection>(d + 1);
+                const Real dx = (pmesh->mesh_size.xmax(dir) - pmesh->mesh_size.xmin(dir)) / pmesh->mesh_size.nx(dir);
+                lx.push_back(std::lround((pmb->block_size.xmin(dir) - pmesh->mesh_size.xmin(dir)) / dx) / nx[d]);
+                for (int i = 0; i <= nx[d]; ++i)
+                    xf[d].push_back(pmb->block_size.xmin(dir) + i * dx);
+                for (int i = 0; i < nx[d]; ++i)
+                    xc[d].push_back(pmb->block_size.xmin(dir) + (i + 0.5) * dx);
+            }
+            levels.push_back(0);
+            loc_info.insert(loc_info.end(), {0, pmb->gid, pmb->lid, Globals::nghost, 0});
+        }
+        WriteBlocks(file, "/Blocks/loc.lx123", {3}, nb_total, offset, my_nb, lx);
+        WriteBlocks(file, "/Blocks/loc.level-gid-lid-cnghost-gflag", {5}, nb_total, offset, my_nb, loc_info);
+        WriteBlocks(file, "/LogicalLocations", {3}, nb_total, offset, my_nb, lx);
+        WriteBlocks(file, "/Levels", {}, nb_total, offset, my_nb, levels);
+        const char *dirs[3] = {"x", "y", "z"};
+        for (int d = 0; d < 3; ++d) {
+            WriteBlocks(file, std::string("/Locations/") + dirs[d], {(hsize_t) nx[d] + 1}, nb_total, offset, my_nb, xf[d]);
+            WriteBlocks(file, std::string("/VolumeLocations/") + dirs[d], {(hsize_t) nx[d]}, nb_total, offset, my_nb, xc[d]);
+        }
+    }
+
+    // Fields, one dataset each, shaped like Parthenon's: [block, (component,) k, j, i]
+    for (int v = 0; v < names.size(); ++v) {
+        std::vector<hsize_t> dims;
+        if (ncomps[v] > 1) dims.push_back(ncomps[v]);
+        dims.insert(dims.end(), {(hsize_t) nx3, (hsize_t) nx2, (hsize_t) nx1});
+        if (s.single_precision) {
+            std::vector<float> data;
+            for (auto *pmb : selected) AppendInterior(pmb, names[v], data);
+            WriteBlocks(file, "/" + names[v], dims, nb_total, offset, my_nb, data);
+        } else {
+            std::vector<double> data;
+            for (auto *pmb : selected) AppendInterior(pmb, names[v], data);
+            WriteBlocks(file, "/" + names[v], dims, nb_total, offset, my_nb, data);
+        }
+    }
+
+    H5Fclose(file);
+    if (MPIRank0() && pmesh->packages.Get("Globals")->Param<int>("verbose") > 0)
+        std::cout << "Wrote " << nb_total << " blocks to " << fname.str() << std::endl;
+}
@@ -0,0 +1,76 @@
+/*
+ *  File: region_output.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * Region-restricted dumps: full-resolution outputs of only the meshblocks covering some region of interest,
+ * e.g. the inner few tens of r_g around the hole, or a box around a jet, at a higher cadence than
+ * the full .phdf dumps.
+ *
+ * Each stream is one input block <region_output0>, <region_output1>, ... (numbered up from 0, stopping at the
+ * first missing block), with its own cadence 'dt', 'variables' (default "prims", which also matches
+ * e.g. "prims.rho"), 'file_prefix' (default "<problem_id>.region<N>") and 'single_precision_output'.
+ * The region is 'region' = one of:
+ * spherical: r_min/r_max, th_min/th_max, phi_min/phi_max in the embedding (KS/BL) coordinates
+ * cartesian: x_min/x_max, y_min/y_max, z_min/z_max in the embedding coordinates
+ * native: X1min/X1max, X2min/X2max, X3min/X3max in the grid coordinates
+ * Unset limits default to the whole domain.  A block is written whole if any part of it lies in the region:
+ * for native regions this is exact, otherwise it is decided by testing a small lattice of points over each block.
+ *
+ * Files are written as "<file_prefix>.<NNNNN>.phdf", with the same layout as Parthenon's own .phdf files,
+ * except that the block list is the selected blocks only.  So, they read as partial meshes with the
+ * usual tools, including the full parameter file for geometry.  Only uniform (un-refined) meshes are supported,
+ * and only cell-centered fields are written.
+ */
+namespace RegionOutput {
+
+/**
+ * Read the region_outputN blocks.  Only loaded if <region_output0> exists
+ */
+std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
+
+/**
+ * Write any streams which are due, as of the end of the step just taken
+ */
+void PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm);
+
+/**
+ * Write one stream's file now, at 'time'.  Collective
+ */
+void Write(Mesh *pmesh, ParameterInput *pin, int stream, Real time, int ncycle, Real dt);
+
+}
@@ -0,0 +1,231 @@
+/*
+ *  File: roofline.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "roofline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#if USE_PAPI
+#include <papi.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct KernelRecord {
+    long long calls = 0;
+    double time = 0.;
+    // Modeled totals, from AddWork
+    double bytes = 0.;
+    double flops = 0.;
+    // Measured, if we have PAPI
+    long long hw_flops = 0;
+};
+
+struct Launch {
+    std::string name;
+    Clock::time_point start;
+    long long hw_start;
+};
+
+bool enabled = false;
+double peak_bw = 0., peak_gflops = 0.;
+int max_kernels = 30;
+
+std::mutex records_mutex;
+std::map<std::string, KernelRecord> records;
+std::map<uint64_t, Launch> in_flight;
+uint64_t next_kernel_id = 0;
+
+#if USE_PAPI
+int papi_eventset = PAPI_NULL;
+bool papi_running = false;
+#endif
+
+long long ReadHWFlops()
+{
+#if USE_PAPI
+    long long val = 0;
+    if (papi_running) PAPI_read(papi_eventset, &val);
+    return val;
+#else
+    return 0;
+#endif
+}
+
+void BeginKernel(const char* name, const uint32_t devid, uint64_t* kernel_id)
+{
+    std::lock_guard<std::mutex> lock(records_mutex);
+    *kernel_id = next_kernel_id++;
+    in_flight[*kernel_id] = Launch{std::string(name), Clock::now(), ReadHWFlops()};
+}
+
+void EndKernel(const uint64_t kernel_id)
+{
+    // Launches are asynchronous: wait for the kernel to actually finish
+    Kokkos::fence();
+    const auto end = Clock::now();
+    const long long hw_end = ReadHWFlops();
+
+    std::lock_guard<std::mutex> lock(records_mutex);
+    auto launch = in_flight.find(kernel_id);
+    if (launch == in_flight.end()) return;
+    auto& record = records[launch->second.name];
+    record.calls++;
+    record.time += std::chrono::duration<double>(end - launch->second.start).count();
+    record.hw_flops += hw_end - launch->second.hw_start;
+    in_flight.erase(launch);
+}
+
+} // namespace
+
+bool Roofline::Enabled() { return enabled; }
+
+void Roofline::Initialize(ParameterInput *pin)
+{
+    enabled = pin->GetOrAddBoolean("debug", "roofline", false);
+    if (!enabled) return;
+    // Machine balance, for guessing which side of the roofline each kernel is on.
+    // Per-rank numbers, i.e., per-GPU or per-socket when running a rank per socket
+    peak_bw = pin->GetOrAddReal("debug", "roofline_peak_bw", 0.);
+    peak_gflops = pin->GetOrAddReal("debug", "roofline_peak_gflops", 0.);
+    max_kernels = pin->GetOrAddInteger("debug", "roofline_max_kernels", 30);
+
+    using namespace Kokkos::Tools::Experimental;
+    set_begin_parallel_for_callback(BeginKernel);
+    set_end_parallel_for_callback(EndKernel);
+    set_begin_parallel_reduce_callback(BeginKernel);
+    set_end_parallel_reduce_callback(EndKernel);
+    set_begin_parallel_scan_callback(BeginKernel);
+    set_end_parallel_scan_callback(EndKernel);
+
+#if USE_PAPI
+    // Count FP operations on the host.  Only meaningful for CPU builds
+    if (PAPI_library_init(PAPI_VER_CURRENT) == PAPI_VER_CURRENT &&
+        PAPI_create_eventset(&papi_eventset) == PAPI_OK &&
+        (PAPI_add_event(papi_eventset, PAPI_DP_OPS) == PAPI_OK ||
+         PAPI_add_event(papi_eventset, PAPI_FP_OPS) == PAPI_OK) &&
+        PAPI_start(papi_eventset) == PAPI_OK) {
+        papi_running = true;
+    } else if (MPIRank0()) {
+        std::cerr << "WARNING: Could not start PAPI FP counters, reporting modeled FLOPs only" << std::endl;
+    }
+#endif
+}
+
+void Roofline::AddWorkImpl(const std::string& kernel, double n, double bytes_per, double flops_per)
+{
+    std::lock_guard<std::mutex> lock(records_mutex);
+    auto& record = records[kernel];
+    record.bytes += n * bytes_per;
+    record.flops += n * flops_per;
+}
+
+void Roofline::Print()
+{
+    if (!enabled) return;
+    Kokkos::fence();
+
+    if (MPIRank0()) {
+        std::lock_guard<std::mutex> lock(records_mutex);
+        std::vector<std::pair<std::string, KernelRecord>> sorted(records.begin(), records.end());
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const auto& a, const auto& b) { return a.second.time > b.second.time; });
+
+        // Machine balance in FLOP/byte: kernels with lower intensity are bandwidth-bound
+        const double ridge = (peak_bw > 0. && peak_gflops > 0.) ? peak_gflops / peak_bw : -1.;
+
+        std::cout << std::endl << "Kernel roofline (rank 0, modeled bytes & FLOPs";
+#if USE_PAPI
+        if (papi_running) std::cout << ", measured HW FLOPs";
+#endif
+        std::cout << "):" << std::endl;
+        std::cout << std::left << std::setw(32) << "kernel" << std::right
+                  << std::setw(9) << "calls" << std::setw(11) << "time(s)"
+                  << std::setw(10) << "GB/s" << std::setw(10) << "GFLOP/s"
+                  << std::setw(9) << "FLOP/B";
+#if USE_PAPI
+        if (papi_running) std::cout << std::setw(12) << "HW GFLOP/s";
+#endif
+        if (ridge > 0) std::cout << std::setw(10) << "%roof" << "  bound";
+        std::cout << std::endl;
+
+        int nprinted = 0;
+        for (auto &kernel : sorted) {
+            if (nprinted++ >= max_kernels) break;
+            const auto& r = kernel.second;
+            std::cout << std::left << std::setw(32) << kernel.first.substr(0, 31) << std::right
+                      << std::setw(9) << r.calls
+                      << std::fixed << std::setprecision(4) << std::setw(11) << r.time
+                      << std::setprecision(1);
+            if (r.bytes > 0. && r.time > 0.) {
+                const double gbs = r.bytes / r.time / 1e9;
+                const double gflops = r.flops / r.time / 1e9;
+                const double intensity = r.flops / r.bytes;
+                std::cout << std::setw(10) << gbs << std::setw(10) << gflops
+                          << std::setprecision(2) << std::setw(9) << intensity;
+#if USE_PAPI
+                if (papi_running) std::cout << std::setprecision(1) << std::setw(12) << r.hw_flops / r.time / 1e9;
+#endif
+                if (ridge > 0) {
+                    // Fraction of the attainable FLOP rate at this intensity
+                    const double roof = m::min(peak_gflops, intensity * peak_bw);
+                    std::cout << std::setprecision(1) << std::setw(10) << 100. * gflops / roof
+                              << "  " << ((intensity < ridge) ? "memory" : "compute");
+                }
+            } else {
+                std::cout << std::setw(10) << "-" << std::setw(10) << "-" << std::setw(9) << "-";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+#if USE_PAPI
+    if (papi_running) {
+        long long val;
+        PAPI_stop(papi_eventset, &val);
+        papi_running = false;
+    }
+#endif
+}
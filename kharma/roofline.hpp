@@ -0,0 +1,86 @@
+/*
+ *  File: roofline.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+
+#include <string>
+
+/**
+ * Per-kernel roofline instrumentation, enabled with debug/roofline=true.
+ *
+ * Every Kokkos kernel is timed by name through Kokkos Tools callbacks, fencing after each
+ * launch so the times are real (this makes the run slower -- don't leave it on!).
+ * Separately, the host code launching KHARMA's hot kernels calls AddWork with an estimate of the
+ * bytes moved and floating-point operations done, based on pack sizes & the loop range.
+ * At exit, Print() joins these into a table of achieved bandwidth, FLOP rate & arithmetic intensity
+ * for each kernel, and compares against the machine balance given by debug/roofline_peak_bw
+ * and debug/roofline_peak_gflops to guess which kernels are memory- vs compute-bound.
+ *
+ * When compiled with PAPI (KHARMA_PAPI=ON), measured FP operation counts are added alongside.
+ *
+ * Since this registers callbacks in-process, it can't be used alongside an external
+ * Kokkos tool loaded with KOKKOS_TOOLS_LIBS.
+ */
+namespace Roofline {
+
+/**
+ * Read options and register Kokkos Tools callbacks, if enabled.
+ * Call after Kokkos is initialized, just before the kernels of interest
+ */
+void Initialize(ParameterInput *pin);
+
+/**
+ * Whether instrumentation is on.  Check this before computing anything for AddWork
+ */
+bool Enabled();
+
+/**
+ * Record modeled work for one launch of a kernel named 'kernel':
+ * 'n' loop iterations (usually zones, or zones*variables), moving 'bytes_per' bytes and
+ * performing 'flops_per' floating-point operations each
+ */
+void AddWorkImpl(const std::string& kernel, double n, double bytes_per, double flops_per);
+inline void AddWork(const std::string& kernel, double n, double bytes_per, double flops_per)
+{
+    if (Enabled()) AddWorkImpl(kernel, n, bytes_per, flops_per);
+}
+
+/**
+ * Print the table of all kernels which ran, sorted by total time, on rank 0.
+ * Must be called before Kokkos is finalized
+ */
+void Print();
+
+}
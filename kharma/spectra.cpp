@@ -0,0 +1,257 @@
+/*
+ *  File: spectra.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "spectra.hpp"
+
+#include "domain.hpp"
+#include "kharma.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+int NumComponents(MeshBlock *pmb, const std::string& quantity)
+{
+    const std::string name = (quantity == "kinetic") ? "prims.uvec" : ((quantity == "magnetic") ? "prims.B" : quantity);
+    return pmb->meshblock_data.Get()->PackVariables(std::vector<std::string>{name}).GetDim(4);
+}
+
+/**
+ * Fill 'f' with component 'v' of 'quantity' over a block's interior
+ */
+void FillComponent(MeshBlock *pmb, const std::string& quantity, const int v, ParArray3D<Real> f)
+{
+    auto rc = pmb->meshblock_data.Get();
+    const IndexRange3 b = KDomain::GetRange(rc, IndexDomain::interior);
+    if (quantity == "kinetic") {
+        GridScalar rho = rc->Get("prims.rho").data;
+        GridVector uvec = rc->Get("prims.uvec").data;
+        pmb->par_for("spectra_fill_kinetic", b.ks, b.ke, b.js, b.je, b.is, b.ie,
+            KOKKOS_LAMBDA (const int& k, const int& j, const int& i) {
+                f(k - b.ks, j - b.js, i - b.is) = m::sqrt(rho(k, j, i)) * uvec(v, k, j, i);
+            }
+        );
+    } else {
+        auto q = rc->PackVariables(std::vector<std::string>{(quantity == "magnetic") ? "prims.B" : quantity});
+        pmb->par_for("spectra_fill", b.ks, b.ke, b.js, b.je, b.is, b.ie,
+            KOKKOS_LAMBDA (const int& k, const int& j, const int& i) {
+                f(k - b.ks, j - b.js, i - b.is) = q(v, k, j, i);
+            }
+        );
+    }
+}
+
+} // namespace
+
+std::shared_ptr<KHARMAPackage> Spectra::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
+{
+    auto pkg = std::make_shared<KHARMAPackage>("Spectra");
+    Params &params = pkg->AllParams();
+
+    const Real dt = pin->GetReal("spectra", "dt");
+    if (dt <= 0.) throw std::invalid_argument("spectra/dt must be > 0!");
+    params.Add("dt", dt);
+    const int k_max = pin->GetOrAddInteger("spectra", "k_max", 32);
+    if (k_max < 1) throw std::invalid_argument("spectra/k_max must be at least 1!");
+    params.Add("k_max", k_max);
+    const std::string fname = pin->GetOrAddString("spectra", "file",
+                                                  pin->GetString("parthenon/job", "problem_id") + ".spectra.txt");
+    params.Add("file", fname);
+
+    std::vector<std::string> quantities;
+    std::stringstream list(pin->GetOrAddString("spectra", "quantities", "kinetic,magnetic"));
+    std::string quantity;
+    while (std::getline(list, quantity, ',')) {
+        quantity.erase(0, quantity.find_first_not_of(" "));
+        quantity.erase(quantity.find_last_not_of(" ") + 1);
+        if (!quantity.empty()) quantities.push_back(quantity);
+    }
+    params.Add("quantities", quantities);
+
+    // Start a new file only for new runs: restarts (or re-blocks) carry the next time with them
+    if (!pin->DoesParameterExist("spectra", "next_time") && MPIRank0()) {
+        std::ofstream out(fname);
+        out << "# time quantity P(|k|=0) ... P(|k|=" << k_max << "), |k| in units of 2pi/L" << std::endl;
+    }
+    pin->GetOrAddReal("spectra", "next_time", dt);
+
+    pkg->PostStepWork = Spectra::PostStepWork;
+    return pkg;
+}
+
+std::vector<Real> Spectra::PowerSpectrum(Mesh *pmesh, const std::string& quantity, int k_max)
+{
+    Flag("PowerSpectrum");
+    auto pmb0 = pmesh->block_list[0];
+    if (pmesh->multilevel || !pmb0->coords.coords.is_cart_minkowski())
+        throw std::runtime_error("Power spectra require a uniform Cartesian Minkowski mesh!");
+    const int ncomp = NumComponents(pmb0.get(), quantity);
+    if (ncomp == 0) throw std::invalid_argument("Cannot take power spectrum of "+quantity+": no such field!");
+
+    // Modes kept along each direction.  Those with k1 < 0 are conjugates of k1 > 0, for real data
+    int N[3], K[3];
+    for (int d = 0; d < 3; ++d) {
+        N[d] = pmesh->mesh_size.nx(static_cast<CoordinateDirection>(d + 1));
+        K[d] = m::min(k_max, (N[d] - 1) / 2);
+    }
+    const int nk1 = K[0] + 1, nk2 = 2 * K[1] + 1, nk3 = 2 * K[2] + 1;
+    const int N1 = N[0], N2 = N[1], N3 = N[2], K2 = K[1], K3 = K[2];
+    const size_t nmodes = (size_t) nk3 * nk2 * nk1;
+
+    // Every block is the same size on a uniform mesh
+    const int n1 = pmb0->block_size.nx(X1DIR), n2 = pmb0->block_size.nx(X2DIR), n3 = pmb0->block_size.nx(X3DIR);
+    ParArray3D<Real> f("spectra_f", n3, n2, n1);
+    ParArray3D<Real> a1_re("spectra_a1_re", n3, n2, nk1), a1_im("spectra_a1_im", n3, n2, nk1);
+    ParArray3D<Real> a2_re("spectra_a2_re", n3, nk2, nk1), a2_im("spectra_a2_im", n3, nk2, nk1);
+    // Real & imaginary parts of each component's modes, summed over our blocks
+    ParArray1D<Real> modes("spectra_modes", 2 * ncomp * nmodes);
+
+    for (auto &pmb : pmesh->block_list) {
+        int off[3];
+        for (int d = 0; d < 3; ++d) {
+            const auto dir = static_cast<CoordinateDirection>(d + 1);
+            const Real dx = (pmesh->mesh_size.xmax(dir) - pmesh->mesh_size.xmin(dir)) / N[d];
+            off[d] = std::lround((pmb->block_size.xmin(dir) - pmesh->mesh_size.xmin(dir)) / dx);
+        }
+        const int off1 = off[0], off2 = off[1], off3 = off[2];
+
+        for (int v = 0; v < ncomp; ++v) {
+            FillComponent(pmb.get(), quantity, v, f);
+            // Transform one direction at a time, reducing the index to keep phases small
+            pmb->par_for("spectra_x1", 0, n3 - 1, 0, n2 - 1, 0, nk1 - 1,
+                KOKKOS_LAMBDA (const int& k, const int& j, const int& c1) {
+                    Real re = 0., im = 0.;
+                    for (int i = 0; i < n1; ++i) {
+                        const Real phase = -2. * M_PI * ((c1 * (off1 + i)) % N1) / N1;
+                        re += f(k, j, i) * m::cos(phase);
+                        im += f(k, j, i) * m::sin(phase);
+                    }
+                    a1_re(k, j, c1) = re;
+                    a1_im(k, j, c1) = im;
+                }
+            );
+            pmb->par_for("spectra_x2", 0, n3 - 1, 0, nk2 - 1, 0, nk1 - 1,
+                KOKKOS_LAMBDA (const int& k, const int& c2, const int& c1) {
+                    Real re = 0., im = 0.;
+                    for (int j = 0; j < n2; ++j) {
+                        const Real phase = -2. * M_PI * (((c2 - K2) * (off2 + j)) % N2) / N2;
+                        const Real c = m::cos(phase), s = m::sin(phase);
+                        re += a1_re(k, j, c1) * c - a1_im(k, j, c1) * s;
+                        im += a1_re(k, j, c1) * s + a1_im(k, j, c1) * c;
+                    }
+                    a2_re(k, c2, c1) = re;
+                    a2_im(k, c2, c1) = im;
+                }
+            );
+            pmb->par_for("spectra_x3", 0, nk3 - 1, 0, nk2 - 1, 0, nk1 - 1,
+                KOKKOS_LAMBDA (const int& c3, const int& c2, const int& c1) {
+                    Real re = 0., im = 0.;
+                    for (int k = 0; k < n3; ++k) {
+                        const Real phase = -2. * M_PI * (((c3 - K3) * (off3 + k)) % N3) / N3;
+                        const Real c = m::cos(phase), s = m::sin(phase);
+                        re += a2_re(k, c2, c1) * c - a2_im(k, c2, c1) * s;
+                        im += a2_re(k, c2, c1) * s + a2_im(k, c2, c1) * c;
+                    }
+                    const size_t idx = 2 * (((size_t) v * nk3 + c3) * nk2 * nk1 + (size_t) c2 * nk1 + c1);
+                    modes(idx) += re;
+                    modes(idx + 1) += im;
+                }
+            );
+        }
+    }
+
+    auto modes_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), modes);
+    std::vector<Real> all_modes(modes_host.data(), modes_host.data() + modes_host.extent(0));
+#if ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, all_modes.data(), all_modes.size(), MPI_PARTHENON_REAL, MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+    // Sum into shells, normalized so the total is the mean square
+    std::vector<Real> power(k_max + 1, 0.);
+    const double norm = 1. / ((double) N1 * N2 * N3 * N1 * N2 * N3);
+    for (int v = 0; v < ncomp; ++v) {
+        for (int c3 = 0; c3 < nk3; ++c3) {
+            for (int c2 = 0; c2 < nk2; ++c2) {
+                for (int c1 = 0; c1 < nk1; ++c1) {
+                    const int k2 = c2 - K2, k3 = c3 - K3;
+                    const int shell = std::lround(std::sqrt((double) c1 * c1 + k2 * k2 + k3 * k3));
+                    if (shell > k_max) continue;
+                    const size_t idx = 2 * (((size_t) v * nk3 + c3) * nk2 * nk1 + (size_t) c2 * nk1 + c1);
+                    const Real weight = (c1 == 0) ? 1. : 2.;
+                    power[shell] += weight * norm * (all_modes[idx] * all_modes[idx] + all_modes[idx + 1] * all_modes[idx + 1]);
+                }
+            }
+        }
+    }
+    if (quantity == "kinetic" || quantity == "magnetic")
+        for (auto &p : power) p *= 0.5;
+
+    EndFlag();
+    return power;
+}
+
+void Spectra::PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
+{
+    const auto& pars = pmesh->packages.Get("Spectra")->AllParams();
+    // Parthenon advances the time only after this callback, so this is the time of the state we'd use
+    const Real time = tm.time + tm.dt;
+    Real next_time = pin->GetReal("spectra", "next_time");
+    if (time < next_time) return;
+
+    Flag("Spectra");
+    const int k_max = pars.Get<int>("k_max");
+    std::ofstream out;
+    if (MPIRank0()) {
+        out.open(pars.Get<std::string>("file"), std::ios::app);
+        out << std::scientific << std::setprecision(8);
+    }
+    for (const auto &quantity : pars.Get<std::vector<std::string>>("quantities")) {
+        const auto power = PowerSpectrum(pmesh, quantity, k_max);
+        if (MPIRank0()) {
+            out << time << " " << quantity;
+            for (const auto &p : power) out << " " << p;
+            out << std::endl;
+        }
+    }
+
+    const Real dt = pars.Get<Real>("dt");
+    while (next_time <= time) next_time += dt;
+    pin->SetReal("spectra", "next_time", next_time);
+    EndFlag();
+}
@@ -0,0 +1,76 @@
+/*
+ *  File: spectra.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * In-situ power spectra, for turbulence problems on uniform, periodic Cartesian meshes.
+ * Enabled by adding a <spectra> block with a cadence 'dt'.
+ *
+ * Each output computes the 3D discrete Fourier transform of each quantity in spectra/quantities over the
+ * whole mesh, and sums the power in shells of integer mode number |k| = 0 ... spectra/k_max
+ * (in units of 2pi/L along each direction).  The quantities are:
+ * kinetic: the three components of sqrt(rho) u^i, with a factor 1/2, i.e. the kinetic energy spectrum
+ * magnetic: the three components of B^i, also with 1/2
+ * Any other name is a cell-centered field, whose components' power spectra are summed (e.g. prims.rho).
+ * Power is normalized so that summing over all shells gives the mean of the squared quantity.
+ *
+ * The transform is distributed by separability: each block sums its own zones' contributions to
+ * every mode with |k_i| <= k_max, one direction at a time, and the modes are summed over ranks.
+ * Without an FFT, cost per block scales as (block zones) x k_max, so keep k_max to what you'll plot.
+ *
+ * Spectra are appended to spectra/file (default "<problem_id>.spectra.txt") by rank 0, one line per
+ * quantity: time, quantity name, then the power in each shell.
+ */
+namespace Spectra {
+
+/**
+ * Read options from the <spectra> block.  Only loaded if that block exists
+ */
+std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
+
+/**
+ * Compute & write spectra, if due as of the end of the step just taken
+ */
+void PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm);
+
+/**
+ * Shell-summed power spectrum of 'quantity' over the whole mesh, shells 0 to 'k_max'.  Collective.
+ * The result is valid on all ranks
+ */
+std::vector<Real> PowerSpectrum(Mesh *pmesh, const std::string& quantity, int k_max);
+
+}
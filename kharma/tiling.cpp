@@ -0,0 +1,71 @@
+/*
+ *  File: tiling.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "tiling.hpp"
+
+#include <iostream>
+
+namespace {
+int tile_k = 0, tile_j = 0;
+// Rows of doubles touched per zone row, roughly: 8 variables' fluxes in 3 directions, plus outputs
+constexpr int rows_per_j = 32;
+}
+
+int Tiling::TileK() { return tile_k; }
+int Tiling::TileJ() { return tile_j; }
+
+void Tiling::Initialize(ParameterInput *pin)
+{
+    if (!pin->GetOrAddBoolean("tiling", "on", false)) return;
+    if (!host_exec) {
+        if (MPIRank0()) std::cerr << "WARNING: tiling/on ignored for GPU builds" << std::endl;
+        return;
+    }
+    const int n1 = pin->GetInteger("parthenon/meshblock", "nx1") + 2*Globals::nghost;
+    const int n2 = pin->GetInteger("parthenon/meshblock", "nx2");
+    // Per-core L2 on most current server CPUs
+    const int cache_kb = pin->GetOrAddInteger("tiling", "cache_kb", 1024);
+    tile_k = m::max(pin->GetOrAddInteger("tiling", "tile_k", 1), 1);
+    tile_j = pin->GetOrAddInteger("tiling", "tile_j", 0);
+    if (tile_j <= 0) {
+        // Fit the tile plus its k+1 neighbors in cache
+        const long long bytes_per_j = 8ll * n1 * rows_per_j * (tile_k + 1);
+        tile_j = m::max(static_cast<int>(cache_kb * 1024ll / bytes_per_j), 1);
+    }
+    tile_j = m::min(tile_j, n2 + 2*Globals::nghost);
+
+    if (MPIRank0() && pin->GetOrAddInteger("debug", "verbose", 0) > 0) {
+        std::cout << "Tiling kernels in " << tile_k << "x" << tile_j << " (k x j) tiles" << std::endl;
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ *  File: tiling.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+
+#include <string>
+
+#include <kokkos_abstraction.hpp>
+
+/**
+ * Cache-blocked execution of zone-wise kernels on CPU, enabled with tiling/on=true.
+ *
+ * Parthenon's par_for sweeps a whole MeshData pack in b-k-j-i order, handing each thread a run of
+ * whole rows.  For stencil kernels over big blocks (128^3, several variables), the rows at j+1 or k+1
+ * have left cache by the time they're needed again.  Tiling::par_for instead runs over tiles of
+ * tiling/tile_k x tiling/tile_j rows, each swept by one thread, so that neighbors are still in L2.
+ * By default tile_j is chosen so a tile's working set fits in tiling/cache_kb.
+ *
+ * Arguments match parthenon::par_for without the loop pattern: pass the block's exec_space as
+ * pmb->par_for would.  On GPUs, or with tiling off, these are just the untiled loop.
+ */
+namespace Tiling {
+
+/**
+ * Read options & choose the tile shape.  Call once the meshblock size is known
+ */
+void Initialize(ParameterInput *pin);
+
+/**
+ * Tile extent in k and j, or 0 if tiling is off
+ */
+int TileK();
+int TileJ();
+
+// Host backends run MDRange tiles one per thread, in order.  This is what we want
+constexpr bool host_exec = Kokkos::SpaceAccessibility<DevExecSpace, Kokkos::HostSpace>::accessible;
+
+template<typename Function>
+inline void par_for(const std::string& name, const DevExecSpace& exec_space, const int ks, const int ke,
+                    const int js, const int je, const int is, const int ie, const Function& function)
+{
+    if constexpr (host_exec) {
+        if (TileK() > 0) {
+            using Policy = Kokkos::MDRangePolicy<DevExecSpace, Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>;
+            Kokkos::parallel_for(name, Policy(exec_space, {ks, js, is}, {ke + 1, je + 1, ie + 1},
+                                              {TileK(), TileJ(), ie + 1 - is}), function);
+            return;
+        }
+    }
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, name, exec_space, ks, ke, js, je, is, ie, function);
+}
+
+template<typename Function>
+inline void par_for(const std::string& name, const DevExecSpace& exec_space, const int bs, const int be,
+                    const int ks, const int ke, const int js, const int je, const int is, const int ie,
+                    const Function& function)
+{
+    if constexpr (host_exec) {
+        if (TileK() > 0) {
+            using Policy = Kokkos::MDRangePolicy<DevExecSpace, Kokkos::Rank<4, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>;
+            Kokkos::parallel_for(name, Policy(exec_space, {bs, ks, js, is}, {be + 1, ke + 1, je + 1, ie + 1},
+                                              {1, TileK(), TileJ(), ie + 1 - is}), function);
+            return;
+        }
+    }
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, name, exec_space, bs, be, ks, ke, js, je, is, ie, function);
+}
+
+template<typename Function>
+inline void par_for(const std::string& name, const DevExecSpace& exec_space, const int bs, const int be,
+                    const int ls, const int le, const int ks, const int ke, const int js, const int je,
+                    const int is, const int ie, const Function& function)
+{
+    if constexpr (host_exec) {
+        if (TileK() > 0) {
+            using Policy = Kokkos::MDRangePolicy<DevExecSpace, Kokkos::Rank<5, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>;
+            Kokkos::parallel_for(name, Policy(exec_space, {bs, ls, ks, js, is}, {be + 1, le + 1, ke + 1, je + 1, ie + 1},
+                                              {1, 1, TileK(), TileJ(), ie + 1 - is}), function);
+            return;
+        }
+    }
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, name, exec_space, bs, be, ls, le, ks, ke, js, je, is, ie, function);
+}
+
+}
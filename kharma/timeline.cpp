@@ -0,0 +1,246 @@
+/*
+ *  File: timeline.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timeline.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A completed region.  Recording complete ("X") events at the end of each region
+// means a wrapped ring buffer never holds an unmatched begin or end
+struct Event {
+    int name;
+    double start; // microseconds since Initialize
+    double duration;
+};
+
+struct OpenRegion {
+    int name;
+    double start;
+    bool record;
+};
+
+struct ThreadBuffer {
+    int tid;
+    std::vector<Event> events;
+    size_t next = 0;
+    bool wrapped = false;
+    // Names are interned per-thread, so recording never takes a lock
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> name_ids;
+    std::vector<OpenRegion> open;
+};
+
+bool enabled = false;
+int start_step = 0, end_step = 0;
+size_t buffer_size = 0;
+std::string fname;
+std::atomic<bool> active(false);
+Clock::time_point t0;
+
+std::atomic<int> next_tid(0);
+std::mutex buffers_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer *my_buffer = nullptr;
+
+ThreadBuffer *GetBuffer()
+{
+    if (my_buffer == nullptr) {
+        auto buf = std::make_shared<ThreadBuffer>();
+        buf->tid = next_tid++;
+        buf->events.resize(buffer_size);
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffers.push_back(buf);
+        my_buffer = buf.get();
+    }
+    return my_buffer;
+}
+
+double Now()
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+}
+
+void PushRegion(const char* name)
+{
+    ThreadBuffer *buf = GetBuffer();
+    // Always keep the stack, so regions opened before/after the recorded steps still pair correctly
+    int id = -1;
+    const bool record = active;
+    if (record) {
+        auto found = buf->name_ids.find(name);
+        if (found == buf->name_ids.end()) {
+            id = buf->names.size();
+            buf->names.emplace_back(name);
+            buf->name_ids[buf->names.back()] = id;
+        } else {
+            id = found->second;
+        }
+    }
+    buf->open.push_back(OpenRegion{id, Now(), record});
+}
+
+void PopRegion()
+{
+    ThreadBuffer *buf = GetBuffer();
+    if (buf->open.empty()) return;
+    const OpenRegion region = buf->open.back();
+    buf->open.pop_back();
+    if (!region.record) return;
+    buf->events[buf->next] = Event{region.name, region.start, Now() - region.start};
+    buf->next++;
+    if (buf->next == buf->events.size()) {
+        buf->next = 0;
+        buf->wrapped = true;
+    }
+}
+
+std::string EscapeJSON(const std::string& in)
+{
+    std::string out;
+    for (char c : in) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (c >= 0 && c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+void Timeline::Initialize(ParameterInput *pin)
+{
+    enabled = pin->GetOrAddBoolean("debug", "timeline", false);
+    if (!enabled) return;
+    start_step = pin->GetOrAddInteger("debug", "timeline_start_step", 0);
+    end_step = pin->GetOrAddInteger("debug", "timeline_end_step", 10);
+    // Events per thread before we start overwriting the oldest
+    buffer_size = m::max(pin->GetOrAddInteger("debug", "timeline_buffer_events", 1 << 20), 1);
+    fname = pin->GetOrAddString("debug", "timeline_file", "timeline.json");
+#if TRACE
+    if (MPIRank0()) std::cerr << "WARNING: debug/timeline records nothing in TRACE builds" << std::endl;
+#endif
+
+    // Line up the ranks' clocks, roughly
+    MPIBarrier();
+    t0 = Clock::now();
+
+    Kokkos::Tools::Experimental::set_push_region_callback(PushRegion);
+    Kokkos::Tools::Experimental::set_pop_region_callback(PopRegion);
+}
+
+void Timeline::SetStep(int step)
+{
+    if (enabled) active = (step >= start_step && step <= end_step);
+}
+
+void Timeline::Write()
+{
+    if (!enabled) return;
+    active = false;
+
+    // Each rank formats its own events.  Records are separated by a leading comma, except the very first
+    // on rank 0, so that every rank's text can simply be appended to the file in turn
+    std::ostringstream ss;
+    ss.precision(3);
+    ss << std::fixed;
+    const int rank = MPIRank();
+    ss << ((MPIRank0()) ? "" : ",\n")
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+       << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        for (auto &buf : buffers) {
+            const size_t nevents = (buf->wrapped) ? buf->events.size() : buf->next;
+            const size_t first = (buf->wrapped) ? buf->next : 0;
+            for (size_t n = 0; n < nevents; ++n) {
+                const Event &ev = buf->events[(first + n) % buf->events.size()];
+                ss << ",\n{\"name\":\"" << EscapeJSON(buf->names[ev.name]) << "\",\"ph\":\"X\",\"ts\":" << ev.start
+                   << ",\"dur\":" << ev.duration << ",\"pid\":" << rank << ",\"tid\":" << buf->tid << "}";
+            }
+        }
+    }
+    const std::string mine = ss.str();
+
+    std::ofstream out;
+    if (MPIRank0()) {
+        out.open(fname);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << mine;
+    }
+#if ENABLE_MPI
+    // Stream each rank's events to rank 0 in turn, in chunks small enough for MPI's int counts.
+    // A single gather would overflow its int counts & displacements (and rank 0's memory) past 2GB of events
+    constexpr size_t chunk = 1 << 28;
+    std::vector<char> recv_buf;
+    for (int r = 1; r < MPINumRanks(); ++r) {
+        if (MPIRank0()) {
+            uint64_t len;
+            MPI_Recv(&len, 1, MPI_UINT64_T, r, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            recv_buf.resize(m::min((size_t) len, chunk));
+            for (uint64_t sent = 0; sent < len; sent += chunk) {
+                const int n = m::min(len - sent, (uint64_t) chunk);
+                MPI_Recv(recv_buf.data(), n, MPI_CHAR, r, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                out.write(recv_buf.data(), n);
+            }
+        } else if (rank == r) {
+            const uint64_t len = mine.size();
+            MPI_Send(&len, 1, MPI_UINT64_T, 0, 0, MPI_COMM_WORLD);
+            for (uint64_t sent = 0; sent < len; sent += chunk) {
+                const int n = m::min(len - sent, (uint64_t) chunk);
+                MPI_Send(mine.data() + sent, n, MPI_CHAR, 0, 1, MPI_COMM_WORLD);
+            }
+        }
+    }
+#endif
+
+    if (MPIRank0()) {
+        out << "\n]}" << std::endl;
+        std::cout << "Wrote timeline of steps " << start_step << "-" << end_step << " to " << fname << std::endl;
+    }
+}
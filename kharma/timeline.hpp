@@ -0,0 +1,71 @@
+/*
+ *  File: timeline.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+
+/**
+ * Timeline tracing, enabled with debug/timeline=true.
+ *
+ * Records the begin & end of every profiling region -- that is, every Flag()/EndFlag() pair in KHARMA,
+ * plus Parthenon's own task regions, including boundary communication -- on every rank and host thread.
+ * Events go into a fixed-size ring buffer per thread, so tracing long runs keeps only the latest events.
+ * Only steps debug/timeline_start_step through debug/timeline_end_step are recorded.
+ *
+ * At exit, all ranks' events are sent to rank 0 one rank at a time and written as a single Chrome trace JSON file
+ * (debug/timeline_file, default "timeline.json"), with one process per rank.  Open it with
+ * https://ui.perfetto.dev or chrome://tracing.
+ *
+ * This hooks Kokkos' region callbacks, so it sees nothing in TRACE builds (where Flag() prints instead),
+ * and can't be used with an external Kokkos tool loaded with KOKKOS_TOOLS_LIBS.
+ */
+namespace Timeline {
+
+/**
+ * Read options and register callbacks, if enabled.  Call once Kokkos (and MPI) are initialized
+ */
+void Initialize(ParameterInput *pin);
+
+/**
+ * Set the current step, which decides whether events are recorded
+ */
+void SetStep(int step);
+
+/**
+ * Send all recorded events to rank 0 and write the trace file.
+ * Collective, must be called on all ranks before Kokkos is finalized
+ */
+void Write();
+
+}
@@ -0,0 +1,122 @@
+/*
+ *  File: transients.cpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transients.hpp"
+
+#include "kharma.hpp"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace {
+
+struct Declared {
+    std::string name;
+    Metadata m;
+    Transients::Phase first, last;
+};
+
+std::vector<Declared> declared;
+std::map<std::string, std::string> storage;
+
+bool Overlaps(const Declared& a, const Declared& b)
+{
+    return !(a.last < b.first || b.last < a.first);
+}
+
+} // namespace
+
+void Transients::AddField(std::shared_ptr<KHARMAPackage>& pkg, ParameterInput *pin, const std::string& name,
+                          const Metadata& m, Phase first, Phase last)
+{
+    if (last < first)
+        throw std::invalid_argument("Transient field "+name+" must be live over a forward range of phases!");
+    const bool alias = pin->GetOrAddBoolean("transients", "alias", true);
+    // Anything someone will look at or restart from keeps its own storage and name
+    if (!alias || FieldIsOutput(pin, name) || m.IsSet(Metadata::Restart)) {
+        pkg->AddField(name, m);
+        return;
+    }
+    // Like pkg->AddField, repeats are ignored
+    for (const auto &field : declared)
+        if (field.name == name) return;
+    declared.push_back(Declared{name, m, first, last});
+}
+
+std::shared_ptr<KHARMAPackage> Transients::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
+{
+    auto pkg = std::make_shared<KHARMAPackage>("Transients");
+
+    // Greedy interval coloring: place each field in the first slot with matching Metadata,
+    // where it overlaps none of the current occupants
+    std::vector<std::vector<const Declared*>> slots;
+    for (const auto &field : declared) {
+        int slot = -1;
+        for (int s = 0; s < slots.size() && slot < 0; ++s) {
+            if (!(slots[s][0]->m == field.m)) continue;
+            bool free = true;
+            for (const auto *other : slots[s]) free = free && !Overlaps(*other, field);
+            if (free) slot = s;
+        }
+        if (slot < 0) {
+            slot = slots.size();
+            slots.emplace_back();
+        }
+        slots[slot].push_back(&field);
+    }
+
+    const bool print = MPIRank0() && packages->Get("Globals")->Param<int>("verbose") > 0;
+    for (int s = 0; s < slots.size(); ++s) {
+        const std::string slot_name = "Transients.slot" + std::to_string(s);
+        pkg->AddField(slot_name, slots[s][0]->m);
+        if (print) std::cout << slot_name << " holds:";
+        for (const auto *field : slots[s]) {
+            storage[field->name] = slot_name;
+            if (print) std::cout << " " << field->name;
+        }
+        if (print) std::cout << std::endl;
+    }
+    if (print && declared.size() > slots.size())
+        std::cout << "Aliased " << declared.size() << " transient fields into " << slots.size() << std::endl;
+    declared.clear();
+
+    return pkg;
+}
+
+std::string Transients::Name(const std::string& name)
+{
+    const auto found = storage.find(name);
+    return (found != storage.end()) ? found->second : name;
+}
@@ -0,0 +1,75 @@
+/*
+ *  File: transients.hpp
+ *
+ *  BSD 3-Clause License
+ *
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * Transient fields: grid-sized temporaries which only hold meaningful data during part of a step.
+ *
+ * Packages declare these with Transients::AddField in place of pkg->AddField, giving the range of
+ * step phases over which the contents must survive.  Once all packages are loaded, the "Transients"
+ * package assigns fields with identical Metadata and non-overlapping live ranges to a shared field
+ * ("Transients.slot0", etc.), so only one allocation exists for all of them.  Code using a transient
+ * must look it up with Transients::Name(), which returns the field actually holding it.
+ *
+ * Transients requested in any output, or marked for restarts, always get their own field under their
+ * usual name, as do all transients if transients/alias=false.
+ */
+namespace Transients {
+
+/**
+ * Parts of a step, in order.  A live range includes both ends.
+ */
+enum class Phase : int {startup=0, flux, sources, update, floors, heating, post_step, output};
+
+/**
+ * Declare a transient field 'name' belonging to 'pkg', which must hold its contents from phase
+ * 'first' through 'last' of each step.
+ */
+void AddField(std::shared_ptr<KHARMAPackage>& pkg, ParameterInput *pin, const std::string& name,
+              const Metadata& m, Phase first, Phase last);
+
+/**
+ * Assign declared transients to shared fields, and register those.  Load after all other packages
+ */
+std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
+
+/**
+ * Name of the field holding transient 'name' (or just 'name', for any other field)
+ */
+std::string Name(const std::string& name);
+
+}
@@ -247,7 +247,7 @@ inline void OutputNow(Mesh *pmesh, std::string name)
 extern int kharma_debug_trace_indent;
 extern int kharma_debug_trace_mutex;
 #define MAX_INDENT_SPACES 80
-inline void Flag(std::string label)
+inline void Flag(const std::string& label)
 {
     if(MPIRank0()) {
         int& indent = kharma_debug_trace_indent;
@@ -283,7 +283,7 @@ inline void EndFlag()
     }
 }
 #else
-inline void Flag(std::string label)
+inline void Flag(const std::string& label)
 {
     Kokkos::Profiling::pushRegion(label);
 }
@@ -16,6 +16,10 @@
 #        actually *runtime* parameters e.g. verbose, flag_verbose, etc
 # trace: Configure with execution tracing: print at the beginning and end
 #        of most host-side function calls during a step
+# papi:  Link PAPI, to add measured FP operation counts to the per-kernel
+#        roofline table printed with debug/roofline=true
+# fastmath: Use approximate pow/exp/log/rsqrt in the hottest kernels,
+#        see kharma/fast_math.hpp for error bounds
 # hdf5:  Download & compile HDF5, rather than looking for a system version
 # cleanhdf5:  Reconfigure HDF5 from scratch, rather than just recompiling
 # nompi:      Disable MPI and don't search/link it
@@ -63,6 +67,12 @@ fi
 if [[ "$ARGS" == *"trace"* ]]; then
   EXTRA_FLAGS="-DKHARMA_TRACE=1 $EXTRA_FLAGS"
 fi
+if [[ "$ARGS" == *"papi"* ]]; then
+  EXTRA_FLAGS="-DKHARMA_PAPI=1 $EXTRA_FLAGS"
+fi
+if [[ "$ARGS" == *"fastmath"* ]]; then
+  EXTRA_FLAGS="-DKHARMA_FAST_MATH=1 $EXTRA_FLAGS"
+fi
 if [[ "$ARGS" == *"nompi"* ]]; then
   EXTRA_FLAGS="-DKHARMA_DISABLE_MPI=1 $EXTRA_FLAGS"
 fi
@@ -33,6 +33,7 @@ conv_2d() {
 ALL_RES="16,24,32,48,64"
 conv_2d base " " "in 2D, baseline"
 conv_2d kastaun "inverter/type=kastaun" "in 2D, Kastaun inverter"
+conv_2d tiered "inverter/type=tiered" "in 2D, tiered 1Dw/Kastaun inverter"
 
 conv_2d dirichlet "boundaries/inner_x1=dirichlet boundaries/outer_x1=dirichlet" "in 2D, Dirichlet boundaries"
 
@@ -61,6 +62,22 @@ conv_2d b_face_ct "b_field/type=monopole_cube b_field/B10=1 b_field/solver=face_
 ALL_RES="24,32,48,64" # TODO idk why this doesn't work at 16^2
 conv_2d b_face_ct_dirichlet "boundaries/inner_x1=dirichlet boundaries/outer_x1=dirichlet b_field/type=monopole_cube b_field/B10=1 b_field/solver=face_ct" "in 2D, monopole B, face-centered+Dirichlet"
 
+# Approximate transcendental functions, see kharma/fast_math.hpp.  Convergence should be unchanged.
+# CI builds this alongside the usual binary, see scripts/ci.  To run locally, build with
+# "./make.sh clean fastmath" and rename kharma.host (or .cuda, etc) to kharma.fastmath
+if [ -f $BASE/kharma.fastmath ]; then
+    export EXE_NAME=kharma.fastmath
+    ALL_RES="16,24,32,48,64"
+    conv_2d fastmath " " "in 2D, fast math"
+    conv_2d fastmath_kastaun "inverter/type=kastaun" "in 2D, fast math, Kastaun inverter"
+    conv_2d fastmath_onedw "inverter/type=onedw" "in 2D, fast math, 1Dw inverter"
+    conv_2d fastmath_imex_im "driver/type=imex GRMHD/implicit=true" "in 2D, fast math, semi-implicit stepping"
+    unset EXE_NAME
+else
+    echo "Bondi fast math tests FAIL: no kharma.fastmath binary"
+    exit_code=1
+fi
+
 # TODO 3D?
 
 exit $exit_code
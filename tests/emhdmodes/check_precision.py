@@ -0,0 +1,26 @@
+#!/usr/bin/env python
+
+# Compare EMHD modes runs solved in double & mixed precision, at each resolution
+
+import sys
+import numpy as np
+
+import pyharm
+
+RES = [int(r) for r in sys.argv[1].split(",")]
+DOUBLE = sys.argv[2]
+MIXED = sys.argv[3]
+
+fail = 0
+for res in RES:
+    double = pyharm.load_dump("emhd_2d_{}_end_{}.phdf".format(res, DOUBLE))
+    mixed = pyharm.load_dump("emhd_2d_{}_end_{}.phdf".format(res, MIXED))
+    # Measure against the size of the perturbation, not the background
+    amp = float(double.params['amp'])
+    diff = np.max(np.abs(double['prims'] - mixed['prims'])) / amp
+    # Iterative refinement should recover the double-precision step to well under the mode's own error
+    print("Res {}: max difference mixed vs double precision {:.3g} of the mode amplitude".format(res, diff))
+    if diff > 1e-4:
+        fail = 1
+
+exit(fail)
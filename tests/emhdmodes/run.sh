@@ -33,6 +33,16 @@ conv_2d() {
 # WENO hits roundoff at higher res...
 ALL_RES="32,64,128"
 conv_2d emhd2d_weno flux/reconstruction=weno5 "EMHD mode in 2D, WENO5"
+# Solving in mixed precision should converge as well, and stay within solver tolerance of the above
+conv_2d emhd2d_mixed "flux/reconstruction=weno5 implicit/mixed_precision=true" "EMHD mode in 2D, mixed-precision solve"
+check_code=0
+python3 check_precision.py $ALL_RES emhd2d_weno emhd2d_mixed || check_code=$?
+if [[ $check_code != 0 ]]; then
+    echo Mixed-precision solve vs double FAIL: $check_code
+    exit_code=1
+else
+    echo Mixed-precision solve vs double success
+fi
 
 # ...but linear doesn't capture wave until higher res. Troubling.
 ALL_RES="64,128,256"
@@ -0,0 +1,25 @@
+#!/usr/bin/env python
+
+# Check that two dumps are bitwise identical
+
+import sys
+import numpy as np
+
+import pyharm
+
+reference = pyharm.load_dump(sys.argv[1])
+test = pyharm.load_dump(sys.argv[2])
+
+fail = 0
+for var in ('RHO', 'UU', 'U1', 'U2', 'U3', 'B1', 'B2', 'B3'):
+    try:
+        x, y = reference[var], test[var]
+    except (IOError, KeyError):
+        continue
+    if np.array_equal(x, y):
+        print("{}: identical".format(var))
+    else:
+        print("{}: DIFFERS by {:.3g}".format(var, np.max(np.abs(x - y))))
+        fail = 1
+
+exit(fail)
@@ -0,0 +1,49 @@
+#!/bin/bash
+set -euo pipefail
+
+# Bash script testing halo/exchange=persistent, with & without halo/shared_memory: these only change
+# how ghost zones are sent, so every run should be bitwise identical to the same run with Parthenon's exchange.
+# Runs on two MPI ranks so that messages go both between ranks and between blocks on one rank.
+
+BASE=../..
+NPROCS=${MPI_NUM_PROCS:-2}
+
+exit_code=0
+
+run_exchange() {
+    $BASE/run.sh -n $NPROCS -i $3 parthenon/job/archive_parameters=false \
+                    parthenon/output0/single_precision_output=false \
+                    $4 $5 >log_${1}_${2}.txt 2>&1
+    mv $(ls -t *.out0.final.phdf | head -n 1) halo_${1}_${2}.phdf
+}
+
+compare() {
+    run_exchange $1 parthenon $2 "halo/exchange=parthenon" "$3"
+    run_exchange $1 persistent $2 "halo/exchange=persistent" "$3"
+    run_exchange $1 shared $2 "halo/exchange=persistent halo/shared_memory=true" "$3"
+    check_code=0
+    python3 check.py halo_${1}_parthenon.phdf halo_${1}_persistent.phdf || check_code=$?
+    python3 check.py halo_${1}_parthenon.phdf halo_${1}_shared.phdf || check_code=$?
+    if [[ $check_code != 0 ]]; then
+        echo Halo exchange test $1 FAIL: $check_code
+        exit_code=1
+    else
+        echo Halo exchange test $1 success
+    fi
+}
+
+# Periodic 3D modes, with 8^3 blocks so every block has all 26 neighbors
+MODES="parthenon/time/nlim=20 parthenon/output0/dt=100. \
+       parthenon/mesh/nx1=32 parthenon/mesh/nx2=32 parthenon/mesh/nx3=32 \
+       parthenon/meshblock/nx1=8 parthenon/meshblock/nx2=8 parthenon/meshblock/nx3=8"
+compare modes_simple $BASE/pars/tests/mhdmodes.par "$MODES driver/type=simple"
+compare modes_kharma $BASE/pars/tests/mhdmodes.par "$MODES driver/type=kharma"
+compare modes_imex $BASE/pars/tests/mhdmodes.par "$MODES driver/type=imex"
+# Face-centered fields fall back to Parthenon's exchange, the rest don't
+compare modes_face_ct $BASE/pars/tests/mhdmodes.par "$MODES driver/type=kharma b_field/solver=face_ct"
+
+# Physical boundaries in both directions
+compare bondi $BASE/pars/bondi/bondi.par "parthenon/time/nlim=20 \
+        parthenon/mesh/nx1=64 parthenon/mesh/nx2=32 parthenon/meshblock/nx1=16 parthenon/meshblock/nx2=8"
+
+exit $exit_code
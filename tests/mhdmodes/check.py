@@ -139,7 +139,15 @@ for k in range(NVAR):
         # entropy wave is spatial & converges fast with spatial order
         # Most runs all variables are between 1.95-2.05
         # But w/Face-CT and upwinding, u2/u3 converge at 2.3, rho/u at 2.15
-        if VARS[k] == 'u2' or VARS[k] == 'u3':
+        if "_fo" in SHORT:
+            # Fourth-order fluxes: the boosted entropy wave should converge at 4th order,
+            # anything involving B at least at the order of the field transport
+            if "entropy" in SHORT:
+                if powerfits[k] > -3.7 or powerfits[k] < -5.0:
+                    fail = 1
+            elif powerfits[k] > -1.94:
+                fail = 1
+        elif VARS[k] == 'u2' or VARS[k] == 'u3':
             if powerfits[k] > -1.94 or ("entropy" not in SHORT and powerfits[k] < -2.3):
                 fail = 1
         else:
@@ -80,6 +80,11 @@ ALL_RES="16,24,32,48,64"
 conv_2d slow mhdmodes/nmode=1 "slow mode in 2D"
 conv_2d alfven mhdmodes/nmode=2 "Alfven mode in 2D"
 conv_2d fast mhdmodes/nmode=3 "fast mode in 2D"
+# Hybrid WENO should pick the linear weights everywhere in smooth modes, converging as above.
+# Note the parameter file sets flux/reconstruction, so driver/reconstruction would only change the default
+conv_2d slow_weno_hyb   "mhdmodes/nmode=1 flux/reconstruction=weno5_hybrid" "slow mode in 2D, hybrid WENO reconstruction"
+conv_2d alfven_weno_hyb "mhdmodes/nmode=2 flux/reconstruction=weno5_hybrid" "Alfven mode in 2D, hybrid WENO reconstruction"
+conv_2d fast_weno_hyb   "mhdmodes/nmode=3 flux/reconstruction=weno5_hybrid" "fast mode in 2D, hybrid WENO reconstruction"
 
 # Entropy mode as reconstruction demo
 conv_2d entropy_nob "mhdmodes/nmode=0 b_field/solver=none" "entropy mode in 2D, no B field"
@@ -89,10 +94,21 @@ conv_2d entropy_nob "mhdmodes/nmode=0 b_field/solver=none" "entropy mode in 2D,
 conv_2d entropy_mc "mhdmodes/nmode=0 driver/reconstruction=linear_mc" "entropy mode in 2D, linear/MC reconstruction"
 conv_2d entropy_weno "mhdmodes/nmode=0 driver/reconstruction=weno5" "entropy mode in 2D, WENO reconstruction"
 conv_2d entropy_weno_lin "mhdmodes/nmode=0 driver/reconstruction=weno5_linear" "entropy mode in 2D, WENO linearized reconstruction"
+conv_2d entropy_weno_hyb "mhdmodes/nmode=0 flux/reconstruction=weno5_hybrid" "entropy mode in 2D, hybrid WENO reconstruction"
 conv_2d entropy_ppm "mhdmodes/nmode=0 driver/reconstruction=ppm" "entropy mode in 2D, PPM reconstruction"
 conv_2d entropy_ppmx "mhdmodes/nmode=0 driver/reconstruction=ppm" "entropy mode in 2D, PPMX reconstruction"
 conv_2d entropy_mp5 "mhdmodes/nmode=0 driver/reconstruction=mp5" "entropy mode in 2D, MP5 reconstruction"
 
+# Fourth-order finite-volume fluxes. Hydrodynamics should converge at fourth order,
+# the B field transport is still second order
+OPTS="flux/fourth_order=true parthenon/time/integrator=rk4 flux/reconstruction=weno5_linear"
+# Entropy wave boosted to v1 = v2 = 0.5, which crosses the box back to its initial state at t=2
+BOOST="mhdmodes/nmode=0 b_field/solver=none mhdmodes/u10=0.7071067811865476 mhdmodes/u20=0.7071067811865476 parthenon/time/tlim=2.0"
+conv_2d entropy_boost_fo "$BOOST $OPTS" "boosted entropy mode in 2D, fourth-order"
+# Same, with 8x8 blocks, so most corrections cross a block boundary
+conv_2d entropy_boost_blocks_fo "$BOOST $OPTS parthenon/meshblock/nx1=8 parthenon/meshblock/nx2=8" "boosted entropy mode in 2D, fourth-order, small blocks"
+conv_2d fast_fo "mhdmodes/nmode=3 $OPTS" "fast mode in 2D, fourth-order"
+
 # KHARMA driver
 conv_2d slow_kharma   "mhdmodes/nmode=1 driver/type=kharma" "slow mode in 2D, KHARMA driver"
 conv_2d alfven_kharma "mhdmodes/nmode=2 driver/type=kharma" "Alfven mode in 2D, KHARMA driver"
@@ -147,4 +163,21 @@ conv_3d slow "mhdmodes/nmode=1 mhdmodes/dir=3" "slow mode in 3D"
 conv_3d alfven "mhdmodes/nmode=2 mhdmodes/dir=3" "Alfven mode in 3D"
 conv_3d fast "mhdmodes/nmode=3 mhdmodes/dir=3" "fast mode in 3D"
 
+# Approximate transcendental functions, see kharma/fast_math.hpp.  Convergence should be unchanged.
+# CI builds this alongside the usual binary, see scripts/ci.  To run locally, build with
+# "./make.sh clean fastmath" and rename kharma.host (or .cuda, etc) to kharma.fastmath
+if [ -f $BASE/kharma.fastmath ]; then
+    export EXE_NAME=kharma.fastmath
+    ALL_RES="16,24,32,48,64"
+    conv_2d slow_fm   "mhdmodes/nmode=1" "slow mode in 2D, fast math"
+    conv_2d alfven_fm "mhdmodes/nmode=2" "Alfven mode in 2D, fast math"
+    conv_2d fast_fm   "mhdmodes/nmode=3" "fast mode in 2D, fast math"
+    conv_2d fast_fm_kastaun "mhdmodes/nmode=3 inverter/type=kastaun" "fast mode in 2D, fast math, Kastaun inversion"
+    conv_2d fast_fm_onedw   "mhdmodes/nmode=3 inverter/type=onedw" "fast mode in 2D, fast math, 1Dw inversion"
+    unset EXE_NAME
+else
+    echo "MHD modes fast math tests FAIL: no kharma.fastmath binary"
+    exit_code=1
+fi
+
 exit $exit_code
@@ -0,0 +1,58 @@
+#!/usr/bin/env python
+
+# Compare a region-restricted dump to the full dump of the same step
+
+import sys
+import numpy as np
+import h5py
+
+import pyharm
+
+full_fname = sys.argv[1]
+part_fname = sys.argv[2]
+
+fail = 0
+full = h5py.File(full_fname, "r")
+part = h5py.File(part_fname, "r")
+
+if part['Info'].attrs['Time'] != full['Info'].attrs['Time']:
+    print("Region dump is at t={}, full dump at t={}".format(part['Info'].attrs['Time'], full['Info'].attrs['Time']))
+    sys.exit(1)
+
+nb_part = part['Info'].attrs['NumMeshBlocks']
+nb_full = full['Info'].attrs['NumMeshBlocks']
+if nb_part < 1 or nb_part >= nb_full:
+    print("Region dump has {} of {} blocks, should be a proper subset".format(nb_part, nb_full))
+    fail = 1
+
+# Match blocks by the position of their first zone center
+def corners(f):
+    return [tuple(f['VolumeLocations'][d][b, 0] for d in ('x', 'y', 'z')) for b in range(f['Info'].attrs['NumMeshBlocks'])]
+full_corners = corners(full)
+for b, corner in enumerate(corners(part)):
+    if corner not in full_corners:
+        print("Region block {} at {} is not in the full dump".format(b, corner))
+        fail = 1
+        continue
+    bf = full_corners.index(corner)
+    for var in part['Info'].attrs['OutputDatasetNames']:
+        var = var.decode() if isinstance(var, bytes) else var
+        if not np.array_equal(part[var][b], full[var][bf]):
+            print("Variable {} differs in block {}".format(var, b))
+            fail = 1
+
+# Existing readers should load the partial mesh, with the full geometry
+dump = pyharm.load_dump(part_fname)
+rho = dump['RHO']
+if rho.size != nb_part * np.prod(part['Info'].attrs['MeshBlockSize']) or not np.all(np.isfinite(rho)):
+    print("pyharm read {} zones of RHO, expected {}".format(rho.size, nb_part * np.prod(part['Info'].attrs['MeshBlockSize'])))
+    fail = 1
+if not np.all(dump['r'] > 0):
+    print("pyharm could not compute the geometry of the region dump")
+    fail = 1
+
+if fail:
+    print("Region output test failed")
+else:
+    print("Region output matches full dump in {} of {} blocks".format(nb_part, nb_full))
+exit(fail)
@@ -0,0 +1,39 @@
+#!/bin/bash
+set -euo pipefail
+
+# Bash script testing region-restricted dumps against the full dump of the same step:
+# every block in the region file must match its counterpart, and pyharm must read the file
+
+# Set paths
+KHARMADIR=../..
+
+exit_code=0
+
+test_region() {
+    $KHARMADIR/run.sh -i $KHARMADIR/pars/tori_3d/sane.par parthenon/time/nlim=5 \
+                         parthenon/job/archive_parameters=false \
+                         parthenon/mesh/nx1=64 parthenon/mesh/nx2=32 parthenon/mesh/nx3=32 \
+                         parthenon/meshblock/nx1=32 parthenon/meshblock/nx2=16 parthenon/meshblock/nx3=16 \
+                         parthenon/output0/single_precision_output=false \
+                         region_output0/dt=1e-6 region_output0/single_precision_output=false \
+                         $2 >log_region_${1}.txt 2>&1
+
+    mv torus.out0.final.phdf region_${1}_full.phdf
+    # Written after every step: the last file is the final state
+    mv $(ls torus.region0.*.phdf | tail -n 1) region_${1}_part.phdf
+    rm -f torus.region0.*.phdf
+
+    check_code=0
+    python3 check.py region_${1}_full.phdf region_${1}_part.phdf || check_code=$?
+    if [[ $check_code != 0 ]]; then
+        echo Region output test \"$3\" FAIL: $check_code
+        exit_code=1
+    else
+        echo Region output test \"$3\" success
+    fi
+}
+
+test_region spherical "region_output0/region=spherical region_output0/r_max=5" "spherical region"
+test_region native "region_output0/region=native region_output0/X2min=0.6 region_output0/X3max=3.0" "native region"
+
+exit $exit_code
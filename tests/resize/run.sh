@@ -34,6 +34,39 @@ test_resize () {
 
     # Check divB on the re-meshed output.  Tolerate some divB as we set the tolerance loosely above for speed
     pyharm check-basics --allowed_divb=1e-8 resize_restart.out0.final.phdf
+
+    # Run a few steps after resizing with cleanups triggered by measured divB, checked every 2 steps.
+    # always_solve makes sure anything skipped was skipped by the trigger, not the solver tolerance
+    test_trigger $1 "$2" skip "b_cleanup/trigger_divb=1e10"
+    test_trigger $1 "$2" max "b_cleanup/trigger_divb=0"
+    test_trigger $1 "$2" rms "b_cleanup/trigger_divb=1e10 b_cleanup/trigger_divb_rms=1e-30"
+
+    # Unreachable triggers must skip every cleanup, and reachable ones must run them
+    LOG_SKIP=log_resize_${1}_trigger_skip.txt
+    if [[ $(grep -c "Below trigger, skipping B field cleanup" $LOG_SKIP) -lt 1 ]] || \
+       grep -q "Triggering B field cleanup\|Cleaning divB toward" $LOG_SKIP; then
+        echo "Triggered cleanup did not skip on $1 fields!"
+        exit 1
+    fi
+    for trig in max rms; do
+        LOG_TRIG=log_resize_${1}_trigger_${trig}.txt
+        if [[ $(grep -c "Triggering B field cleanup" $LOG_TRIG) -lt 1 ]] || \
+           [[ $(grep -c "Cleaning divB toward" $LOG_TRIG) -lt 1 ]] || \
+           grep -q "Below trigger, skipping B field cleanup" $LOG_TRIG; then
+            echo "Cleanup was not triggered by $trig divB on $1 fields!"
+            exit 1
+        fi
+    done
+}
+
+test_trigger () {
+    $KHARMADIR/run.sh -i $KHARMADIR/pars/restarts/resize_restart.par $2 resize_restart/fname=torus.out0.final.h5 \
+                         parthenon/job/archive_parameters=false \
+                         coordinates/r_out=100 \
+                         parthenon/mesh/nx1=100 parthenon/mesh/nx2=50 parthenon/mesh/nx3=50 \
+                         parthenon/meshblock/nx1=100 parthenon/meshblock/nx2=25 parthenon/meshblock/nx3=25 \
+                         b_cleanup/abs_tolerance=1e-7 b_cleanup/always_solve=1 parthenon/time/nlim=6 \
+                         b_cleanup/trigger=divb b_cleanup/cleanup_interval=2 $4 >log_resize_${1}_trigger_${3}.txt 2>&1
 }
 
 test_resize cell ""
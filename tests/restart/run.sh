@@ -70,6 +70,36 @@ test_restart_smr() {
         echo Restart test \"$3\" success
     fi
 }
+# Re-cutting the mesh into different blocks partway through a run should change nothing
+test_reblock() {
+    $KHARMADIR/run.sh -i $KHARMADIR/pars/tori_3d/sane.par parthenon/time/nlim=5 driver/two_sync=true \
+                         parthenon/job/archive_parameters=false \
+                         parthenon/mesh/nx1=128 parthenon/mesh/nx2=64 parthenon/mesh/nx3=64 \
+                         parthenon/meshblock/nx1=128 parthenon/meshblock/nx2=32 parthenon/meshblock/nx3=64 \
+                         parthenon/output0/single_precision_output=false \
+                         $2 >log_reblock_${1}_first.txt 2>&1
+
+    mv torus.out0.final.phdf reblock_${1}_first.phdf
+
+    $KHARMADIR/run.sh -i $KHARMADIR/pars/tori_3d/sane.par parthenon/time/nlim=5 driver/two_sync=true \
+                         parthenon/job/archive_parameters=false \
+                         parthenon/mesh/nx1=128 parthenon/mesh/nx2=64 parthenon/mesh/nx3=64 \
+                         parthenon/meshblock/nx1=128 parthenon/meshblock/nx2=32 parthenon/meshblock/nx3=64 \
+                         parthenon/output0/single_precision_output=false \
+                         reblock/at_step=3 reblock/nx1=64 reblock/nx2=64 reblock/nx3=32 \
+                         $2 >log_reblock_${1}_second.txt 2>&1
+
+    mv torus.out0.final.phdf reblock_${1}_second.phdf
+
+    check_code=0
+    pyharm diff --rel_tol 1e-9 reblock_${1}_first.phdf reblock_${1}_second.phdf --no_plot || check_code=$?
+    if [[ $check_code != 0 ]]; then
+        echo Reblock test \"$3\" FAIL: $check_code
+        exit_code=1
+    else
+        echo Reblock test \"$3\" success
+    fi
+}
 
 test_restart kharma "driver/type=kharma b_field/solver=flux_ct" "KHARMA driver"
 test_restart imex "driver/type=imex b_field/solver=flux_ct" "ImEx driver"
@@ -80,6 +110,7 @@ TWO_D="parthenon/mesh/nx3=1 parthenon/meshblock/nx3=1"
 REFLECTING="boundaries/inner_x2=reflecting boundaries/outer_x2=reflecting boundaries/excise_polar_flux=false"
 test_restart kharma_face_2d "driver/type=kharma b_field/solver=face_ct $TWO_D $REFLECTING" "KHARMA driver, face CT, 2D"
 test_restart imex_face_2d   "driver/type=imex b_field/solver=face_ct $TWO_D $REFLECTING" "ImEx driver, face CT, 2D"
+test_reblock kharma_face "driver/type=kharma b_field/solver=face_ct" "KHARMA driver, face CT"
 # SMR
 test_restart_smr kharma_face_smr "driver/type=kharma b_field/solver=face_ct" "KHARMA driver, face CT, SMR"
 test_restart_smr imex_face_smr "driver/type=imex b_field/solver=face_ct" "ImEx driver, face CT, SMR"
@@ -0,0 +1,28 @@
+#!/usr/bin/env python
+
+# Check the spectrum of rho = 1 + A cos(k.x): all power in shells 0 and |k|
+
+import sys
+import numpy as np
+
+fname = sys.argv[1]
+shell = int(sys.argv[2])
+amp = 0.1
+
+# Last line: time, quantity, then power in each shell
+line = [l for l in open(fname) if not l.startswith("#")][-1].split()
+power = np.array([float(p) for p in line[2:]])
+print("Spectrum of {} at t={}: {}".format(line[1], line[0], power))
+
+expected = np.zeros_like(power)
+# The mean squared, and half the squared amplitude of the mode.
+# Their sum is mean(rho^2), as the spectrum should be normalized
+expected[0] = 1.
+expected[shell] = amp**2 / 2
+
+# One step of LLF damps the mode very slightly, and nonlinearity leaks a little power to 2k
+fail = 0
+if not np.allclose(power, expected, rtol=1e-3, atol=1e-3 * amp**2 / 2):
+    print("Expected {}".format(expected))
+    fail = 1
+exit(fail)
@@ -0,0 +1,36 @@
+#!/bin/bash
+set -euo pipefail
+
+# Bash script testing the normalization & shell binning of in-situ power spectra,
+# using a static entropy mode of known amplitude and wavevector
+
+# Set paths
+KHARMADIR=../..
+
+exit_code=0
+
+test_spectra() {
+    # Eight blocks, one step
+    $KHARMADIR/run.sh -i $KHARMADIR/pars/tests/mhdmodes.par mhdmodes/nmode=0 mhdmodes/amp=0.1 \
+                         b_field/solver=none parthenon/time/nlim=1 \
+                         parthenon/mesh/nx1=32 parthenon/mesh/nx2=32 parthenon/mesh/nx3=32 \
+                         parthenon/meshblock/nx1=16 parthenon/meshblock/nx2=16 parthenon/meshblock/nx3=16 \
+                         spectra/dt=1e-6 spectra/k_max=4 spectra/quantities=prims.rho \
+                         spectra/file=spectra_${1}.txt \
+                         $2 >log_spectra_${1}.txt 2>&1
+
+    check_code=0
+    python3 check.py spectra_${1}.txt $3 || check_code=$?
+    if [[ $check_code != 0 ]]; then
+        echo Spectra test \"$4\" FAIL: $check_code
+        exit_code=1
+    else
+        echo Spectra test \"$4\" success
+    fi
+}
+
+# k = (1,1,0) lands in shell round(sqrt(2)) = 1, k = (1,1,1) in shell round(sqrt(3)) = 2
+test_spectra plane "mhdmodes/dir=3" 1 "mode in X1/X2 plane"
+test_spectra diag "mhdmodes/dir=0" 2 "mode along the diagonal"
+
+exit $exit_code
@@ -0,0 +1,28 @@
+#!/usr/bin/env python
+
+# Check that the tiered inverter actually used its fallback & hard tiers, from the history file
+
+import sys
+import numpy as np
+
+fname = sys.argv[1]
+
+# Parthenon history header: "# [1]=time [2]=dt ..."
+columns = []
+for line in open(fname):
+    if line.startswith("#") and "[1]=" in line:
+        columns = [c.split("=")[1] for c in line[1:].split()]
+        break
+data = np.atleast_2d(np.loadtxt(fname))
+
+fail = 0
+for col in ("PFlagsFallbackTier", "PFlagsHardTier"):
+    if col not in columns:
+        print("No {} in history file!".format(col))
+        fail = 1
+        continue
+    total = np.sum(data[:, columns.index(col)])
+    print("{}: {} zones over the run".format(col, total))
+    if total <= 0:
+        fail = 1
+exit(fail)